@@ -0,0 +1,64 @@
+# GUI ve daemon hedeflerinin paylaştığı çekirdek: bağlantı, cihaz, register,
+# tag tablosu ve kayıt. Yalnızca QtCore/QtNetwork/QtSerialPort gerektirir.
+
+QT += network serialport
+
+SOURCES += \
+    $$PWD/src/core/ModbusDevice.cpp \
+    $$PWD/src/core/ModbusRegister.cpp \
+    $$PWD/src/core/ModbusConnection.cpp \
+    $$PWD/src/core/TagTable.cpp \
+    $$PWD/src/core/RegisterDecoder.cpp \
+    $$PWD/src/core/RegisterCodec.cpp \
+    $$PWD/src/core/ConfigImage.cpp \
+    $$PWD/src/core/TransactionStats.cpp \
+    $$PWD/src/core/SharedTagTable.cpp \
+    $$PWD/src/utils/Logger.cpp \
+    $$PWD/src/utils/LogRing.cpp \
+    $$PWD/src/utils/BinaryLog.cpp \
+    $$PWD/src/utils/DataRecorder.cpp \
+    $$PWD/src/utils/TimeSeriesStore.cpp \
+    $$PWD/src/utils/GorillaChunk.cpp \
+    $$PWD/src/utils/RollupStore.cpp \
+    $$PWD/src/utils/LatencyHistogram.cpp \
+    $$PWD/src/utils/Csv.cpp \
+    $$PWD/3rdparty/libmodbus/src/modbus.c \
+    $$PWD/3rdparty/libmodbus/src/modbus-data.c \
+    $$PWD/3rdparty/libmodbus/src/modbus-tcp.c
+
+HEADERS += \
+    $$PWD/src/core/ModbusDevice.h \
+    $$PWD/src/core/ModbusRegister.h \
+    $$PWD/src/core/ModbusConnection.h \
+    $$PWD/src/core/TagTable.h \
+    $$PWD/src/core/RegisterDecoder.h \
+    $$PWD/src/core/RegisterCodec.h \
+    $$PWD/src/core/ConfigImage.h \
+    $$PWD/src/core/TransactionStats.h \
+    $$PWD/src/core/SharedTagTable.h \
+    $$PWD/src/shm/qmodbus_shm.h \
+    $$PWD/src/utils/ModbusTypes.h \
+    $$PWD/src/utils/Logger.h \
+    $$PWD/src/utils/LogRing.h \
+    $$PWD/src/utils/BinaryLog.h \
+    $$PWD/src/utils/DataRecorder.h \
+    $$PWD/src/utils/TimeSeriesStore.h \
+    $$PWD/src/utils/GorillaChunk.h \
+    $$PWD/src/utils/RollupStore.h \
+    $$PWD/src/utils/LatencyHistogram.h \
+    $$PWD/src/utils/Csv.h \
+    $$PWD/3rdparty/libmodbus/src/modbus.h \
+    $$PWD/src/imodbus.h
+
+INCLUDEPATH += \
+    $$PWD/3rdparty/libmodbus \
+    $$PWD/3rdparty/libmodbus/src \
+    $$PWD/src \
+    $$PWD/src/core \
+    $$PWD/src/shm \
+    $$PWD/src/utils
+
+win32 {
+    DEFINES += WINVER=0x0501
+    LIBS += -lws2_32
+}
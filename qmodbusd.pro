@@ -0,0 +1,31 @@
+TARGET = qmodbusd
+TEMPLATE = app
+VERSION = 0.1.0
+
+# Pencere yığını olmadan çalışan polling servisi
+QT = core
+CONFIG += console
+CONFIG -= app_bundle
+
+# --debug sürüm derlemesinde de DEBUG kayıtlarını üretebilsin
+DEFINES += QMODBUS_LOG_MIN_LEVEL=0
+
+include(qmodbus_core.pri)
+
+SOURCES += \
+    src/daemon/main.cpp \
+    src/daemon/PollingDaemon.cpp \
+    src/daemon/MetricsExporter.cpp \
+    src/daemon/MqttClient.cpp \
+    src/daemon/SparkplugPublisher.cpp
+
+HEADERS += \
+    src/daemon/PollingDaemon.h \
+    src/daemon/MetricsExporter.h \
+    src/daemon/MqttClient.h \
+    src/daemon/SparkplugPublisher.h
+
+INCLUDEPATH += \
+    src/daemon
+
+include(deployment.pri)
@@ -0,0 +1,22 @@
+TARGET = qmodbuslog
+TEMPLATE = app
+VERSION = 0.1.0
+
+# Logger'ın ikili log dosyalarını metne çeviren/süzen komut satırı aracı
+QT = core
+CONFIG += console
+CONFIG -= app_bundle
+
+SOURCES += \
+    src/logdump/main.cpp \
+    src/utils/BinaryLog.cpp \
+    src/utils/LogRing.cpp
+
+HEADERS += \
+    src/utils/BinaryLog.h \
+    src/utils/LogRing.h
+
+INCLUDEPATH += \
+    src/utils
+
+include(deployment.pri)
@@ -0,0 +1,17 @@
+TARGET = qmodbusshm
+TEMPLATE = lib
+VERSION = 0.1.0
+
+# Paylaşımlı bellek tag tablosu için okuyucu kütüphanesi (Qt gerektirmez).
+# Başka süreçler qmodbus_shm.h ile bu kütüphaneye bağlanır.
+CONFIG -= qt
+CONFIG += staticlib
+
+SOURCES += \
+    src/shm/qmodbus_shm.c
+
+HEADERS += \
+    src/shm/qmodbus_shm.h
+
+INCLUDEPATH += \
+    src/shm
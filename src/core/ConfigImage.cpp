@@ -0,0 +1,363 @@
+#include "ConfigImage.h"
+#include <QSaveFile>
+#include <modbus.h>
+#include <cstring>
+
+static_assert(sizeof(ConfigImage::Header) == 64, "Header layout changed");
+static_assert(sizeof(ConfigImage::DeviceRecord) == 96, "DeviceRecord layout changed");
+static_assert(sizeof(ConfigImage::TagRecord) == 88, "TagRecord layout changed");
+static_assert(sizeof(ConfigImage::PlanRecord) == 16, "PlanRecord layout changed");
+
+namespace {
+
+const int SECTION_ALIGN = 8;
+
+qint64 alignUp(qint64 value)
+{
+    return (value + SECTION_ALIGN - 1) & ~qint64(SECTION_ALIGN - 1);
+}
+
+// Bölüm dosya sınırları içinde ve hizalı mı?
+bool sectionFits(quint64 offset, quint64 count, quint64 recordSize, qint64 fileSize)
+{
+    if (offset % SECTION_ALIGN != 0 || offset > static_cast<quint64>(fileSize)) {
+        return false;
+    }
+    return count <= (static_cast<quint64>(fileSize) - offset) / recordSize;
+}
+
+} // namespace
+
+ConfigImage::ConfigImage()
+    : data(nullptr)
+    , size(0)
+    , header(nullptr)
+    , devices(nullptr)
+    , tags(nullptr)
+    , plans(nullptr)
+    , strings(nullptr)
+{
+}
+
+ConfigImage::~ConfigImage()
+{
+    close();
+}
+
+bool ConfigImage::open(const QString& filename)
+{
+    close();
+
+    file.setFileName(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        lastError = "Failed to open configuration image";
+        return false;
+    }
+
+    size = file.size();
+    if (size < static_cast<qint64>(sizeof(Header))) {
+        lastError = "Configuration image is truncated";
+        file.close();
+        return false;
+    }
+
+    data = file.map(0, size);
+    if (!data) {
+        lastError = "Failed to map configuration image";
+        file.close();
+        return false;
+    }
+
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ConfigImage::close()
+{
+    if (data) {
+        file.unmap(const_cast<uchar*>(data));
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    devices = nullptr;
+    tags = nullptr;
+    plans = nullptr;
+    strings = nullptr;
+}
+
+bool ConfigImage::validate()
+{
+    const Header* h = reinterpret_cast<const Header*>(data);
+    if (h->magic != MAGIC) {
+        lastError = "Not a configuration image";
+        return false;
+    }
+    if (h->version != VERSION || h->headerSize != sizeof(Header)) {
+        lastError = QString("Unsupported configuration image version %1").arg(h->version);
+        return false;
+    }
+    if (!sectionFits(h->deviceOffset, h->deviceCount, sizeof(DeviceRecord), size) ||
+        !sectionFits(h->tagOffset, h->tagCount, sizeof(TagRecord), size) ||
+        !sectionFits(h->planOffset, h->planCount, sizeof(PlanRecord), size) ||
+        !sectionFits(h->stringOffset, h->stringPoolSize, 1, size)) {
+        lastError = "Configuration image sections are out of bounds";
+        return false;
+    }
+
+    const DeviceRecord* devs = reinterpret_cast<const DeviceRecord*>(data + h->deviceOffset);
+    const PlanRecord* planRecords = reinterpret_cast<const PlanRecord*>(data + h->planOffset);
+
+    // Cihaz ve plan aralıkları; tag kayıtlarının kendisi kullanılırken doğrulanır
+    for (quint32 i = 0; i < h->deviceCount; ++i) {
+        const DeviceRecord& dev = devs[i];
+        if (dev.firstTag > h->tagCount || dev.tagCount > h->tagCount - dev.firstTag ||
+            dev.firstPlan > h->planCount || dev.planCount > h->planCount - dev.firstPlan) {
+            lastError = QString("Device record %1 is out of bounds").arg(i);
+            return false;
+        }
+        for (quint32 p = 0; p < dev.planCount; ++p) {
+            const PlanRecord& plan = planRecords[dev.firstPlan + p];
+            if (plan.firstTag > dev.tagCount || plan.tagCount > dev.tagCount - plan.firstTag) {
+                lastError = QString("Read plan %1 of device %2 is out of bounds").arg(p).arg(i);
+                return false;
+            }
+            // Blok tek istekte okunur; protokol sınırını aşan plan kullanılamaz
+            const bool isBit = plan.regType == static_cast<quint8>(ModbusTypes::RegisterType::COIL) ||
+                               plan.regType == static_cast<quint8>(ModbusTypes::RegisterType::DISCRETE_INPUT);
+            const int maxCount = isBit ? MODBUS_MAX_READ_BITS : MODBUS_MAX_READ_REGISTERS;
+            if (plan.wordCount == 0 || plan.wordCount > maxCount) {
+                lastError = QString("Read plan %1 of device %2 has invalid size %3")
+                                .arg(p).arg(i).arg(plan.wordCount);
+                return false;
+            }
+        }
+    }
+
+    header = h;
+    devices = devs;
+    tags = reinterpret_cast<const TagRecord*>(data + h->tagOffset);
+    plans = planRecords;
+    strings = reinterpret_cast<const char*>(data + h->stringOffset);
+    return true;
+}
+
+bool ConfigImage::isImageFile(const QString& filename)
+{
+    QFile probe(filename);
+    quint32 magic = 0;
+    if (!probe.open(QIODevice::ReadOnly) ||
+        probe.read(reinterpret_cast<char*>(&magic), sizeof(magic)) != sizeof(magic)) {
+        return false;
+    }
+    return magic == MAGIC;
+}
+
+int ConfigImage::findDevice(const QString& name) const
+{
+    for (int i = 0; i < deviceCount(); ++i) {
+        if (string(devices[i].name) == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QString ConfigImage::string(const StringRef& ref) const
+{
+    if (!header || ref.offset > header->stringPoolSize ||
+        ref.length > header->stringPoolSize - ref.offset) {
+        return QString();
+    }
+    return QString::fromUtf8(strings + ref.offset, static_cast<int>(ref.length));
+}
+
+ModbusTypes::ConnectionParams ConfigImage::connectionParams(const DeviceRecord& dev) const
+{
+    ModbusTypes::ConnectionParams params;
+    params.name = string(dev.connectionName);
+    params.ip = string(dev.ip);
+    params.port = dev.port;
+    params.slaveId = dev.slaveId;
+    params.timeout = dev.timeout;
+    params.scanRate = dev.scanRate;
+    params.retryCount = dev.retryCount;
+    params.type = static_cast<ModbusTypes::ConnectionType>(dev.connectionType);
+    params.byteOrder = static_cast<ModbusTypes::ByteOrder>(dev.byteOrder);
+    params.readWriteEnabled = dev.readWriteEnabled != 0;
+    params.errorRecovery = static_cast<ModbusTypes::ErrorRecoveryMode>(dev.errorRecovery);
+    params.serialPort = string(dev.serialPort);
+    params.baudRate = dev.baudRate;
+    params.parity = static_cast<char>(dev.parity);
+    params.dataBits = dev.dataBits;
+    params.stopBits = dev.stopBits;
+    return params;
+}
+
+ModbusTypes::RegisterConfig ConfigImage::registerConfig(const TagRecord& tag) const
+{
+    ModbusTypes::RegisterConfig config;
+    config.address = tag.address;
+    config.name = string(tag.name);
+    config.description = string(tag.description);
+    config.dataType = static_cast<ModbusTypes::DataType>(tag.dataType);
+    config.regType = static_cast<ModbusTypes::RegisterType>(tag.regType);
+    config.scaleFactor = tag.scaleFactor;
+    config.unit = string(tag.unit);
+    config.minValue = tag.minValue;
+    config.maxValue = tag.maxValue;
+    config.isReadOnly = (tag.flags & TAG_READ_ONLY) != 0;
+    config.isAlarmEnabled = (tag.flags & TAG_ALARM_ENABLED) != 0;
+    config.alarmHighLimit = tag.alarmHighLimit;
+    config.alarmLowLimit = tag.alarmLowLimit;
+    config.byteOrder = static_cast<ModbusTypes::ByteOrder>(tag.byteOrder);
+    config.deadband = tag.deadband;
+    config.stringLength = tag.stringLength;
+    return config;
+}
+
+ConfigImage::Writer::Writer()
+    : nextPlanTag(0)
+{
+}
+
+ConfigImage::StringRef ConfigImage::Writer::addString(const QString& text)
+{
+    // Aynı dizgiler (birimler, açıklamalar) havuzda bir kez tutulur
+    auto it = stringIndex.constFind(text);
+    if (it != stringIndex.constEnd()) {
+        return *it;
+    }
+
+    const QByteArray utf8 = text.toUtf8();
+    StringRef ref;
+    ref.offset = static_cast<quint32>(stringPool.size());
+    ref.length = static_cast<quint32>(utf8.size());
+    stringPool.append(utf8);
+    stringIndex.insert(text, ref);
+    return ref;
+}
+
+void ConfigImage::Writer::addDevice(const QString& name, int pollingInterval, int watchdogInterval,
+                                    const ModbusTypes::ConnectionParams& params)
+{
+    DeviceRecord dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.name = addString(name);
+    dev.connectionName = addString(params.name);
+    dev.ip = addString(params.ip);
+    dev.serialPort = addString(params.serialPort);
+    dev.pollingInterval = pollingInterval;
+    dev.watchdogInterval = watchdogInterval;
+    dev.port = params.port;
+    dev.slaveId = params.slaveId;
+    dev.timeout = params.timeout;
+    dev.scanRate = params.scanRate;
+    dev.retryCount = params.retryCount;
+    dev.baudRate = params.baudRate;
+    dev.dataBits = params.dataBits;
+    dev.stopBits = params.stopBits;
+    dev.connectionType = static_cast<quint8>(params.type);
+    dev.byteOrder = static_cast<quint8>(params.byteOrder);
+    dev.readWriteEnabled = params.readWriteEnabled ? 1 : 0;
+    dev.errorRecovery = static_cast<quint8>(params.errorRecovery);
+    dev.parity = static_cast<quint8>(params.parity);
+    dev.firstTag = static_cast<quint32>(tags.size());
+    dev.firstPlan = static_cast<quint32>(plans.size());
+    devices.append(dev);
+    nextPlanTag = 0;
+}
+
+void ConfigImage::Writer::addTag(const ModbusTypes::RegisterConfig& config)
+{
+    if (devices.isEmpty()) {
+        return;
+    }
+
+    TagRecord tag;
+    memset(&tag, 0, sizeof(tag));
+    tag.name = addString(config.name);
+    tag.description = addString(config.description);
+    tag.unit = addString(config.unit);
+    tag.scaleFactor = config.scaleFactor;
+    tag.minValue = config.minValue;
+    tag.maxValue = config.maxValue;
+    tag.alarmHighLimit = config.alarmHighLimit;
+    tag.alarmLowLimit = config.alarmLowLimit;
+    tag.deadband = config.deadband;
+    tag.address = config.address;
+    tag.stringLength = static_cast<quint16>(ModbusTypes::registerWordCount(config));
+    tag.dataType = static_cast<quint8>(config.dataType);
+    tag.regType = static_cast<quint8>(config.regType);
+    tag.byteOrder = static_cast<quint8>(config.byteOrder);
+    tag.flags = (config.isReadOnly ? TAG_READ_ONLY : 0) |
+                (config.isAlarmEnabled ? TAG_ALARM_ENABLED : 0);
+    tags.append(tag);
+    ++devices.last().tagCount;
+}
+
+void ConfigImage::Writer::addPlan(ModbusTypes::RegisterType type, int startAddress,
+                                  int wordCount, int tagCount)
+{
+    if (devices.isEmpty()) {
+        return;
+    }
+
+    PlanRecord plan;
+    memset(&plan, 0, sizeof(plan));
+    plan.firstTag = nextPlanTag;
+    plan.tagCount = static_cast<quint32>(tagCount);
+    plan.startAddress = startAddress;
+    plan.wordCount = static_cast<quint16>(wordCount);
+    plan.regType = static_cast<quint8>(type);
+    plans.append(plan);
+    nextPlanTag += static_cast<quint32>(tagCount);
+    ++devices.last().planCount;
+}
+
+bool ConfigImage::Writer::save(const QString& filename)
+{
+    Header h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.headerSize = sizeof(Header);
+    h.deviceCount = static_cast<quint32>(devices.size());
+    h.tagCount = static_cast<quint32>(tags.size());
+    h.planCount = static_cast<quint32>(plans.size());
+    h.stringPoolSize = static_cast<quint32>(stringPool.size());
+    h.deviceOffset = alignUp(sizeof(Header));
+    h.tagOffset = alignUp(h.deviceOffset + devices.size() * sizeof(DeviceRecord));
+    h.planOffset = alignUp(h.tagOffset + tags.size() * sizeof(TagRecord));
+    h.stringOffset = alignUp(h.planOffset + plans.size() * sizeof(PlanRecord));
+
+    QByteArray image(static_cast<int>(h.stringOffset + stringPool.size()), '\0');
+    char* out = image.data();
+    memcpy(out, &h, sizeof(h));
+    if (!devices.isEmpty()) {
+        memcpy(out + h.deviceOffset, devices.constData(), devices.size() * sizeof(DeviceRecord));
+    }
+    if (!tags.isEmpty()) {
+        memcpy(out + h.tagOffset, tags.constData(), tags.size() * sizeof(TagRecord));
+    }
+    if (!plans.isEmpty()) {
+        memcpy(out + h.planOffset, plans.constData(), plans.size() * sizeof(PlanRecord));
+    }
+    if (!stringPool.isEmpty()) {
+        memcpy(out + h.stringOffset, stringPool.constData(), stringPool.size());
+    }
+
+    // Yarım yazılmış dosya hiçbir zaman eşlenmesin diye atomik yazılır
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly) || file.write(image) != image.size() || !file.commit()) {
+        lastError = "Failed to write configuration image";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,168 @@
+#ifndef CONFIG_IMAGE_H
+#define CONFIG_IMAGE_H
+
+#include "ModbusTypes.h"
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+
+// Sürümlü, belleğe eşlenebilir (mmap) ikili cihaz yapılandırması.
+// Dosya düzeni (host byte sırası, bölümler 8 bayt hizalı):
+//   Header | DeviceRecord[] | TagRecord[] | PlanRecord[] | string havuzu (UTF-8)
+// Kayıtlar eşlenen bellekten doğrudan okunur; açılışta ayrıştırma yapılmaz.
+// JSON, araçlar arası değişim biçimi olarak kalmaya devam eder.
+class ConfigImage {
+public:
+    static const quint32 MAGIC = 0x43424D51;   // "QMBC"
+    static const quint16 VERSION = 2;    // 2: TagRecord::stringLength
+
+    // String havuzundaki bir dizgi
+    struct StringRef {
+        quint32 offset;
+        quint32 length;
+    };
+
+    struct Header {
+        quint32 magic;
+        quint16 version;
+        quint16 headerSize;
+        quint32 deviceCount;
+        quint32 tagCount;
+        quint32 planCount;
+        quint32 stringPoolSize;
+        quint64 deviceOffset;
+        quint64 tagOffset;
+        quint64 planOffset;
+        quint64 stringOffset;
+        quint32 reserved[2];
+    };
+
+    struct DeviceRecord {
+        StringRef name;
+        StringRef connectionName;
+        StringRef ip;
+        StringRef serialPort;
+        qint32 pollingInterval;
+        qint32 watchdogInterval;
+        qint32 port;
+        qint32 slaveId;
+        qint32 timeout;
+        qint32 scanRate;
+        qint32 retryCount;
+        qint32 baudRate;
+        qint32 dataBits;
+        qint32 stopBits;
+        quint8 connectionType;
+        quint8 byteOrder;
+        quint8 readWriteEnabled;
+        quint8 errorRecovery;
+        quint8 parity;
+        quint8 reserved[3];
+        quint32 firstTag;       // Dosya genelindeki ilk tag
+        quint32 tagCount;
+        quint32 firstPlan;      // Dosya genelindeki ilk okuma bloğu
+        quint32 planCount;
+    };
+
+    enum TagFlag : quint8 {
+        TAG_READ_ONLY = 0x01,
+        TAG_ALARM_ENABLED = 0x02
+    };
+
+    struct TagRecord {
+        StringRef name;
+        StringRef description;
+        StringRef unit;
+        double scaleFactor;
+        double minValue;
+        double maxValue;
+        double alarmHighLimit;
+        double alarmLowLimit;
+        double deadband;
+        qint32 address;
+        quint8 dataType;
+        quint8 regType;
+        quint8 byteOrder;
+        quint8 flags;
+        quint16 stringLength;   // STRING/WSTRING word sayısı
+        quint8 reserved[6];
+    };
+
+    // Önceden hesaplanmış okuma bloğu; tag'leri cihazın tag aralığında
+    // firstTag'den başlayan ardışık kayıtlardır
+    struct PlanRecord {
+        quint32 firstTag;       // Cihazın ilk tag'ine göre
+        quint32 tagCount;
+        qint32 startAddress;
+        quint16 wordCount;
+        quint8 regType;
+        quint8 reserved;
+    };
+
+    ConfigImage();
+    ~ConfigImage();
+
+    bool open(const QString& filename);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    QString getLastError() const { return lastError; }
+
+    // Dosya bu biçimde mi? (yalnızca başlığa bakar)
+    static bool isImageFile(const QString& filename);
+
+    int deviceCount() const { return header ? static_cast<int>(header->deviceCount) : 0; }
+    const DeviceRecord& device(int index) const { return devices[index]; }
+    int findDevice(const QString& name) const;
+    const TagRecord* deviceTags(const DeviceRecord& dev) const { return tags + dev.firstTag; }
+    const PlanRecord* devicePlans(const DeviceRecord& dev) const { return plans + dev.firstPlan; }
+    QString string(const StringRef& ref) const;
+
+    ModbusTypes::ConnectionParams connectionParams(const DeviceRecord& dev) const;
+    ModbusTypes::RegisterConfig registerConfig(const TagRecord& tag) const;
+
+    // Dosya üretici. Cihazlar sırayla eklenir; addTag/addPlan son eklenen
+    // cihaza yazar. Plan blokları, cihazın tag'lerini eklendikleri sırayla tüketir.
+    class Writer {
+    public:
+        Writer();
+
+        void addDevice(const QString& name, int pollingInterval, int watchdogInterval,
+                       const ModbusTypes::ConnectionParams& params);
+        void addTag(const ModbusTypes::RegisterConfig& config);
+        void addPlan(ModbusTypes::RegisterType type, int startAddress, int wordCount, int tagCount);
+
+        bool save(const QString& filename);
+        QString getLastError() const { return lastError; }
+
+    private:
+        QVector<DeviceRecord> devices;
+        QVector<TagRecord> tags;
+        QVector<PlanRecord> plans;
+        QByteArray stringPool;
+        QHash<QString, StringRef> stringIndex;
+        quint32 nextPlanTag;
+        QString lastError;
+
+        StringRef addString(const QString& text);
+    };
+
+private:
+    QFile file;
+    const uchar* data;
+    qint64 size;
+    const Header* header;
+    const DeviceRecord* devices;
+    const TagRecord* tags;
+    const PlanRecord* plans;
+    const char* strings;
+    QString lastError;
+
+    bool validate();
+
+    ConfigImage(const ConfigImage&) = delete;
+    ConfigImage& operator=(const ConfigImage&) = delete;
+};
+
+#endif // CONFIG_IMAGE_H
@@ -1,9 +1,11 @@
 #include "ModbusConnection.h"
+#include "Logger.h"
 #include <QDebug>
 #include <QSerialPort>
 #include <QHostAddress>
 #include <QTimerEvent>
 #include <QElapsedTimer>
+#include <QMetaMethod>
 #include <errno.h>
 
 #ifdef Q_OS_WIN
@@ -14,6 +16,7 @@ ModbusConnection::ModbusConnection(QObject* parent)
     : QObject(parent)
     , ctx(nullptr)
     , m_isConnected(false)
+    , lastErrorCode(0)
     , queueTimer(new QTimer(this))
     , watchdogTimer(new QTimer(this))
     , queueProcessingInterval(10)
@@ -71,6 +74,7 @@ bool ModbusConnection::connectDevice(const ModbusTypes::ConnectionParams& params
     }
     
     m_isConnected = true;
+    transactionStats.setConnected(true);
     lastCommunicationTime = QDateTime::currentDateTime();
     
     queueTimer->start();
@@ -89,10 +93,12 @@ void ModbusConnection::disconnectDevice()
     
     QMutexLocker locker(&queueMutex);
     requestQueue.clear();
+    transactionStats.setQueueDepth(0);
     
     if (m_isConnected) {
         cleanupConnection();
         m_isConnected = false;
+        transactionStats.setConnected(false);
         emit deviceDisconnected();
         logDebug("Disconnected");
     }
@@ -100,6 +106,7 @@ void ModbusConnection::disconnectDevice()
 
 bool ModbusConnection::reconnect()
 {
+    transactionStats.recordReconnect();
     disconnectDevice();
     return connectDevice(params);
 }
@@ -342,19 +349,23 @@ void ModbusConnection::processQueue()
     }
     
     ModbusRequest request = requestQueue.dequeue();
+    transactionStats.setQueueDepth(requestQueue.size());
     locker.unlock();  // Mutex'i serbest bırak
     
-    double responseTime = 0.0;
+    const quint8 functionCode = TransactionStats::functionCodeFor(request.type, request.isWrite,
+                                                                  request.quantity);
+    transactionStats.record(functionCode, params.slaveId, TransactionStats::QUEUE_WAIT,
+                            static_cast<quint64>(request.queued.nsecsElapsed() / 1000));
     bool success = false;
     
     try {
         QElapsedTimer timer;
         timer.start();
         
+        lastErrorCode = 0;
         success = executeRequest(request);
-        responseTime = timer.elapsed();
         
-        updateStatistics(success, responseTime);
+        updateStatistics(success, functionCode, timer.nsecsElapsed() / 1000, lastErrorCode);
         emit requestCompleted(success);
     }
     catch (const std::exception& e) {
@@ -476,7 +487,8 @@ bool ModbusConnection::validateAddress(int addr, int quantity, ModbusTypes::Regi
 bool ModbusConnection::processResponse(int result, const ModbusRequest& request)
 {
     if (result == -1) {
-        lastError = formatModbusError(errno);
+        lastErrorCode = errno;
+        lastError = formatModbusError(lastErrorCode);
         emit communicationError(lastError);
         return false;
     }
@@ -485,7 +497,8 @@ bool ModbusConnection::processResponse(int result, const ModbusRequest& request)
     return true;
 }
 
-void ModbusConnection::updateStatistics(bool success, double responseTime)
+void ModbusConnection::updateStatistics(bool success, quint8 functionCode, qint64 wireMicros,
+                                        int errorCode)
 {
     totalRequests++;
     if (success) {
@@ -494,10 +507,10 @@ void ModbusConnection::updateStatistics(bool success, double responseTime)
         failedRequests++;
     }
     
-    responseTimes.append(responseTime);
-    if (responseTimes.size() > 1000) {  // Son 1000 yanıt süresini tut
-        responseTimes.removeFirst();
-    }
+    // Zaman aşımları da kaydedilir; kuyruk gecikmesinin kaynağı onlardır
+    transactionStats.recordResult(functionCode, params.slaveId, success, errorCode);
+    transactionStats.record(functionCode, params.slaveId, TransactionStats::WIRE,
+                            static_cast<quint64>(qMax<qint64>(0, wireMicros)));
     
     emit statisticsUpdated();
 }
@@ -507,7 +520,7 @@ void ModbusConnection::resetStatistics()
     totalRequests = 0;
     successfulRequests = 0;
     failedRequests = 0;
-    responseTimes.clear();
+    transactionStats.reset();
     emit statisticsUpdated();
 }
 
@@ -535,6 +548,8 @@ void ModbusConnection::enqueueRequest(const ModbusRequest& request)
 {
     QMutexLocker locker(&queueMutex);
     requestQueue.enqueue(request);
+    requestQueue.last().queued.start();
+    transactionStats.setQueueDepth(requestQueue.size());
 }
 
 QString ModbusConnection::formatModbusError(int errorCode) const
@@ -554,9 +569,22 @@ QString ModbusConnection::formatModbusError(int errorCode) const
     }
 }
 
-void ModbusConnection::logDebug(const QString& message) const
+void ModbusConnection::logDebug(const char* format, const LogArg& a1, const LogArg& a2) const
 {
-    qDebug() << "ModbusConnection:" << message;
+    static const QMetaMethod debugSignal = QMetaMethod::fromSignal(&ModbusConnection::debugMessage);
+
+    LOG_DEBUGF("ModbusConnection", format, a1, a2);
+
+    if (!isSignalConnected(debugSignal)) {
+        return;
+    }
+    QString message = QString::fromUtf8(format);
+    if (!a1.isNull()) {
+        message = message.arg(a1.toString());
+    }
+    if (!a2.isNull()) {
+        message = message.arg(a2.toString());
+    }
     emit const_cast<ModbusConnection*>(this)->debugMessage(message);
 }
 
@@ -567,15 +595,12 @@ void ModbusConnection::timerEvent(QTimerEvent* event)
 
 double ModbusConnection::getAverageResponseTime() const
 {
-    if (responseTimes.isEmpty()) {
-        return 0.0;
-    }
-    
-    double sum = 0.0;
-    for (double time : responseTimes) {
-        sum += time;
-    }
-    return sum / responseTimes.size();
+    return transactionStats.averageMillis(TransactionStats::WIRE);
+}
+
+double ModbusConnection::getResponseTimePercentile(double percentile) const
+{
+    return transactionStats.aggregate(TransactionStats::WIRE).percentile(percentile) / 1000.0;
 }
 
 bool ModbusConnection::readCoils(int addr, int nb, uint8_t* dest)
@@ -630,6 +655,71 @@ bool ModbusConnection::readInputRegisters(int addr, int nb, uint16_t* dest)
     return true;
 }
 
+int ModbusConnection::readBlock(ModbusTypes::RegisterType type, int addr, int nb, uint16_t* dest,
+                                qint64 queueWaitMicros)
+{
+    if (!validateConnection() || nb <= 0) {
+        return -1;
+    }
+
+    const quint8 functionCode = TransactionStats::functionCodeFor(type, false, nb);
+    if (queueWaitMicros >= 0) {
+        transactionStats.record(functionCode, params.slaveId, TransactionStats::QUEUE_WAIT,
+                                static_cast<quint64>(queueWaitMicros));
+    }
+
+    uint8_t bits[MODBUS_MAX_READ_BITS];
+    const bool bitType = (type == ModbusTypes::RegisterType::COIL ||
+                          type == ModbusTypes::RegisterType::DISCRETE_INPUT);
+    if (bitType && nb > MODBUS_MAX_READ_BITS) {
+        nb = MODBUS_MAX_READ_BITS;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int result = -1;
+    switch (type) {
+        case ModbusTypes::RegisterType::COIL:
+            result = modbus_read_bits(ctx, addr, nb, bits);
+            break;
+
+        case ModbusTypes::RegisterType::DISCRETE_INPUT:
+            result = modbus_read_input_bits(ctx, addr, nb, bits);
+            break;
+
+        case ModbusTypes::RegisterType::HOLDING_REGISTER:
+            result = modbus_read_registers(ctx, addr, nb, dest);
+            break;
+
+        case ModbusTypes::RegisterType::INPUT_REGISTER:
+            result = modbus_read_input_registers(ctx, addr, nb, dest);
+            break;
+    }
+    const qint64 wireMicros = timer.nsecsElapsed() / 1000;
+    const int errorCode = (result == -1) ? errno : 0;
+
+    // Bit açma wire süresine dahil edilmez
+    if (bitType) {
+        for (int i = 0; i < result; ++i) {
+            dest[i] = bits[i] ? 1 : 0;
+        }
+    }
+
+    bool success = (result != -1);
+    if (success) {
+        lastCommunicationTime = QDateTime::currentDateTime();
+    } else {
+        lastErrorCode = errorCode;
+        lastError = formatModbusError(errorCode);
+        emit communicationError(lastError);
+    }
+
+    updateStatistics(success, functionCode, wireMicros, errorCode);
+    emit requestCompleted(success);
+    return result;
+}
+
 bool ModbusConnection::writeCoil(int addr, int status)
 {
     ModbusRequest request;
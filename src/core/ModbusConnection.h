@@ -3,9 +3,12 @@
 
 #include "ModbusTypes.h"
 #include "imodbus.h"
+#include "LogRing.h"
+#include "TransactionStats.h"
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QQueue>
 #include <QVector>
@@ -28,6 +31,7 @@ struct ModbusRequest {
     QByteArray writeData;
     bool isWrite;
     QDateTime timestamp;
+    QElapsedTimer queued;       // Kuyrukta bekleme (monoton)
 };
 
 class ModbusConnection : public QObject, public IModbus {
@@ -53,6 +57,12 @@ public:
     bool readHoldingRegisters(int addr, int nb, uint16_t* dest);
     bool readInputRegisters(int addr, int nb, uint16_t* dest);
 
+    // Senkron blok okuma (poller için). Bit tipleri word başına 0/1 olarak
+    // döner. Okunan eleman sayısını, hata durumunda -1 döndürür.
+    // queueWaitMicros >= 0 ise isteğin sıra bekleme süresi olarak kaydedilir.
+    int readBlock(ModbusTypes::RegisterType type, int addr, int nb, uint16_t* dest,
+                  qint64 queueWaitMicros = -1);
+
     // Yazma işlemleri
     bool writeCoil(int addr, int status);
     bool writeRegister(int addr, int value);
@@ -80,7 +90,10 @@ public:
     int getTotalRequests() const { return totalRequests; }
     int getSuccessfulRequests() const { return successfulRequests; }
     int getFailedRequests() const { return failedRequests; }
-    double getAverageResponseTime() const;
+    double getAverageResponseTime() const;                  // ms
+    double getResponseTimePercentile(double percentile) const;  // ms, ör. 50, 99, 99.9
+    const TransactionStats& getTransactionStats() const { return transactionStats; }
+    TransactionStats& getTransactionStats() { return transactionStats; }
     void resetStatistics();
 
 signals:
@@ -106,6 +119,7 @@ private:
     ModbusTypes::ConnectionParams params;
     bool m_isConnected;
     QString lastError;
+    int lastErrorCode;          // Son başarısız isteğin errno değeri
 
     // Timer ayarları ve nesneleri
     QTimer* queueTimer;
@@ -117,7 +131,7 @@ private:
     int totalRequests;
     int successfulRequests;
     int failedRequests;
-    QVector<double> responseTimes;
+    TransactionStats transactionStats;
     QDateTime lastCommunicationTime;
 
     // Request kuyruğu yönetimi
@@ -138,8 +152,9 @@ private:
     // Yardımcı fonksiyonlar
     bool validateAddress(int addr, int quantity, ModbusTypes::RegisterType type) const;
     QString formatModbusError(int errorCode) const;
-    void updateStatistics(bool success, double responseTime);
-    void logDebug(const QString& message) const;
+    void updateStatistics(bool success, quint8 functionCode, qint64 wireMicros, int errorCode);
+    // Debug kapalıysa ve debugMessage'a bağlı alıcı yoksa hiçbir şey biçimlendirilmez
+    void logDebug(const char* format, const LogArg& a1 = LogArg(), const LogArg& a2 = LogArg()) const;
 
     // Bağlantı tipleri için özel kurulumlar
     bool setupTcpConnection();
@@ -3,16 +3,32 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QFile>
+#include <QElapsedTimer>
 #include <QDebug>
+#include <cstring>
+
+namespace {
+
+// Bağlantı koptuğunda yeniden deneme aralığı (ms), her denemede iki katına çıkar
+const int MIN_RECONNECT_DELAY = 1000;
+const int MAX_RECONNECT_DELAY = 30000;
+
+} // namespace
 
 ModbusDevice::ModbusDevice(const QString& name, QObject* parent)
     : QObject(parent)
     , deviceName(name)
     , connection(std::make_unique<ModbusConnection>())
     , isDeviceConnected(false)  // connected yerine isDeviceConnected
+    , tags(std::make_shared<TagTable>())
+    , readPlanDirty(true)
+    , sharedLayoutDirty(true)
     , pollingTimer(nullptr)
     , watchdogTimer(nullptr)
+    , reconnectTimer(nullptr)
+    , reconnectDelay(MIN_RECONNECT_DELAY)
     , polling(false)
+    , pollingRequested(false)
     , pollingInterval(1000)
     , watchdogInterval(5000)
     , totalRequests(0)
@@ -45,14 +61,18 @@ void ModbusDevice::setupTimers()
 {
     pollingTimer = new QTimer(this);
     watchdogTimer = new QTimer(this);
+    reconnectTimer = new QTimer(this);
 
     pollingTimer->setInterval(pollingInterval);
     watchdogTimer->setInterval(watchdogInterval);
+    reconnectTimer->setSingleShot(true);
 
     QObject::connect(pollingTimer, &QTimer::timeout,
             this, &ModbusDevice::handlePollingTimeout);
     QObject::connect(watchdogTimer, &QTimer::timeout,
             this, &ModbusDevice::handleWatchdogTimeout);
+    QObject::connect(reconnectTimer, &QTimer::timeout,
+            this, &ModbusDevice::handleReconnectTimeout);
 }
 
 void ModbusDevice::cleanupTimers()
@@ -68,6 +88,12 @@ void ModbusDevice::cleanupTimers()
         delete watchdogTimer;
         watchdogTimer = nullptr;
     }
+
+    if (reconnectTimer) {
+        reconnectTimer->stop();
+        delete reconnectTimer;
+        reconnectTimer = nullptr;
+    }
 }
 
 bool ModbusDevice::connectToDevice()  // connect yerine connectToDevice
@@ -78,13 +104,17 @@ bool ModbusDevice::connectToDevice()  // connect yerine connectToDevice
 
     if (!connection->connectDevice(connectionParams)) {
         lastError = connection->getLastError();
+        scheduleReconnect();
         return false;
     }
 
     isDeviceConnected = true;  // connected yerine isDeviceConnected
     lastCommunicationTime = QDateTime::currentDateTime();
+    reconnectTimer->stop();
+    reconnectDelay = MIN_RECONNECT_DELAY;
 
-    if (polling) {
+    // Bağlantı kopmadan önce polling isteniyorsa kaldığı yerden sürer
+    if (pollingRequested) {
         startPolling();
     }
 
@@ -93,8 +123,11 @@ bool ModbusDevice::connectToDevice()  // connect yerine connectToDevice
 
 void ModbusDevice::disconnectDevice()  // disconnect yerine disconnectDevice
 {
-    stopPolling();
-    
+    // Polling isteği korunur; yeniden bağlanınca polling sürer
+    haltPolling();
+    reconnectTimer->stop();
+
+
     if (isDeviceConnected) {  // connected yerine isDeviceConnected
         connection->disconnectDevice();  // disconnect yerine disconnectDevice
         isDeviceConnected = false;  // connected yerine isDeviceConnected
@@ -109,6 +142,7 @@ bool ModbusDevice::isConnected() const
 
 bool ModbusDevice::reconnect()
 {
+    connection->getTransactionStats().recordReconnect();
     disconnectDevice();  // disconnect yerine disconnectDevice
     return connectToDevice();  // connect yerine connectToDevice
 }
@@ -171,11 +205,9 @@ bool ModbusDevice::addRegister(const ModbusTypes::RegisterConfig& config)
     
     auto reg = std::make_shared<ModbusRegister>(config);
     registers[config.address] = reg;
-    
-    QObject::connect(reg.get(), &ModbusRegister::valueChanged,  // connect yerine QObject::connect
-            this, [this, address = config.address](const QVariant& value) {
-                emit registerValueChanged(address, value);
-            });
+    tags->addTag(config.address, ModbusTypes::registerWordCount(config));
+    tags->publish();    // Görünümler yeni tag'i bir sonraki poll'u beklemeden görür
+    readPlanDirty = true;
     
     emit registerAdded(config.address);
     emit configurationChanged();
@@ -183,6 +215,61 @@ bool ModbusDevice::addRegister(const ModbusTypes::RegisterConfig& config)
     return true;
 }
 
+int ModbusDevice::addRegisters(const QVector<ModbusTypes::RegisterConfig>& configs)
+{
+    QMutexLocker locker(&registerMutex);
+    int added = insertRegisters(configs);
+    locker.unlock();
+
+    if (added > 0) {
+        emit configurationChanged();
+    }
+    return added;
+}
+
+int ModbusDevice::replaceRegisterMap(const QVector<ModbusTypes::RegisterConfig>& configs)
+{
+    QMutexLocker locker(&registerMutex);
+    registers.clear();
+    tags->clear();
+    readPlanDirty = true;
+    int added = insertRegisters(configs);
+    locker.unlock();
+
+    emit configurationChanged();
+    return added;
+}
+
+// registerMutex tutulurken çağrılır. Okuma planı bir sonraki polling
+// döngüsünde tek seferde yeniden kurulur; tag tablosu hemen yayınlanır
+// (replaceRegisterMap, configurationFromVariantMap ve applyImageDevice de
+// bu yoldan geçer).
+int ModbusDevice::insertRegisters(const QVector<ModbusTypes::RegisterConfig>& configs)
+{
+    tags->reserve(tags->size() + configs.size());
+
+    int added = 0;
+    int rejected = 0;
+    for (const ModbusTypes::RegisterConfig& config : configs) {
+        if (!validateRegisterConfig(config) || registers.contains(config.address)) {
+            ++rejected;
+            continue;
+        }
+        registers.insert(config.address, std::make_shared<ModbusRegister>(config));
+        tags->addTag(config.address, ModbusTypes::registerWordCount(config));
+        ++added;
+    }
+
+    if (rejected > 0) {
+        lastError = QString("%1 register configuration(s) rejected").arg(rejected);
+    }
+    if (added > 0) {
+        readPlanDirty = true;
+    }
+    tags->publish();
+    return added;
+}
+
 bool ModbusDevice::removeRegister(int address)
 {
     QMutexLocker locker(&registerMutex);
@@ -192,6 +279,9 @@ bool ModbusDevice::removeRegister(int address)
     }
     
     registers.remove(address);
+    tags->removeTag(address);
+    tags->publish();
+    readPlanDirty = true;
     emit registerRemoved(address);
     emit configurationChanged();
     
@@ -212,7 +302,16 @@ bool ModbusDevice::updateRegister(int address, const ModbusTypes::RegisterConfig
         return false;
     }
     
+    // updateConfig tipi korur; word sayısı uygulanan yapılandırmadan alınır
+    int oldWords = ModbusTypes::registerWordCount(registers[address]->getConfig());
     registers[address]->updateConfig(config);
+    int newWords = ModbusTypes::registerWordCount(registers[address]->getConfig());
+    if (oldWords != newWords) {
+        tags->removeTag(address);
+        tags->addTag(address, newWords);
+        tags->publish();
+    }
+    readPlanDirty = true;
     emit registerUpdated(address);
     emit configurationChanged();
     
@@ -262,12 +361,49 @@ bool ModbusDevice::setRegisterValue(int address, const QVariant& value)
         return false;
     }
     
-    return reg->setValue(value);
+    if (!reg->setValue(value)) {
+        return false;
+    }
+    
+    locker.unlock();
+    emit registerValueChanged(address, reg->getValue());
+    return true;
+}
+
+bool ModbusDevice::enableSharedMemory()
+{
+    QMutexLocker locker(&registerMutex);
+    if (sharedTags) {
+        return true;
+    }
+
+    // Kapasite büyüyebilir; yine de büyütmeyi nadir kılmak için pay bırakılır
+    auto table = std::make_unique<SharedTagTable>(deviceName);
+    if (!table->open(qMax(256, tags->size() * 2))) {
+        lastError = table->getLastError();
+        return false;
+    }
+    sharedTags = std::move(table);
+    sharedLayoutDirty = true;
+    return true;
+}
+
+void ModbusDevice::disableSharedMemory()
+{
+    QMutexLocker locker(&registerMutex);
+    sharedTags.reset();
 }
 
 void ModbusDevice::startPolling()
 {
-    if (!polling && isDeviceConnected) {  // connected yerine isDeviceConnected
+    pollingRequested = true;
+
+    if (!isDeviceConnected) {  // connected yerine isDeviceConnected
+        scheduleReconnect();
+        return;
+    }
+
+    if (!polling) {
         polling = true;
         pollingTimer->start();
         watchdogTimer->start();
@@ -276,6 +412,15 @@ void ModbusDevice::startPolling()
 }
 
 void ModbusDevice::stopPolling()
+{
+    pollingRequested = false;
+    reconnectTimer->stop();
+    reconnectDelay = MIN_RECONNECT_DELAY;
+    haltPolling();
+}
+
+// Zamanlayıcıları durdurur, polling isteğine dokunmaz
+void ModbusDevice::haltPolling()
 {
     if (polling) {
         polling = false;
@@ -285,6 +430,28 @@ void ModbusDevice::stopPolling()
     }
 }
 
+// Polling isteniyor ama bağlantı yoksa bir sonraki denemeyi kurar
+void ModbusDevice::scheduleReconnect()
+{
+    if (!pollingRequested || reconnectTimer->isActive()) {
+        return;
+    }
+
+    logDebug("Reconnecting in %1 ms", reconnectDelay);
+    reconnectTimer->start(reconnectDelay);
+    reconnectDelay = qMin(reconnectDelay * 2, MAX_RECONNECT_DELAY);
+}
+
+void ModbusDevice::handleReconnectTimeout()
+{
+    if (!pollingRequested || isDeviceConnected) {
+        return;
+    }
+
+    // Başarısız olursa connectToDevice bir sonraki denemeyi kurar
+    reconnect();
+}
+
 bool ModbusDevice::isPolling() const
 {
     return polling;
@@ -296,17 +463,7 @@ void ModbusDevice::handlePollingTimeout()
         return;
     }
     
-    QList<ModbusTypes::RegisterConfig> requests;
-    {
-        QMutexLocker locker(&registerMutex);
-        for (const auto& reg : registers) {
-            requests.append(reg->getConfig());
-        }
-    }
-    
-    if (optimizeRegisterRequests(requests)) {
-        processRegisterUpdates();
-    }
+    processRegisterUpdates();
 }
 
 void ModbusDevice::handleWatchdogTimeout()
@@ -341,10 +498,11 @@ void ModbusDevice::onRegisterValueChanged(int address, const QVariant& value)
 
 void ModbusDevice::onRequestCompleted(bool success)
 {
-    updateStatistics(success, 0.0);
+    updateStatistics(success);
 }
 
-void ModbusDevice::updateStatistics(bool success, double responseTime)
+// Gecikmeler bağlantının TransactionStats'ında tutulur
+void ModbusDevice::updateStatistics(bool success)
 {
     totalRequests++;
     if (success) {
@@ -353,13 +511,6 @@ void ModbusDevice::updateStatistics(bool success, double responseTime)
         failedRequests++;
     }
     
-    if (responseTime > 0) {
-        responseTimes.append(responseTime);
-        if (responseTimes.size() > 1000) {  // Son 1000 yanıt süresini tut
-            responseTimes.removeFirst();
-        }
-    }
-    
     emit statisticsUpdated();
 }
 
@@ -380,15 +531,17 @@ int ModbusDevice::getFailedRequests() const
 
 double ModbusDevice::getAverageResponseTime() const
 {
-    if (responseTimes.isEmpty()) {
-        return 0.0;
-    }
-    
-    double sum = 0.0;
-    for (double time : responseTimes) {
-        sum += time;
-    }
-    return sum / responseTimes.size();
+    return connection->getAverageResponseTime();
+}
+
+double ModbusDevice::getResponseTimePercentile(double percentile) const
+{
+    return connection->getResponseTimePercentile(percentile);
+}
+
+const TransactionStats& ModbusDevice::getTransactionStats() const
+{
+    return connection->getTransactionStats();
 }
 
 void ModbusDevice::resetStatistics()
@@ -396,7 +549,7 @@ void ModbusDevice::resetStatistics()
     totalRequests = 0;
     successfulRequests = 0;
     failedRequests = 0;
-    responseTimes.clear();
+    connection->resetStatistics();
     emit statisticsUpdated();
 }
 
@@ -447,6 +600,8 @@ bool ModbusDevice::validateRegisterConfig(const ModbusTypes::RegisterConfig& con
         case ModbusTypes::DataType::LREAL:
         case ModbusTypes::DataType::STRING:
         case ModbusTypes::DataType::WSTRING:
+        case ModbusTypes::DataType::LINT:
+        case ModbusTypes::DataType::ULINT:
             break;
         default:
             return false;
@@ -463,6 +618,12 @@ bool ModbusDevice::validateRegisterConfig(const ModbusTypes::RegisterConfig& con
             return false;
     }
     
+    // Metin uzunluğu tek okuma isteğine sığmalı
+    if (RegisterCodec::isText(config.dataType) &&
+        (config.stringLength < 1 || config.stringLength > ModbusTypes::MAX_STRING_WORDS)) {
+        return false;
+    }
+    
     // Ölçekleme faktörü kontrolü
     if (config.scaleFactor == 0.0) {
         return false;
@@ -487,120 +648,307 @@ bool ModbusDevice::validateRegisterConfig(const ModbusTypes::RegisterConfig& con
     return true;
 }
 
-bool ModbusDevice::optimizeRegisterRequests(QList<ModbusTypes::RegisterConfig>& requests) const
+void ModbusDevice::rebuildReadPlan()
 {
-    if (requests.isEmpty()) {
-        return false;
-    }
-    
-    // Register'ları tipine göre grupla
-    QMap<ModbusTypes::RegisterType, QList<ModbusTypes::RegisterConfig>> groupedRequests;
-    for (const auto& req : requests) {
-        groupedRequests[req.regType].append(req);
+    readPlan = buildReadPlan();
+    readPlanDirty = false;
+    sharedLayoutDirty = true;
+
+    logDebug("Read plan rebuilt: %1 registers in %2 requests", registers.size(), readPlan.size());
+}
+
+QVector<ModbusDevice::ReadBlock> ModbusDevice::buildReadPlan() const
+{
+    QVector<ReadBlock> plan;
+
+    // Register'ları tipine göre grupla (QMap adrese göre sıralı tutar)
+    QMap<ModbusTypes::RegisterType, QList<ModbusRegister*>> grouped;
+    for (const auto& reg : registers) {
+        grouped[reg->getConfig().regType].append(reg.get());
     }
-    
-    // Her grup için register'ları sırala ve birleştir
-    for (auto& group : groupedRequests) {
-        std::sort(group.begin(), group.end(), 
-                 [](const ModbusTypes::RegisterConfig& a, const ModbusTypes::RegisterConfig& b) {
-                     return a.address < b.address;
-                 });
-        
-        // Ardışık register'ları birleştir
-        QList<ModbusTypes::RegisterConfig> optimized;
-        ModbusTypes::RegisterConfig current = group.first();
-        // Quantity alanı yok, bu yüzden yeni bir değişken kullanıyoruz
-        int currentQuantity = 1;
-        
-        for (int i = 1; i < group.size(); i++) {
-            const auto& next = group[i];
-            
-            // Register'lar ardışık ve aynı veri tipinde mi?
-            if (next.address == current.address + currentQuantity && 
-                next.dataType == current.dataType) {
-                // Birleştir
-                currentQuantity++;
-            } else {
-                // Yeni grup başlat
-                // Quantity'yi bir şekilde taşımamız gerekiyor
-                // Burada bir workaround kullanabiliriz
-                optimized.append(current);
-                current = next;
-                currentQuantity = 1;
+
+    for (auto it = grouped.cbegin(); it != grouped.cend(); ++it) {
+        const ModbusTypes::RegisterType type = it.key();
+        const bool isBit = (type == ModbusTypes::RegisterType::COIL ||
+                            type == ModbusTypes::RegisterType::DISCRETE_INPUT);
+        const int maxCount = isBit ? MODBUS_MAX_READ_BITS : MODBUS_MAX_READ_REGISTERS;
+
+        ReadBlock block;
+        block.type = type;
+        block.startAddress = -1;
+        block.wordCount = 0;
+        block.previousOk = false;
+
+        for (ModbusRegister* reg : it.value()) {
+            const auto& config = reg->getConfig();
+            const int words = ModbusTypes::registerWordCount(config);
+            const int end = config.address + words;
+
+            // Ardışık değilse ya da limit aşılıyorsa yeni blok başlat
+            if (block.startAddress >= 0 &&
+                (config.address > block.startAddress + block.wordCount ||
+                 end - block.startAddress > maxCount)) {
+                plan.append(block);
+                block.tags.clear();
+                block.layouts.clear();
+                block.startAddress = -1;
             }
+            if (block.startAddress < 0) {
+                block.startAddress = config.address;
+                block.wordCount = 0;
+            }
+            block.wordCount = qMax(block.wordCount, end - block.startAddress);
+            appendPlanTag(block, reg);
+        }
+
+        if (block.startAddress >= 0) {
+            plan.append(block);
         }
-        optimized.append(current);
-        
-        group = optimized;
-    }
-    
-    // Optimize edilmiş requestleri birleştir
-    requests.clear();
-    for (const auto& group : groupedRequests) {
-        requests.append(group);
     }
-    
-    return true;
+
+    return plan;
+}
+
+// block.startAddress ayarlanmış olmalıdır
+void ModbusDevice::appendPlanTag(ReadBlock& block, ModbusRegister* reg) const
+{
+    const auto& config = reg->getConfig();
+
+    PlanTag tag;
+    tag.id = tags->idForAddress(config.address);
+    tag.reg = reg;
+    tag.codec = &RegisterCodec::codecFor(config.dataType, config.byteOrder);
+    tag.alarmEnabled = config.isAlarmEnabled;
+    tag.alarmLowLimit = config.alarmLowLimit;
+    tag.alarmHighLimit = config.alarmHighLimit;
+    tag.deadband = config.deadband;
+    tag.lastScaled = 0.0;
+    tag.reported = false;
+    block.tags.append(tag);
+
+    RegisterDecoder::TagLayout layout;
+    layout.wordOffset = static_cast<quint16>(config.address - block.startAddress);
+    layout.wordCount = static_cast<quint8>(ModbusTypes::registerWordCount(config));
+    layout.dataType = config.dataType;
+    layout.byteOrder = config.byteOrder;
+    layout.scale = config.scaleFactor;
+    block.layouts.append(layout);
 }
 
 void ModbusDevice::processRegisterUpdates()
 {
+    // Blokların sıra beklemesi döngü başından ölçülür
+    QElapsedTimer cycleTimer;
+    cycleTimer.start();
+
     QMutexLocker locker(&registerMutex);
-    
-    for (auto& reg : registers) {
-        if (!reg->isValid()) {
+
+    if (readPlanDirty) {
+        rebuildReadPlan();
+    }
+
+    // Önce tüm blokları oku ve yalnızca değişen tag'leri çöz;
+    // I/O sırasında tablo kilitlenmez
+    struct BlockResult {
+        bool ok;
+        QVector<quint16> words;
+        QVector<int> changed;       // Bildirilecek tag indeksleri
+        QVector<quint64> raw;       // changed ile aynı sırada
+        QVector<double> scaled;
+        QVector<QString> texts;     // changed ile aynı sırada; metin olmayanlarda boş
+    };
+
+    TransactionStats& stats = connection->getTransactionStats();
+    const int slaveId = connectionParams.slaveId;
+
+    QVector<BlockResult> results(readPlan.size());
+    for (int b = 0; b < readPlan.size(); ++b) {
+        ReadBlock& block = readPlan[b];
+        BlockResult& result = results[b];
+
+        result.words.fill(0, block.wordCount);
+        result.ok = (connection->readBlock(block.type, block.startAddress, block.wordCount,
+                                           result.words.data(),
+                                           cycleTimer.nsecsElapsed() / 1000) == block.wordCount);
+        if (!result.ok) {
+            block.previousOk = false;
             continue;
         }
-        
-        const auto& config = reg->getConfig();
-        
-        // Register tipine göre okuma işlemi yap
-        switch (config.regType) {
-            case ModbusTypes::RegisterType::DISCRETE_INPUT:
-            {
-                uint8_t value;
-                if (connection->readDiscreteInputs(config.address, 1, &value)) {
-                    reg->setValue(value != 0);
-                }
-                break;
+
+        QElapsedTimer decodeTimer;
+        decodeTimer.start();
+        const quint8 functionCode = TransactionStats::functionCodeFor(block.type, false, block.wordCount);
+
+        // Blok hiç değişmediyse çözme ve bildirim yapılmaz
+        const bool hasPrevious = block.previousOk;
+        block.previousOk = true;
+        if (hasPrevious &&
+            memcmp(block.previousWords.constData(), result.words.constData(),
+                   block.wordCount * sizeof(quint16)) == 0) {
+            stats.record(functionCode, slaveId, TransactionStats::DECODE,
+                         static_cast<quint64>(decodeTimer.nsecsElapsed() / 1000));
+            continue;
+        }
+
+        QVector<int> candidates;
+        QVector<RegisterDecoder::TagLayout> layouts;
+        for (int i = 0; i < block.tags.size(); ++i) {
+            const RegisterDecoder::TagLayout& layout = block.layouts[i];
+            if (hasPrevious &&
+                memcmp(block.previousWords.constData() + layout.wordOffset,
+                       result.words.constData() + layout.wordOffset,
+                       layout.wordCount * sizeof(quint16)) == 0) {
+                continue;
             }
-            case ModbusTypes::RegisterType::COIL:
-            {
-                uint8_t value;
-                if (connection->readCoils(config.address, 1, &value)) {
-                    reg->setValue(value != 0);
-                }
-                break;
+            candidates.append(i);
+            layouts.append(layout);
+        }
+        block.previousWords = result.words;
+
+        QVector<quint64> raw(candidates.size());
+        QVector<double> scaled(candidates.size());
+        RegisterDecoder::decodeBlock(result.words.constData(), block.wordCount,
+                                     layouts.constData(), layouts.size(),
+                                     raw.data(), scaled.data());
+
+        // Ölü bant: son bildirilen değere göre küçük değişimler bastırılır.
+        // Metinler sabit genişlikli decoder'dan geçmez; tüm uzunlukları burada çözülür.
+        for (int k = 0; k < candidates.size(); ++k) {
+            PlanTag& tag = block.tags[candidates[k]];
+            QString text;
+            if (tag.codec->text) {
+                const RegisterDecoder::TagLayout& layout = layouts[k];
+                text = RegisterCodec::decodeText(layout.dataType, layout.byteOrder,
+                                                 result.words.constData() + layout.wordOffset,
+                                                 layout.wordCount);
+            } else if (tag.reported && tag.deadband > 0.0 &&
+                       qAbs(scaled[k] - tag.lastScaled) <= tag.deadband) {
+                continue;
             }
-            case ModbusTypes::RegisterType::INPUT_REGISTER:
-            {
-                uint16_t value;
-                if (connection->readInputRegisters(config.address, 1, &value)) {
-                    reg->setValue(value);
-                }
-                break;
+            tag.reported = true;
+            tag.lastScaled = scaled[k];
+            result.changed.append(candidates[k]);
+            result.raw.append(raw[k]);
+            result.scaled.append(scaled[k]);
+            result.texts.append(text);
+        }
+        stats.record(functionCode, slaveId, TransactionStats::DECODE,
+                     static_cast<quint64>(decodeTimer.nsecsElapsed() / 1000));
+    }
+
+    // Tabloyu güncelle; görünümler değişiklikleri publish() ile görür
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    bool tableChanged = false;
+    for (int b = 0; b < readPlan.size(); ++b) {
+        ReadBlock& block = readPlan[b];
+        const BlockResult& result = results[b];
+
+        if (!result.ok) {
+            for (PlanTag& tag : block.tags) {
+                tags->markBad(tag.id, now);
+                tag.reported = false;
             }
-            case ModbusTypes::RegisterType::HOLDING_REGISTER:
-            {
-                uint16_t value;
-                if (connection->readHoldingRegisters(config.address, 1, &value)) {
-                    reg->setValue(value);
-                }
-                break;
+            tableChanged = tableChanged || !block.tags.isEmpty();
+            continue;
+        }
+
+        for (int k = 0; k < result.changed.size(); ++k) {
+            const PlanTag& tag = block.tags[result.changed[k]];
+            const RegisterDecoder::TagLayout& layout = block.layouts[result.changed[k]];
+            quint8 alarmFlags = TagTable::ALARM_NONE;
+            if (tag.alarmEnabled) {
+                double number = tag.codec->toNumber(result.raw[k]);
+                if (number < tag.alarmLowLimit) alarmFlags |= TagTable::ALARM_LOW;
+                if (number > tag.alarmHighLimit) alarmFlags |= TagTable::ALARM_HIGH;
+            }
+            tags->store(tag.id, result.words.constData() + layout.wordOffset,
+                        result.scaled[k], now, alarmFlags);
+            if (tag.codec->text) {
+                tags->setText(tag.id, result.texts[k]);
             }
         }
+        tableChanged = tableChanged || !result.changed.isEmpty();
+    }
+
+    // Görünümler için yeni kopya; değişiklik yoksa eskisi geçerli kalır
+    if (tableChanged) {
+        tags->publish();
+    }
+
+    // Register nesnelerini ve sinyalleri tablo güncellendikten sonra işle
+    for (int b = 0; b < readPlan.size(); ++b) {
+        const ReadBlock& block = readPlan[b];
+        const BlockResult& result = results[b];
+        if (!result.ok) {
+            continue;
+        }
+
+        lastCommunicationTime = QDateTime::currentDateTime();
+        for (int k = 0; k < result.changed.size(); ++k) {
+            const PlanTag& tag = block.tags[result.changed[k]];
+            tag.reg->updateFromPoll(tag.codec->text ? QVariant(result.texts[k])
+                                                    : tag.codec->toVariant(result.raw[k]));
+        }
+    }
+
+    // Döngü başına tek toplu bildirim: değişen ya da hatalı tag id'leri
+    QBitArray changedTags(tags->size());
+    bool anyChanged = false;
+    for (int b = 0; b < readPlan.size(); ++b) {
+        const ReadBlock& block = readPlan[b];
+        const BlockResult& result = results[b];
+        if (!result.ok) {
+            for (const PlanTag& tag : block.tags) {
+                changedTags.setBit(tag.id);
+            }
+            anyChanged = anyChanged || !block.tags.isEmpty();
+            continue;
+        }
+        for (int index : result.changed) {
+            changedTags.setBit(block.tags[index].id);
+        }
+        anyChanged = anyChanged || !result.changed.isEmpty();
+    }
+
+    // Paylaşımlı segment her döngüde güncellenir (heartbeat)
+    if (sharedTags) {
+        if (sharedLayoutDirty) {
+            if (!sharedTags->setLayout(*tags)) {
+                LOG_WARNING(sharedTags->getLastError(), QString("ModbusDevice[%1]").arg(deviceName));
+            }
+            sharedLayoutDirty = false;
+        }
+        sharedTags->update(*tags, changedTags);
+    }
+
+    locker.unlock();
+    if (anyChanged) {
+        emit blockUpdated(deviceName, changedTags);
     }
 }
 
 void ModbusDevice::handleCommunicationTimeout()
 {
     logDebug("Communication timeout detected");
+    // Başarısız olursa connectToDevice artan aralıklarla yeniden dener
     reconnect();
 }
 
-void ModbusDevice::logDebug(const QString& message) const
+void ModbusDevice::logDebug(const char* format, const LogArg& a1, const LogArg& a2) const
 {
-    qDebug() << "ModbusDevice[" << deviceName << "]:" << message;
+    // Debug kapalıysa mesaj ve bağlam hiç oluşturulmaz
+    if (QMODBUS_LOG_MIN_LEVEL > 0 || !Logger::instance().isEnabled(Logger::Level::DEBUG)) {
+        return;
+    }
+
+    QString message = QString::fromUtf8(format);
+    if (!a1.isNull()) {
+        message = message.arg(a1.toString());
+    }
+    if (!a2.isNull()) {
+        message = message.arg(a2.toString());
+    }
+    Logger::instance().debug(message, QString("ModbusDevice[%1]").arg(deviceName));
 }
 
 bool ModbusDevice::saveConfiguration(const QString& filename) const
@@ -624,18 +972,34 @@ bool ModbusDevice::saveConfiguration(const QString& filename) const
 
 bool ModbusDevice::loadConfiguration(const QString& filename)
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly)) {
-        lastError = "Failed to open configuration file for reading";
-        return false;
-    }
+    // İkili imaj ayrıştırılmadan eşlenir; diğer dosyalar JSON olarak okunur
+    ConfigImage image;
+    QJsonDocument doc;
+    int imageDevice = -1;
+    if (ConfigImage::isImageFile(filename)) {
+        if (!image.open(filename)) {
+            lastError = image.getLastError();
+            return false;
+        }
+        imageDevice = image.findDevice(deviceName);
+        if (imageDevice < 0) {
+            lastError = QString("Device %1 not found in configuration image").arg(deviceName);
+            return false;
+        }
+    } else {
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            lastError = "Failed to open configuration file for reading";
+            return false;
+        }
 
-    QByteArray data = file.readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    
-    if (doc.isNull() || !doc.isObject()) {
-        lastError = "Invalid configuration file format";
-        return false;
+        QByteArray data = file.readAll();
+        doc = QJsonDocument::fromJson(data);
+        
+        if (doc.isNull() || !doc.isObject()) {
+            lastError = "Invalid configuration file format";
+            return false;
+        }
     }
 
     bool wasConnected = isDeviceConnected;  // connected yerine isDeviceConnected
@@ -645,7 +1009,9 @@ bool ModbusDevice::loadConfiguration(const QString& filename)
         disconnectDevice();  // disconnect yerine disconnectDevice
     }
 
-    if (!configurationFromVariantMap(doc.object().toVariantMap())) {
+    if (imageDevice >= 0) {
+        applyImageDevice(image, imageDevice);
+    } else if (!configurationFromVariantMap(doc.object().toVariantMap())) {
         if (wasConnected) {
             connectToDevice();  // connect yerine connectToDevice
             if (wasPolling) {
@@ -666,6 +1032,96 @@ bool ModbusDevice::loadConfiguration(const QString& filename)
     return true;
 }
 
+bool ModbusDevice::saveConfigurationImage(const QString& filename) const
+{
+    ConfigImage::Writer writer;
+    writeToImage(writer);
+    if (!writer.save(filename)) {
+        const_cast<ModbusDevice*>(this)->lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+void ModbusDevice::writeToImage(ConfigImage::Writer& writer) const
+{
+    QMutexLocker locker(&registerMutex);
+
+    // Tag'ler okuma bloklarının sırasıyla yazılır; her blok ardışık bir aralıktır
+    const QVector<ReadBlock> plan = readPlanDirty ? buildReadPlan() : readPlan;
+    writer.addDevice(deviceName, pollingInterval, watchdogInterval, connectionParams);
+    for (const ReadBlock& block : plan) {
+        for (const PlanTag& tag : block.tags) {
+            writer.addTag(tag.reg->getConfig());
+        }
+        writer.addPlan(block.type, block.startAddress, block.wordCount, block.tags.size());
+    }
+}
+
+bool ModbusDevice::loadFromImage(const ConfigImage& image, int deviceIndex)
+{
+    if (!image.isOpen() || deviceIndex < 0 || deviceIndex >= image.deviceCount()) {
+        lastError = "Invalid configuration image device";
+        return false;
+    }
+
+    applyImageDevice(image, deviceIndex);
+    emit configurationChanged();
+    return true;
+}
+
+void ModbusDevice::applyImageDevice(const ConfigImage& image, int deviceIndex)
+{
+    const ConfigImage::DeviceRecord& dev = image.device(deviceIndex);
+    deviceName = image.string(dev.name);
+    pollingInterval = dev.pollingInterval;
+    watchdogInterval = dev.watchdogInterval;
+    connectionParams = image.connectionParams(dev);
+
+    const ConfigImage::TagRecord* tagRecords = image.deviceTags(dev);
+    QVector<ModbusTypes::RegisterConfig> configs;
+    configs.reserve(static_cast<int>(dev.tagCount));
+    for (quint32 i = 0; i < dev.tagCount; ++i) {
+        configs.append(image.registerConfig(tagRecords[i]));
+    }
+
+    QMutexLocker locker(&registerMutex);
+    registers.clear();
+    tags->clear();
+    readPlanDirty = true;
+    if (insertRegisters(configs) != configs.size()) {
+        return;  // Reddedilen tag varsa plan yeniden hesaplanır
+    }
+
+    // Kayıtlı okuma planını doğrudan kullan
+    QVector<ReadBlock> plan;
+    plan.reserve(static_cast<int>(dev.planCount));
+    const ConfigImage::PlanRecord* planRecords = image.devicePlans(dev);
+    for (quint32 p = 0; p < dev.planCount; ++p) {
+        const ConfigImage::PlanRecord& record = planRecords[p];
+        ReadBlock block;
+        block.type = static_cast<ModbusTypes::RegisterType>(record.regType);
+        block.startAddress = record.startAddress;
+        block.wordCount = record.wordCount;
+        block.previousOk = false;
+
+        for (quint32 t = 0; t < record.tagCount; ++t) {
+            const ModbusTypes::RegisterConfig& config = configs[record.firstTag + t];
+            const int end = config.address + ModbusTypes::registerWordCount(config);
+            if (config.regType != block.type || config.address < block.startAddress ||
+                end > block.startAddress + block.wordCount) {
+                return;  // Plan tag'lerle uyuşmuyor; yeniden hesaplanır
+            }
+            appendPlanTag(block, registers.value(config.address).get());
+        }
+        plan.append(block);
+    }
+
+    readPlan = plan;
+    readPlanDirty = false;
+    sharedLayoutDirty = true;
+}
+
 QVariantMap ModbusDevice::configurationToVariantMap() const
 {
     QVariantMap map;
@@ -716,6 +1172,10 @@ QVariantMap ModbusDevice::configurationToVariantMap() const
         regMap["alarmHighLimit"] = config.alarmHighLimit;
         regMap["alarmLowLimit"] = config.alarmLowLimit;
         regMap["byteOrder"] = static_cast<int>(config.byteOrder);
+        regMap["deadband"] = config.deadband;
+        if (RegisterCodec::isText(config.dataType)) {
+            regMap["stringLength"] = config.stringLength;
+        }
         
         registerList.append(regMap);
     }
@@ -752,8 +1212,8 @@ bool ModbusDevice::configurationFromVariantMap(const QVariantMap& map)
     
     // Register yapılandırmaları
     QVariantList registerList = map["registers"].toList();
-    QMutexLocker locker(&registerMutex);
-    registers.clear();
+    QVector<ModbusTypes::RegisterConfig> configs;
+    configs.reserve(registerList.size());
     
     for (const QVariant& v : registerList) {
         QVariantMap regMap = v.toMap();
@@ -773,17 +1233,18 @@ bool ModbusDevice::configurationFromVariantMap(const QVariantMap& map)
         config.alarmHighLimit = regMap["alarmHighLimit"].toDouble();
         config.alarmLowLimit = regMap["alarmLowLimit"].toDouble();
         config.byteOrder = static_cast<ModbusTypes::ByteOrder>(regMap["byteOrder"].toInt());
+        config.deadband = regMap["deadband"].toDouble();
+        config.stringLength = regMap.value("stringLength", ModbusTypes::DEFAULT_STRING_WORDS).toInt();
         
-        if (validateRegisterConfig(config)) {
-            auto reg = std::make_shared<ModbusRegister>(config);
-            registers[config.address] = reg;
-            
-            QObject::connect(reg.get(), &ModbusRegister::valueChanged,  // connect yerine QObject::connect
-                    this, [this, address = config.address](const QVariant& value) {
-                        emit registerValueChanged(address, value);
-                    });
-        }
+        configs.append(config);
     }
+
+    // Bildirim loadConfiguration tarafından bir kez yapılır
+    QMutexLocker locker(&registerMutex);
+    registers.clear();
+    tags->clear();
+    readPlanDirty = true;
+    insertRegisters(configs);
     
     return true;
 }
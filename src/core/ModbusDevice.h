@@ -4,11 +4,17 @@
 #include "ModbusConnection.h"
 #include "ModbusRegister.h"
 #include "ModbusTypes.h"
+#include "TagTable.h"
+#include "RegisterDecoder.h"
+#include "RegisterCodec.h"
+#include "ConfigImage.h"
+#include "SharedTagTable.h"
 #include <QObject>
 #include <QMap>
 #include <QTimer>
 #include <QDateTime>
 #include <QMutex>
+#include <QBitArray>
 #include <memory>
 
 // PLC'deki register yapılandırması
@@ -20,12 +26,14 @@ struct RegisterConfig {
     QString unit;         // Birim (°C, Bar, mA, vs.)
     double minValue;      // Minimum değer
     double maxValue;      // Maximum değer
+    double deadband;      // Ölü bant (ölçeklenmiş birimde, 0 = kapalı)
 
     RegisterConfig() : 
         address(0),
         scaleFactor(1.0),
         minValue(0.0),
-        maxValue(65535.0)
+        maxValue(65535.0),
+        deadband(0.0)
     {}
 };
 
@@ -97,12 +105,27 @@ public:
     bool addRegister(const ModbusTypes::RegisterConfig& config);
     bool removeRegister(int address);
     bool updateRegister(int address, const ModbusTypes::RegisterConfig& config);
+    // Toplu işlemler: tek geçişte doğrulama, tek okuma planı, tek bildirim.
+    // Geçersiz ya da yinelenen adresler atlanır; eklenen register sayısı döner.
+    // Tag değerleri TagTable'da bitişik sütunlarda tutulur; her tag için
+    // ayrıca yazma ve sinyal arayüzü olan bir ModbusRegister nesnesi oluşur.
+    int addRegisters(const QVector<ModbusTypes::RegisterConfig>& configs);
+    int replaceRegisterMap(const QVector<ModbusTypes::RegisterConfig>& configs);
     ModbusTypes::RegisterConfig getRegisterConfig(int address) const;
     QList<int> getRegisterAddresses() const;
     QVariant getRegisterValue(int address) const;
     bool setRegisterValue(int address, const QVariant& value);
 
-    // Polling kontrolü
+    // Görünümlerle paylaşılan tag tablosu
+    std::shared_ptr<const TagTable> getTagTable() const { return tags; }
+    // Tag tablosunu diğer süreçlere paylaşımlı bellek segmenti olarak yayınlar
+    bool enableSharedMemory();
+    void disableSharedMemory();
+    bool isSharedMemoryEnabled() const { return sharedTags != nullptr; }
+
+    // Polling kontrolü. startPolling isteği bağlantı kopsa da korunur:
+    // bağlı değilken artan aralıklarla yeniden bağlanılır ve bağlantı
+    // kurulunca polling kendiliğinden sürer. stopPolling isteği kaldırır.
     void startPolling();
     void stopPolling();
     bool isPolling() const;
@@ -111,7 +134,10 @@ public:
     int getTotalRequests() const;
     int getSuccessfulRequests() const;
     int getFailedRequests() const;
-    double getAverageResponseTime() const;
+    double getAverageResponseTime() const;                  // ms
+    double getResponseTimePercentile(double percentile) const;  // ms
+    // Fonksiyon kodu / slave id / evre başına gecikme histogramları
+    const TransactionStats& getTransactionStats() const;
     void resetStatistics();
 
     // Hata yönetimi
@@ -124,15 +150,23 @@ public:
     void setRetryCount(int count);
 
     // Yapılandırma kaydetme/yükleme
+    // JSON değişim biçimidir; ConfigImage dosyaları otomatik tanınır
     bool saveConfiguration(const QString& filename) const;
     bool loadConfiguration(const QString& filename);
 
+    // İkili imaj: birden çok cihaz tek dosyaya yazılabilir
+    bool saveConfigurationImage(const QString& filename) const;
+    void writeToImage(ConfigImage::Writer& writer) const;
+    bool loadFromImage(const ConfigImage& image, int deviceIndex);
+
 signals:
     void deviceConnected();
     void deviceDisconnected();
     void connectionError(const QString& error);
     void communicationError(const QString& error);
     void registerValueChanged(int address, const QVariant& value);
+    // Polling döngüsü başına bir kez; bitler TagTable id'leridir
+    void blockUpdated(const QString& deviceName, const QBitArray& changedTags);
     void registerAdded(int address);
     void registerRemoved(int address);
     void registerUpdated(int address);
@@ -151,6 +185,7 @@ private slots:
     void onRequestCompleted(bool success);
     void handlePollingTimeout();
     void handleWatchdogTimeout();
+    void handleReconnectTimeout();
 
 private:
     QString deviceName;
@@ -159,29 +194,68 @@ private:
     bool isDeviceConnected;
     mutable QString lastError;
 
+    // Okuma planı: aynı tipte ardışık register'lar tek istekte okunur
+    struct PlanTag {
+        int id;                 // TagTable id
+        ModbusRegister* reg;
+        const RegisterCodec::Codec* codec;
+        bool alarmEnabled;
+        double alarmLowLimit;
+        double alarmHighLimit;
+        double deadband;
+        double lastScaled;      // Son bildirilen ölçeklenmiş değer
+        bool reported;
+    };
+
+    struct ReadBlock {
+        ModbusTypes::RegisterType type;
+        int startAddress;
+        int wordCount;
+        QVector<PlanTag> tags;
+        QVector<RegisterDecoder::TagLayout> layouts;
+        QVector<quint16> previousWords;     // Değişim tespiti için son okuma
+        bool previousOk;
+    };
+
+    // Adres -> yapılandırma, yazma dönüşümü ve alarm durumu (tag başına bir
+    // nesne). Poll döngüsü bu nesnelere yalnızca değişen tag'ler için dokunur;
+    // sıcak alanlar PlanTag'de, değerler TagTable'da bitişik tutulur.
     QMap<int, std::shared_ptr<ModbusRegister>> registers;
+    std::shared_ptr<TagTable> tags;     // Poll edilen değerler, bitişik sütunlar
+    QVector<ReadBlock> readPlan;
+    bool readPlanDirty;
     mutable QMutex registerMutex;
+    std::unique_ptr<SharedTagTable> sharedTags;
+    bool sharedLayoutDirty;     // Okuma planı değişti; segment yeniden yazılır
 
     QTimer* pollingTimer;
     QTimer* watchdogTimer;
-    bool polling;
+    QTimer* reconnectTimer;
+    int reconnectDelay;         // ms; her başarısız denemede iki katına çıkar
+    bool polling;               // Zamanlayıcılar çalışıyor
+    bool pollingRequested;      // startPolling çağrıldı, stopPolling çağrılmadı
     int pollingInterval;
     int watchdogInterval;
 
     int totalRequests;
     int successfulRequests;
     int failedRequests;
-    QVector<double> responseTimes;
     QDateTime lastCommunicationTime;
 
     void setupTimers();
     void cleanupTimers();
+    void haltPolling();
+    void scheduleReconnect();
     bool validateRegisterConfig(const ModbusTypes::RegisterConfig& config) const;
-    void updateStatistics(bool success, double responseTime);
+    void updateStatistics(bool success);
     void processRegisterUpdates();
     void handleCommunicationTimeout();
-    bool optimizeRegisterRequests(QList<ModbusTypes::RegisterConfig>& requests) const;
-    void logDebug(const QString& message) const;
+    void rebuildReadPlan();
+    QVector<ReadBlock> buildReadPlan() const;
+    void appendPlanTag(ReadBlock& block, ModbusRegister* reg) const;
+    void applyImageDevice(const ConfigImage& image, int deviceIndex);
+    int insertRegisters(const QVector<ModbusTypes::RegisterConfig>& configs);
+    void logDebug(const char* format, const LogArg& a1 = LogArg(), const LogArg& a2 = LogArg()) const;
 
     QVariantMap configurationToVariantMap() const;
     bool configurationFromVariantMap(const QVariantMap& map);
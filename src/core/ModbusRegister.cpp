@@ -1,43 +1,20 @@
 #include "ModbusRegister.h"
+#include "Logger.h"
 #include <QDebug>
 #include <QDataStream>
+#include <QVector>
+#include <cstring>
 
 ModbusRegister::ModbusRegister(const ModbusTypes::RegisterConfig& config, QObject* parent)
     : QObject(parent)
     , config(config)
+    , codec(&RegisterCodec::codecFor(config.dataType, config.byteOrder))
     , valid(false)
     , alarmState(false)
     , updateCount(0)
 {
-    // İlk değer ataması
-    switch (config.dataType) {
-        case ModbusTypes::DataType::BIT:
-            value = false;
-            break;
-        case ModbusTypes::DataType::BYTE:
-        case ModbusTypes::DataType::WORD:
-            value = static_cast<quint16>(0);
-            break;
-        case ModbusTypes::DataType::INT:
-            value = static_cast<qint16>(0);
-            break;
-        case ModbusTypes::DataType::DWORD:
-            value = static_cast<quint32>(0);
-            break;
-        case ModbusTypes::DataType::DINT:
-            value = static_cast<qint32>(0);
-            break;
-        case ModbusTypes::DataType::REAL:
-            value = 0.0f;
-            break;
-        case ModbusTypes::DataType::LREAL:
-            value = 0.0;
-            break;
-        case ModbusTypes::DataType::STRING:
-        case ModbusTypes::DataType::WSTRING:
-            value = QString();
-            break;
-    }
+    // İlk değer ataması: sıfır bitlerin tipe göre karşılığı
+    value = codec->toVariant(0);
 }
 
 ModbusRegister::~ModbusRegister()
@@ -47,9 +24,8 @@ ModbusRegister::~ModbusRegister()
 QVariant ModbusRegister::getValue() const
 {
     QMutexLocker locker(&mutex);
-    qDebug() << "ModbusRegister::getValue: adres =" << config.address 
-             << ", değer =" << value 
-             << ", tip =" << value.typeName();
+    LOG_DEBUGF("ModbusRegister", "getValue: address=%1 value=%2 type=%3",
+               config.address, value.toString(), value.typeName());
     return value;
 }
 
@@ -130,6 +106,48 @@ bool ModbusRegister::setRawData(const QByteArray& data)
     return true;
 }
 
+QVariant ModbusRegister::decodeRawWords(const quint16* words, int count) const
+{
+    if (count <= 0) return QVariant();
+
+    if (codec->text) {
+        return RegisterCodec::decodeText(config.dataType, config.byteOrder, words,
+                                         qMin(count, ModbusTypes::registerWordCount(config)));
+    }
+
+    // Eksik word'ler 0 kabul edilir
+    quint16 padded[4] = {0, 0, 0, 0};
+    if (count < codec->wordCount) {
+        memcpy(padded, words, count * sizeof(quint16));
+        words = padded;
+    }
+    return codec->toVariant(codec->load(words));
+}
+
+bool ModbusRegister::updateFromPoll(const QVariant& newValue)
+{
+    QMutexLocker locker(&mutex);
+
+    if (!newValue.isValid()) {
+        return false;
+    }
+
+    if (valid && value == newValue) {
+        return false;
+    }
+
+    value = newValue;
+    valid = true;
+    lastUpdateTime = QDateTime::currentDateTime();
+    updateCount++;
+
+    checkAlarmState();
+
+    emit valueChanged(value);
+    emit scaledValueChanged(scaleValue(value, false));
+    return true;
+}
+
 void ModbusRegister::setScaleFactor(double factor)
 {
     if (factor == 0.0) {
@@ -278,6 +296,7 @@ void ModbusRegister::updateConfig(const ModbusTypes::RegisterConfig& newConfig)
     
     // Yeni yapılandırmayı uygula
     config = updatedConfig;
+    codec = &RegisterCodec::codecFor(config.dataType, config.byteOrder);
     
     // Mevcut değeri yeni yapılandırmaya göre kontrol et
     QVariant oldValue = value;
@@ -325,292 +344,77 @@ void ModbusRegister::checkAlarmState()
 
 QVariant ModbusRegister::convertToDataType(const QVariant& value, ModbusTypes::DataType targetType) const
 {
-    bool ok;
-    
-    switch (targetType) {
-        case ModbusTypes::DataType::BIT:
-            return value.toBool();
-            
-        case ModbusTypes::DataType::BYTE:
-            {
-                quint8 val = value.toUInt(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::WORD:
-            {
-                quint16 val = value.toUInt(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::INT:
-            {
-                qint16 val = value.toInt(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::DWORD:
-            {
-                quint32 val = value.toUInt(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::DINT:
-            {
-                qint32 val = value.toInt(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::REAL:
-            {
-                float val = value.toFloat(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::LREAL:
-            {
-                double val = value.toDouble(&ok);
-                return ok ? QVariant(val) : QVariant();
-            }
-            
-        case ModbusTypes::DataType::STRING:
-        case ModbusTypes::DataType::WSTRING:
-            return value.toString();
-    }
-    
-    return QVariant();
-}
-
-template<typename T>
-T ModbusRegister::reorderBytes(T value, ModbusTypes::ByteOrder order) const
-{
-    switch (order) {
-        case ModbusTypes::ByteOrder::AB_CD:  // Big-Endian (default)
-            return value;
-            
-        case ModbusTypes::ByteOrder::CD_AB:  // Little-Endian
-            {
-                T result = 0;
-                char* src = reinterpret_cast<char*>(&value);
-                char* dst = reinterpret_cast<char*>(&result);
-                for (size_t i = 0; i < sizeof(T); ++i) {
-                    dst[i] = src[sizeof(T) - 1 - i];
-                }
-                return result;
-            }
-            
-        case ModbusTypes::ByteOrder::BA_DC:  // Big-Endian Byte Swap
-            {
-                T result = 0;
-                char* src = reinterpret_cast<char*>(&value);
-                char* dst = reinterpret_cast<char*>(&result);
-                for (size_t i = 0; i < sizeof(T); i += 2) {
-                    dst[i] = src[i + 1];
-                    dst[i + 1] = src[i];
-                }
-                return result;
-            }
-            
-        case ModbusTypes::ByteOrder::DC_BA:  // Little-Endian Byte Swap
-            {
-                T result = 0;
-                char* src = reinterpret_cast<char*>(&value);
-                char* dst = reinterpret_cast<char*>(&result);
-                for (size_t i = 0; i < sizeof(T); i += 2) {
-                    dst[sizeof(T) - i - 2] = src[i + 1];
-                    dst[sizeof(T) - i - 1] = src[i];
-                }
-                return result;
-            }
+    // Metinler olduğu gibi kalır; uzunluk validateValue'da denetlenir
+    if (RegisterCodec::isText(targetType)) {
+        return value.canConvert<QString>() ? QVariant(value.toString()) : QVariant();
     }
-    
-    return value;
-}
 
-QByteArray ModbusRegister::applyByteOrder(const QByteArray& data) const
-{
-    if (data.isEmpty()) return data;
-    
-    QByteArray result = data;
-    
-    switch (config.dataType) {
-        case ModbusTypes::DataType::WORD:
-        case ModbusTypes::DataType::INT:
-            {
-                quint16 value;
-                memcpy(&value, data.constData(), sizeof(quint16));
-                value = reorderBytes(value, config.byteOrder);
-                memcpy(result.data(), &value, sizeof(quint16));
-            }
-            break;
-            
-        case ModbusTypes::DataType::DWORD:
-        case ModbusTypes::DataType::DINT:
-        case ModbusTypes::DataType::REAL:
-            {
-                quint32 value;
-                memcpy(&value, data.constData(), sizeof(quint32));
-                value = reorderBytes(value, config.byteOrder);
-                memcpy(result.data(), &value, sizeof(quint32));
-            }
-            break;
-            
-        case ModbusTypes::DataType::LREAL:
-            {
-                quint64 value;
-                memcpy(&value, data.constData(), sizeof(quint64));
-                value = reorderBytes(value, config.byteOrder);
-                memcpy(result.data(), &value, sizeof(quint64));
-            }
-            break;
-            
-        default:
-            break;
+    const RegisterCodec::Codec& target = RegisterCodec::codecFor(targetType, ModbusTypes::ByteOrder::AB_CD);
+    quint64 bits = 0;
+    if (!target.encode(value, bits)) {
+        return QVariant();
     }
-    
-    return result;
+    return target.toVariant(bits);
 }
 
 QVariant ModbusRegister::convertFromRawData(const QByteArray& data) const
 {
     if (data.isEmpty()) return QVariant();
     
-    QByteArray orderedData = applyByteOrder(data);
+    if (codec->text) {
+        QVector<quint16> words(qMin(ModbusTypes::registerWordCount(config), (data.size() + 1) / 2));
+        for (int i = 0; i < words.size(); ++i) {
+            quint8 hi = static_cast<quint8>(data[i * 2]);
+            quint8 lo = (i * 2 + 1 < data.size()) ? static_cast<quint8>(data[i * 2 + 1]) : 0;
+            words[i] = static_cast<quint16>((hi << 8) | lo);
+        }
+        return RegisterCodec::decodeText(config.dataType, config.byteOrder,
+                                         words.constData(), words.size());
+    }
     
-    switch (config.dataType) {
-        case ModbusTypes::DataType::BIT:
-            return orderedData[0] != 0;
-            
-        case ModbusTypes::DataType::BYTE:
-            return static_cast<quint8>(orderedData[0]);
-            
-        case ModbusTypes::DataType::WORD:
-            {
-                quint16 value;
-                memcpy(&value, orderedData.constData(), sizeof(quint16));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::INT:
-            {
-                qint16 value;
-                memcpy(&value, orderedData.constData(), sizeof(qint16));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::DWORD:
-            {
-                quint32 value;
-                memcpy(&value, orderedData.constData(), sizeof(quint32));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::DINT:
-            {
-                qint32 value;
-                memcpy(&value, orderedData.constData(), sizeof(qint32));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::REAL:
-            {
-                float value;
-                memcpy(&value, orderedData.constData(), sizeof(float));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::LREAL:
-            {
-                double value;
-                memcpy(&value, orderedData.constData(), sizeof(double));
-                return value;
-            }
-            
-        case ModbusTypes::DataType::STRING:
-            return QString::fromLatin1(orderedData);
-            
-        case ModbusTypes::DataType::WSTRING:
-            return QString::fromUtf16(reinterpret_cast<const ushort*>(orderedData.constData()));
+    quint16 words[4] = {0, 0, 0, 0};
+    int n = qMin(codec->wordCount, (data.size() + 1) / 2);
+    for (int i = 0; i < n; ++i) {
+        quint8 hi = static_cast<quint8>(data[i * 2]);
+        quint8 lo = (i * 2 + 1 < data.size()) ? static_cast<quint8>(data[i * 2 + 1]) : 0;
+        words[i] = static_cast<quint16>((hi << 8) | lo);
     }
     
-    return QVariant();
+    return codec->toVariant(codec->load(words));
 }
 
 QByteArray ModbusRegister::convertToRawData(const QVariant& value) const
 {
-    QByteArray data;
-    
-    switch (config.dataType) {
-        case ModbusTypes::DataType::BIT:
-            data.append(value.toBool() ? 1 : 0);
-            break;
-            
-        case ModbusTypes::DataType::BYTE:
-            data.append(static_cast<char>(value.toUInt()));
-            break;
-            
-        case ModbusTypes::DataType::WORD:
-            {
-                quint16 val = value.toUInt();
-                data.resize(sizeof(quint16));
-                memcpy(data.data(), &val, sizeof(quint16));
-            }
-            break;
-            
-        case ModbusTypes::DataType::INT:
-            {
-                qint16 val = value.toInt();
-                data.resize(sizeof(qint16));
-                memcpy(data.data(), &val, sizeof(qint16));
-            }
-            break;
-            
-        case ModbusTypes::DataType::DWORD:
-            {
-                quint32 val = value.toUInt();
-                data.resize(sizeof(quint32));
-                memcpy(data.data(), &val, sizeof(quint32));
-            }
-            break;
-            
-        case ModbusTypes::DataType::DINT:
-            {
-                qint32 val = value.toInt();
-                data.resize(sizeof(qint32));
-                memcpy(data.data(), &val, sizeof(qint32));
-            }
-            break;
-            
-        case ModbusTypes::DataType::REAL:
-            {
-                float val = value.toFloat();
-                data.resize(sizeof(float));
-                memcpy(data.data(), &val, sizeof(float));
-            }
-            break;
-            
-        case ModbusTypes::DataType::LREAL:
-            {
-                double val = value.toDouble();
-                data.resize(sizeof(double));
-                memcpy(data.data(), &val, sizeof(double));
-            }
-            break;
-            
-        case ModbusTypes::DataType::STRING:
-            data = value.toString().toLatin1();
-            break;
-            
-        case ModbusTypes::DataType::WSTRING:
-            {
-                QString str = value.toString();
-                data.resize(str.length() * sizeof(ushort));
-                memcpy(data.data(), str.utf16(), str.length() * sizeof(ushort));
-            }
-            break;
+    if (codec->text) {
+        QVector<quint16> words(ModbusTypes::registerWordCount(config));
+        if (!RegisterCodec::encodeText(config.dataType, config.byteOrder, value.toString(),
+                                       words.data(), words.size())) {
+            return QByteArray();
+        }
+        QByteArray data;
+        data.resize(words.size() * 2);
+        for (int i = 0; i < words.size(); ++i) {
+            data[i * 2] = static_cast<char>(words[i] >> 8);
+            data[i * 2 + 1] = static_cast<char>(words[i] & 0xFF);
+        }
+        return data;
     }
+
+    quint64 bits = 0;
+    if (!codec->encode(value, bits)) {
+        return QByteArray();
+    }
+    
+    quint16 words[4];
+    codec->store(bits, words);
     
-    return applyByteOrder(data);
+    QByteArray data;
+    data.resize(codec->wordCount * 2);
+    for (int i = 0; i < codec->wordCount; ++i) {
+        data[i * 2] = static_cast<char>(words[i] >> 8);
+        data[i * 2 + 1] = static_cast<char>(words[i] & 0xFF);
+    }
+    return data;
 }
 
 bool ModbusRegister::validateValue(const QVariant& testValue) const
@@ -619,78 +423,22 @@ bool ModbusRegister::validateValue(const QVariant& testValue) const
         return false;
     }
     
+    // Metin: yapılandırılan word sayısına sığmalı
+    if (codec->text) {
+        if (!testValue.canConvert<QString>()) return false;
+        QVector<quint16> words(ModbusTypes::registerWordCount(config));
+        return RegisterCodec::encodeText(config.dataType, config.byteOrder, testValue.toString(),
+                                         words.data(), words.size());
+    }
+    
     // Veri tipi kontrolü
-    switch (config.dataType) {
-        case ModbusTypes::DataType::BIT:
-            if (!testValue.canConvert<bool>()) return false;
-            break;
-            
-        case ModbusTypes::DataType::BYTE:
-            {
-                bool ok;
-                quint8 val = testValue.toUInt(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::WORD:
-            {
-                bool ok;
-                quint16 val = testValue.toUInt(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::INT:
-            {
-                bool ok;
-                qint16 val = testValue.toInt(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::DWORD:
-            {
-                bool ok;
-                quint32 val = testValue.toUInt(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::DINT:
-            {
-                bool ok;
-                qint32 val = testValue.toInt(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::REAL:
-            {
-                bool ok;
-                float val = testValue.toFloat(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::LREAL:
-            {
-                bool ok;
-                double val = testValue.toDouble(&ok);
-                if (!ok) return false;
-            }
-            break;
-            
-        case ModbusTypes::DataType::STRING:
-        case ModbusTypes::DataType::WSTRING:
-            if (!testValue.canConvert<QString>()) return false;
-            break;
+    quint64 bits = 0;
+    if (!codec->encode(testValue, bits)) {
+        return false;
     }
     
     // Sayısal değerler için aralık kontrolü
-    if (config.dataType != ModbusTypes::DataType::BIT &&
-        config.dataType != ModbusTypes::DataType::STRING &&
-        config.dataType != ModbusTypes::DataType::WSTRING) {
+    if (codec->scaled) {
         
         bool ok;
         double numValue = testValue.toDouble(&ok);
@@ -724,9 +472,7 @@ QVariant ModbusRegister::scaleValue(const QVariant& value, bool inverse) const
     }
     
     // String ve bit değerleri için ölçekleme yapma
-    if (config.dataType == ModbusTypes::DataType::BIT ||
-        config.dataType == ModbusTypes::DataType::STRING ||
-        config.dataType == ModbusTypes::DataType::WSTRING) {
+    if (!codec->scaled) {
         return value;
     }
     
@@ -760,6 +506,12 @@ QVariant ModbusRegister::scaleValue(const QVariant& value, bool inverse) const
         case ModbusTypes::DataType::DINT:
             return static_cast<qint32>(qRound(numValue));
             
+        case ModbusTypes::DataType::LINT:
+            return static_cast<qint64>(qRound64(numValue));
+            
+        case ModbusTypes::DataType::ULINT:
+            return static_cast<quint64>(qRound64(numValue));
+            
         case ModbusTypes::DataType::REAL:
             return static_cast<float>(numValue);
             
@@ -798,6 +550,14 @@ QString ModbusRegister::formatValue(const QVariant& value) const
             result = QString::number(value.toInt());
             break;
             
+        case ModbusTypes::DataType::LINT:
+            result = QString::number(value.toLongLong());
+            break;
+            
+        case ModbusTypes::DataType::ULINT:
+            result = QString::number(value.toULongLong());
+            break;
+            
         case ModbusTypes::DataType::REAL:
             result = QString::number(value.toFloat(), 'f', 3);
             break;
@@ -813,10 +573,7 @@ QString ModbusRegister::formatValue(const QVariant& value) const
     }
     
     // Ölçeklenmiş değeri göster
-    if (config.scaleFactor != 1.0 &&
-        config.dataType != ModbusTypes::DataType::BIT &&
-        config.dataType != ModbusTypes::DataType::STRING &&
-        config.dataType != ModbusTypes::DataType::WSTRING) {
+    if (config.scaleFactor != 1.0 && codec->scaled) {
         
         result = QString::number(value.toDouble() * config.scaleFactor, 'f', 3);
     }
@@ -2,6 +2,7 @@
 #define MODBUS_REGISTER_H
 
 #include "ModbusTypes.h"
+#include "RegisterCodec.h"
 #include <QObject>
 #include <QVariant>
 #include <QDateTime>
@@ -27,10 +28,15 @@ public:
     QVariant getValue() const;
     bool setValue(const QVariant& value);
     QString getFormattedValue() const;
+    // Ham veri: Modbus word'leri, her word big-endian (kablodaki sırayla)
     QByteArray getRawData() const;
     bool setRawData(const QByteArray& data);
     bool validateValue(const QVariant& value) const;
     bool isValid() const { return valid; }
+
+    // Polling ile okunan word'lerin çözülmesi ve uygulanması
+    QVariant decodeRawWords(const quint16* words, int count) const;
+    bool updateFromPoll(const QVariant& value);
     void invalidate() {
         QMutexLocker locker(&mutex);
         valid = false;
@@ -92,6 +98,7 @@ protected:
 private:
     // Temel özellikler
     ModbusTypes::RegisterConfig config;
+    const RegisterCodec::Codec* codec;  // Tip ve byte sırasına göre seçilen codec
     QVariant value;
     bool valid;
     bool alarmState;
@@ -113,11 +120,6 @@ private:
     QVariant convertToDataType(const QVariant& value, ModbusTypes::DataType targetType) const;
     QVariant convertFromRawData(const QByteArray& data) const;
     QByteArray convertToRawData(const QVariant& value) const;
-    
-    // Byte sıralama işlemleri
-    template<typename T>
-    T reorderBytes(T value, ModbusTypes::ByteOrder order) const;
-    QByteArray applyByteOrder(const QByteArray& data) const;
 
 private:
     // Kopyalama engelleyiciler
@@ -0,0 +1,267 @@
+#include "RegisterCodec.h"
+#include <cstring>
+#include <type_traits>
+
+namespace RegisterCodec {
+
+namespace {
+
+using ModbusTypes::DataType;
+using ModbusTypes::ByteOrder;
+
+// Metin tiplerinde word sırası korunur, yalnızca byte swap uygulanır
+constexpr bool swapsWords(DataType type, ByteOrder order)
+{
+    return !isText(type) && (order == ByteOrder::CD_AB || order == ByteOrder::DC_BA);
+}
+
+constexpr bool swapsBytes(ByteOrder order)
+{
+    return order == ByteOrder::BA_DC || order == ByteOrder::DC_BA;
+}
+
+inline quint16 swap16(quint16 w)
+{
+    return static_cast<quint16>((w << 8) | (w >> 8));
+}
+
+// Tamsayı tipleri: S hedef C++ tipi, N word sayısı
+template<typename S, int N>
+struct IntTraits {
+    static const int words = N;
+    static const bool scaled = true;
+    static const bool text = false;
+
+    static double toNumber(quint64 bits) { return static_cast<double>(static_cast<S>(bits)); }
+    static QVariant toVariant(quint64 bits) { return QVariant(static_cast<S>(bits)); }
+    static bool encode(const QVariant& value, quint64& bits)
+    {
+        bool ok = false;
+        bits = std::is_signed<S>::value ? static_cast<quint64>(value.toLongLong(&ok))
+                                        : value.toULongLong(&ok);
+        bits &= (N * 16 >= 64) ? ~quint64(0) : ((quint64(1) << (N * 16)) - 1);
+        return ok;
+    }
+};
+
+template<DataType T> struct Traits;
+
+template<> struct Traits<DataType::BIT> {
+    static const int words = 1;
+    static const bool scaled = false;
+    static const bool text = false;
+
+    static double toNumber(quint64 bits) { return (bits & 0xFFFF) != 0 ? 1.0 : 0.0; }
+    static QVariant toVariant(quint64 bits) { return (bits & 0xFFFF) != 0; }
+    static bool encode(const QVariant& value, quint64& bits)
+    {
+        if (!value.canConvert<bool>()) return false;
+        bits = value.toBool() ? 1 : 0;
+        return true;
+    }
+};
+
+template<> struct Traits<DataType::BYTE> : IntTraits<quint8, 1> {
+    static double toNumber(quint64 bits) { return static_cast<double>(bits & 0xFF); }
+    static QVariant toVariant(quint64 bits) { return QVariant(static_cast<quint8>(bits & 0xFF)); }
+};
+
+template<> struct Traits<DataType::WORD> : IntTraits<quint16, 1> {};
+template<> struct Traits<DataType::INT> : IntTraits<qint16, 1> {};
+template<> struct Traits<DataType::DWORD> : IntTraits<quint32, 2> {};
+template<> struct Traits<DataType::DINT> : IntTraits<qint32, 2> {};
+template<> struct Traits<DataType::LINT> : IntTraits<qint64, 4> {};
+template<> struct Traits<DataType::ULINT> : IntTraits<quint64, 4> {};
+
+template<> struct Traits<DataType::REAL> {
+    static const int words = 2;
+    static const bool scaled = true;
+    static const bool text = false;
+
+    static float toFloat(quint64 bits)
+    {
+        quint32 raw = static_cast<quint32>(bits);
+        float value;
+        memcpy(&value, &raw, sizeof(float));
+        return value;
+    }
+    static double toNumber(quint64 bits) { return toFloat(bits); }
+    static QVariant toVariant(quint64 bits) { return toFloat(bits); }
+    static bool encode(const QVariant& value, quint64& bits)
+    {
+        bool ok = false;
+        float f = value.toFloat(&ok);
+        quint32 raw;
+        memcpy(&raw, &f, sizeof(float));
+        bits = raw;
+        return ok;
+    }
+};
+
+template<> struct Traits<DataType::LREAL> {
+    static const int words = 4;
+    static const bool scaled = true;
+    static const bool text = false;
+
+    static double toNumber(quint64 bits)
+    {
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        return value;
+    }
+    static QVariant toVariant(quint64 bits) { return toNumber(bits); }
+    static bool encode(const QVariant& value, quint64& bits)
+    {
+        bool ok = false;
+        double d = value.toDouble(&ok);
+        memcpy(&bits, &d, sizeof(double));
+        return ok;
+    }
+};
+
+// Metinler tabloda yalnızca yer tutar: uzunluk tag'e göre değiştiğinden
+// decodeText/encodeText ile ayrı yoldan çözülür
+struct TextTraits {
+    static const int words = 0;
+    static const bool scaled = false;
+    static const bool text = true;
+
+    static double toNumber(quint64) { return 0.0; }
+    static QVariant toVariant(quint64) { return QString(); }
+    static bool encode(const QVariant&, quint64& bits)
+    {
+        bits = 0;
+        return false;
+    }
+};
+
+template<> struct Traits<DataType::STRING> : TextTraits {};
+template<> struct Traits<DataType::WSTRING> : TextTraits {};
+
+template<DataType T, ByteOrder O>
+quint64 load(const quint16* words)
+{
+    const int n = Traits<T>::words;
+    quint64 bits = 0;
+    for (int i = 0; i < n; ++i) {
+        quint16 w = words[swapsWords(T, O) ? n - 1 - i : i];
+        bits = (bits << 16) | (swapsBytes(O) ? swap16(w) : w);
+    }
+    return bits;
+}
+
+template<DataType T, ByteOrder O>
+void store(quint64 bits, quint16* words)
+{
+    const int n = Traits<T>::words;
+    for (int i = 0; i < n; ++i) {
+        quint16 w = static_cast<quint16>(bits >> ((n - 1 - i) * 16));
+        words[swapsWords(T, O) ? n - 1 - i : i] = swapsBytes(O) ? swap16(w) : w;
+    }
+}
+
+template<DataType T, ByteOrder O>
+constexpr Codec makeCodec()
+{
+    return Codec{Traits<T>::words, Traits<T>::scaled, Traits<T>::text,
+                 &load<T, O>, &store<T, O>,
+                 &Traits<T>::toNumber, &Traits<T>::toVariant, &Traits<T>::encode};
+}
+
+#define CODEC_ROW(type) \
+    { makeCodec<type, ByteOrder::AB_CD>(), makeCodec<type, ByteOrder::CD_AB>(), \
+      makeCodec<type, ByteOrder::BA_DC>(), makeCodec<type, ByteOrder::DC_BA>() }
+
+// Satırlar DataType, sütunlar ByteOrder sırasını izler
+constexpr Codec codecTable[][4] = {
+    CODEC_ROW(DataType::BIT),
+    CODEC_ROW(DataType::BYTE),
+    CODEC_ROW(DataType::WORD),
+    CODEC_ROW(DataType::INT),
+    CODEC_ROW(DataType::DWORD),
+    CODEC_ROW(DataType::DINT),
+    CODEC_ROW(DataType::REAL),
+    CODEC_ROW(DataType::LREAL),
+    CODEC_ROW(DataType::STRING),
+    CODEC_ROW(DataType::WSTRING),
+    CODEC_ROW(DataType::LINT),
+    CODEC_ROW(DataType::ULINT)
+};
+
+#undef CODEC_ROW
+
+const int DATA_TYPE_COUNT = static_cast<int>(DataType::ULINT) + 1;
+const int BYTE_ORDER_COUNT = static_cast<int>(ByteOrder::DC_BA) + 1;
+
+static_assert(sizeof(codecTable) / sizeof(codecTable[0]) == DATA_TYPE_COUNT,
+              "codecTable must cover every DataType");
+
+} // namespace
+
+const Codec& codecFor(ModbusTypes::DataType type, ModbusTypes::ByteOrder order)
+{
+    int t = static_cast<int>(type);
+    int o = static_cast<int>(order);
+    if (t < 0 || t >= DATA_TYPE_COUNT) t = static_cast<int>(DataType::WORD);
+    if (o < 0 || o >= BYTE_ORDER_COUNT) o = static_cast<int>(ByteOrder::AB_CD);
+    return codecTable[t][o];
+}
+
+int textCapacity(ModbusTypes::DataType type, int count)
+{
+    if (count <= 0) return 0;
+    return type == DataType::STRING ? count * 2 : count;
+}
+
+QString decodeText(ModbusTypes::DataType type, ModbusTypes::ByteOrder order,
+                   const quint16* words, int count)
+{
+    QString text;
+    if (!isText(type) || count <= 0) {
+        return text;
+    }
+
+    text.reserve(textCapacity(type, count));
+    for (int i = 0; i < count; ++i) {
+        const quint16 w = swapsBytes(order) ? swap16(words[i]) : words[i];
+        if (type == DataType::WSTRING) {
+            if (w == 0) break;
+            text.append(QChar(w));
+            continue;
+        }
+        const char hi = static_cast<char>(w >> 8);
+        const char lo = static_cast<char>(w & 0xFF);
+        if (hi == '\0') break;
+        text.append(QLatin1Char(hi));
+        if (lo == '\0') break;
+        text.append(QLatin1Char(lo));
+    }
+    return text;
+}
+
+bool encodeText(ModbusTypes::DataType type, ModbusTypes::ByteOrder order,
+                const QString& text, quint16* words, int count)
+{
+    if (!isText(type) || count <= 0 || text.size() > textCapacity(type, count)) {
+        return false;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        quint16 w = 0;
+        if (type == DataType::WSTRING) {
+            if (i < text.size()) w = text.at(i).unicode();
+        } else {
+            for (int k = 0; k < 2; ++k) {
+                const int index = i * 2 + k;
+                if (index >= text.size()) break;
+                const ushort c = text.at(index).unicode();
+                if (c > 0xFF) return false;
+                w |= static_cast<quint16>(c << (k == 0 ? 8 : 0));
+            }
+        }
+        words[i] = swapsBytes(order) ? swap16(w) : w;
+    }
+    return true;
+}
+
+} // namespace RegisterCodec
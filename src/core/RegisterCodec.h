@@ -0,0 +1,53 @@
+#ifndef REGISTER_CODEC_H
+#define REGISTER_CODEC_H
+
+#include "ModbusTypes.h"
+#include <QVariant>
+
+// Her (DataType, ByteOrder) çifti için derleme zamanında üretilen codec'ler.
+// Register yapılandırılırken codec bir kez seçilir; değer başına switch yapılmaz.
+namespace RegisterCodec {
+
+typedef quint64 (*LoadFn)(const quint16* words);
+typedef void (*StoreFn)(quint64 bits, quint16* words);
+typedef double (*NumberFn)(quint64 bits);
+typedef QVariant (*VariantFn)(quint64 bits);
+typedef bool (*EncodeFn)(const QVariant& value, quint64& bits);
+
+struct Codec {
+    int wordCount;          // Modbus üzerinde kapladığı word sayısı (metinlerde 0)
+    bool scaled;            // Ölçekleme uygulanır mı (BIT ve metinlerde hayır)
+    bool text;              // STRING/WSTRING: decodeText/encodeText kullanılır
+    LoadFn load;            // Word'leri byte sırasına göre AB CD bitlerine birleştirir
+    StoreFn store;          // AB CD bitlerini byte sırasına göre word'lere yazar
+    NumberFn toNumber;      // Bitlerden sayısal değer (metinlerde 0)
+    VariantFn toVariant;    // Bitlerden QVariant
+    EncodeFn encode;        // QVariant'tan bitler; dönüşüm başarısızsa false
+};
+
+// Tip ve byte sırası için codec. Geçersiz değerlerde WORD / AB CD döner.
+const Codec& codecFor(ModbusTypes::DataType type, ModbusTypes::ByteOrder order);
+
+constexpr bool isText(ModbusTypes::DataType type)
+{
+    return type == ModbusTypes::DataType::STRING || type == ModbusTypes::DataType::WSTRING;
+}
+
+// Metin tipleri sabit genişlikli tabloda değildir; uzunluk yapılandırmadan
+// (RegisterConfig::stringLength) gelir. STRING word başına 2 Latin-1 karakter
+// taşır (ilki yüksek baytta), WSTRING word başına bir UTF-16 birimi.
+// Word sırası hiç değişmez, byte sırasının yalnızca byte swap kısmı uygulanır.
+
+// count word'e sığan en fazla karakter
+int textCapacity(ModbusTypes::DataType type, int count);
+// İlk NUL karakterde biter
+QString decodeText(ModbusTypes::DataType type, ModbusTypes::ByteOrder order,
+                   const quint16* words, int count);
+// Kalan word'ler 0 ile doldurulur. Metin sığmıyorsa ya da STRING için
+// Latin-1 dışı karakter içeriyorsa false döner.
+bool encodeText(ModbusTypes::DataType type, ModbusTypes::ByteOrder order,
+                const QString& text, quint16* words, int count);
+
+} // namespace RegisterCodec
+
+#endif // REGISTER_CODEC_H
@@ -0,0 +1,231 @@
+#include "RegisterDecoder.h"
+#include "RegisterCodec.h"
+#include <QVarLengthArray>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace RegisterDecoder {
+
+namespace {
+
+bool swapsWords(ModbusTypes::ByteOrder order)
+{
+    return order == ModbusTypes::ByteOrder::CD_AB || order == ModbusTypes::ByteOrder::DC_BA;
+}
+
+bool swapsBytes(ModbusTypes::ByteOrder order)
+{
+    return order == ModbusTypes::ByteOrder::BA_DC || order == ModbusTypes::ByteOrder::DC_BA;
+}
+
+// İki tag aynı vektör dizisine (run) girebilir mi?
+bool sameRun(const TagLayout& a, const TagLayout& b)
+{
+    return a.dataType == b.dataType && a.byteOrder == b.byteOrder &&
+           a.scale == b.scale && b.wordOffset == a.wordOffset + a.wordCount;
+}
+
+// 16-bit tamsayı dizisini double'a çevirip ölçekler
+void convertWords16(const quint16* src, int count, bool isSigned, double scale, double* out)
+{
+    int k = 0;
+#if defined(__AVX2__)
+    const __m256d s4 = _mm256_set1_pd(scale);
+#elif defined(__SSE2__)
+    const __m128d s = _mm_set1_pd(scale);
+#endif
+#if defined(__SSE2__)
+    for (; k + 8 <= count; k += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+        __m128i lo;
+        __m128i hi;
+        if (isSigned) {
+            lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        } else {
+            const __m128i zero = _mm_setzero_si128();
+            lo = _mm_unpacklo_epi16(v, zero);
+            hi = _mm_unpackhi_epi16(v, zero);
+        }
+#if defined(__AVX2__)
+        _mm256_storeu_pd(out + k, _mm256_mul_pd(_mm256_cvtepi32_pd(lo), s4));
+        _mm256_storeu_pd(out + k + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(hi), s4));
+#else
+        _mm_storeu_pd(out + k, _mm_mul_pd(_mm_cvtepi32_pd(lo), s));
+        _mm_storeu_pd(out + k + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2))), s));
+        _mm_storeu_pd(out + k + 4, _mm_mul_pd(_mm_cvtepi32_pd(hi), s));
+        _mm_storeu_pd(out + k + 6, _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2))), s));
+#endif
+    }
+#endif
+    for (; k < count; ++k) {
+        out[k] = (isSigned ? static_cast<double>(static_cast<qint16>(src[k]))
+                           : static_cast<double>(src[k])) * scale;
+    }
+}
+
+// Ardışık 32-bit tag'leri (word çiftleri) çözer. src byte swap'ı zaten
+// uygulanmış word dizisidir; burada yalnızca word sırası düzeltilir.
+void convertWords32(const quint16* src, int count, bool wordsSwapped,
+                    ModbusTypes::DataType type, double scale,
+                    quint64* rawOut, double* out)
+{
+    int k = 0;
+#if defined(__SSE2__)
+    const __m128d s = _mm_set1_pd(scale);
+    for (; k + 4 <= count; k += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * 2));
+        // Host little-endian: bellekteki [w0, w1] çifti AB CD için (w0 << 16) | w1 olmalı
+        if (!wordsSwapped) {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+
+        quint32 lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+        for (int j = 0; j < 4; ++j) {
+            rawOut[k + j] = lanes[j];
+        }
+
+        __m128d d0;
+        __m128d d1;
+        __m128i upper = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        if (type == ModbusTypes::DataType::REAL) {
+            d0 = _mm_cvtps_pd(_mm_castsi128_ps(v));
+            d1 = _mm_cvtps_pd(_mm_castsi128_ps(upper));
+        } else if (type == ModbusTypes::DataType::DINT) {
+            d0 = _mm_cvtepi32_pd(v);
+            d1 = _mm_cvtepi32_pd(upper);
+        } else {
+            // İşaretsiz: işaret bitini çevir, 2^31 ekle
+            const __m128i flip = _mm_set1_epi32(static_cast<int>(0x80000000u));
+            const __m128d bias = _mm_set1_pd(2147483648.0);
+            d0 = _mm_add_pd(_mm_cvtepi32_pd(_mm_xor_si128(v, flip)), bias);
+            d1 = _mm_add_pd(_mm_cvtepi32_pd(_mm_xor_si128(upper, flip)), bias);
+        }
+        _mm_storeu_pd(out + k, _mm_mul_pd(d0, s));
+        _mm_storeu_pd(out + k + 2, _mm_mul_pd(d1, s));
+    }
+#endif
+    const RegisterCodec::NumberFn toNumber =
+        RegisterCodec::codecFor(type, ModbusTypes::ByteOrder::AB_CD).toNumber;
+    for (; k < count; ++k) {
+        quint16 w0 = src[k * 2];
+        quint16 w1 = src[k * 2 + 1];
+        quint32 bits = wordsSwapped ? (static_cast<quint32>(w1) << 16) | w0
+                                    : (static_cast<quint32>(w0) << 16) | w1;
+        rawOut[k] = bits;
+        out[k] = toNumber(bits) * scale;
+    }
+}
+
+} // namespace
+
+void swapBytes(const quint16* src, quint16* dst, int count)
+{
+    int k = 0;
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                             1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; k + 16 <= count; k += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; k + 8 <= count; k += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(__SSE2__)
+    for (; k + 8 <= count; k += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                         _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#endif
+    for (; k < count; ++k) {
+        dst[k] = static_cast<quint16>((src[k] << 8) | (src[k] >> 8));
+    }
+}
+
+void decodeBlock(const quint16* block, int blockWords,
+                 const TagLayout* layouts, int count,
+                 quint64* rawOut, double* scaledOut)
+{
+    // Byte swap gereken tag varsa bloğun swap'lı kopyası bir kez üretilir
+    QVarLengthArray<quint16, 256> swapped;
+    for (int i = 0; i < count; ++i) {
+        if (swapsBytes(layouts[i].byteOrder)) {
+            swapped.resize(blockWords);
+            swapBytes(block, swapped.data(), blockWords);
+            break;
+        }
+    }
+
+    int i = 0;
+    while (i < count) {
+        const TagLayout& layout = layouts[i];
+        const quint16* source = swapsBytes(layout.byteOrder) ? swapped.constData() : block;
+
+        // Aynı tipte ardışık tag dizilerini vektör yolundan geçir
+        bool vector16 = layout.wordCount == 1 &&
+                        (layout.dataType == ModbusTypes::DataType::WORD ||
+                         layout.dataType == ModbusTypes::DataType::INT);
+        bool vector32 = layout.wordCount == 2 &&
+                        (layout.dataType == ModbusTypes::DataType::DWORD ||
+                         layout.dataType == ModbusTypes::DataType::DINT ||
+                         layout.dataType == ModbusTypes::DataType::REAL);
+        int run = 1;
+        if (vector16 || vector32) {
+            while (i + run < count && sameRun(layouts[i + run - 1], layouts[i + run])) {
+                ++run;
+            }
+        }
+        bool inBlock = layout.wordOffset + run * layout.wordCount <= blockWords;
+
+        if (vector16 && run >= 4 && inBlock) {
+            const quint16* src = source + layout.wordOffset;
+            convertWords16(src, run, layout.dataType == ModbusTypes::DataType::INT,
+                           layout.scale, scaledOut + i);
+            for (int k = 0; k < run; ++k) {
+                rawOut[i + k] = src[k];
+            }
+            i += run;
+            continue;
+        }
+
+        if (vector32 && run >= 4 && inBlock) {
+            convertWords32(source + layout.wordOffset, run, swapsWords(layout.byteOrder),
+                           layout.dataType, layout.scale, rawOut + i, scaledOut + i);
+            i += run;
+            continue;
+        }
+
+        // Skaler yol: blok dışı word'ler 0 kabul edilir
+        quint16 words[4] = {0, 0, 0, 0};
+        int n = qMin<int>(layout.wordCount, 4);
+        for (int k = 0; k < n; ++k) {
+            int index = layout.wordOffset + k;
+            words[k] = index < blockWords ? block[index] : 0;
+        }
+
+        const RegisterCodec::Codec& codec = RegisterCodec::codecFor(layout.dataType, layout.byteOrder);
+        rawOut[i] = codec.load(words);
+        double number = codec.toNumber(rawOut[i]);
+        scaledOut[i] = codec.scaled ? number * layout.scale : number;
+        ++i;
+    }
+}
+
+} // namespace RegisterDecoder
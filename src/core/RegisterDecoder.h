@@ -0,0 +1,38 @@
+#ifndef REGISTER_DECODER_H
+#define REGISTER_DECODER_H
+
+#include "ModbusTypes.h"
+#include <QVariant>
+
+// Okunan bir register bloğunu tek geçişte çözen toplu decoder.
+// Byte swap ve int->double ölçekleme mümkün olduğunda SIMD ile yapılır
+// (SSE2 temel, derleyici izin verirse AVX2).
+namespace RegisterDecoder {
+
+// Blok içindeki tek bir tag'in yerleşimi
+struct TagLayout {
+    quint16 wordOffset;             // Blok başından itibaren ilk word
+    quint8 wordCount;               // Kapladığı word sayısı
+    ModbusTypes::DataType dataType;
+    ModbusTypes::ByteOrder byteOrder;
+    double scale;                   // Ölçekleme faktörü
+
+    TagLayout() : wordOffset(0), wordCount(1),
+                  dataType(ModbusTypes::DataType::WORD),
+                  byteOrder(ModbusTypes::ByteOrder::AB_CD),
+                  scale(1.0) {}
+};
+
+// 16-bit word dizisinde byte swap (SIMD)
+void swapBytes(const quint16* src, quint16* dst, int count);
+
+// Bloğu çözer. rawOut: AB CD düzeninde bitler (RegisterCodec ile çevrilir),
+// scaledOut: ölçeklenmiş değer.
+// Blok dışına taşan word'ler 0 kabul edilir.
+void decodeBlock(const quint16* block, int blockWords,
+                 const TagLayout* layouts, int count,
+                 quint64* rawOut, double* scaledOut);
+
+} // namespace RegisterDecoder
+
+#endif // REGISTER_DECODER_H
@@ -0,0 +1,221 @@
+#include "SharedTagTable.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <atomic>
+#include <cstring>
+
+static_assert(sizeof(qmodbus_shm_header) == 128, "qmodbus_shm_header layout changed");
+static_assert(sizeof(qmodbus_shm_slot) == 64, "qmodbus_shm_slot layout changed");
+static_assert(sizeof(std::atomic<quint32>) == sizeof(quint32), "std::atomic<quint32> must be lock-free");
+static_assert(sizeof(std::atomic<qint64>) == sizeof(qint64), "std::atomic<qint64> must be lock-free");
+
+namespace {
+
+// Segmentteki alanlar C okuyucuyla paylaşılır; yazıcı onlara atomik olarak erişir
+template<typename T>
+std::atomic<T>& atomicField(T& field)
+{
+    return *reinterpret_cast<std::atomic<T>*>(&field);
+}
+
+void beginWrite(quint32& field)
+{
+    std::atomic<quint32>& seq = atomicField(field);
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void endWrite(quint32& field)
+{
+    std::atomic<quint32>& seq = atomicField(field);
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+} // namespace
+
+SharedTagTable::SharedTagTable(const QString& deviceName)
+    : deviceName(deviceName)
+    , file(segmentPath(deviceName))
+    , header(nullptr)
+    , slotArray(nullptr)
+    , capacity(0)
+    , tagCount(0)
+{
+}
+
+SharedTagTable::~SharedTagTable()
+{
+    close();
+}
+
+// qmodbus_shm_path() ile aynı kural; iki taraf da aynı yolu üretmeli
+QString SharedTagTable::segmentPath(const QString& deviceName)
+{
+    QByteArray name = deviceName.toUtf8().left(QMODBUS_SHM_DEVICE_SIZE - 1);
+    if (name.isEmpty()) {
+        name = "default";
+    }
+    for (char& c : name) {
+        const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                          (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+        if (!safe) {
+            c = '_';
+        }
+    }
+
+#ifdef Q_OS_LINUX
+    return "/dev/shm/qmodbus-" + QString::fromLatin1(name);
+#else
+    return QDir::tempPath() + "/qmodbus-" + QString::fromLatin1(name) + ".shm";
+#endif
+}
+
+bool SharedTagTable::open(int slotCount)
+{
+    close();
+
+    // Çökmüş bir yazıcıdan kalan segment; açık okuyucular eski kopyayı görür
+    QFile::remove(file.fileName());
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        lastError = QString("Cannot create shared segment %1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+    if (!map(qMax(1, slotCount))) {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    memset(header, 0, sizeof(qmodbus_shm_header));
+    header->version = QMODBUS_SHM_VERSION;
+    header->header_size = sizeof(qmodbus_shm_header);
+    header->slot_size = sizeof(qmodbus_shm_slot);
+    header->capacity = static_cast<quint32>(capacity);
+    header->writer_pid = static_cast<quint64>(QCoreApplication::applicationPid());
+    const QByteArray name = deviceName.toUtf8().left(QMODBUS_SHM_DEVICE_SIZE - 1);
+    memcpy(header->device, name.constData(), name.size());
+
+    // Okuyucu sihirli sayıyı görünce başlık tamamdır
+    atomicField(header->magic).store(QMODBUS_SHM_MAGIC, std::memory_order_release);
+    tagCount = 0;
+    return true;
+}
+
+void SharedTagTable::close()
+{
+    if (!header) {
+        return;
+    }
+    file.unmap(reinterpret_cast<uchar*>(header));
+    header = nullptr;
+    slotArray = nullptr;
+    capacity = 0;
+    tagCount = 0;
+    file.close();
+    file.remove();
+}
+
+bool SharedTagTable::map(int slotCount)
+{
+    const qint64 size = sizeof(qmodbus_shm_header) + qint64(slotCount) * sizeof(qmodbus_shm_slot);
+    if (!file.resize(size)) {
+        lastError = QString("Cannot resize shared segment %1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+    uchar* data = file.map(0, size);
+    if (!data) {
+        lastError = QString("Cannot map shared segment %1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+
+    header = reinterpret_cast<qmodbus_shm_header*>(data);
+    slotArray = reinterpret_cast<qmodbus_shm_slot*>(data + sizeof(qmodbus_shm_header));
+    capacity = slotCount;
+    return true;
+}
+
+// Segment yalnızca büyür; okuyucular capacity artınca yeniden eşler.
+// Windows'ta başka süreç eşlemişken dosya büyütülemez: açılışta yeterli
+// kapasite ayrılmalı.
+bool SharedTagTable::grow(int required)
+{
+    int slotCount = capacity;
+    while (slotCount < required) {
+        slotCount *= 2;
+    }
+
+    const int previous = capacity;
+    file.unmap(reinterpret_cast<uchar*>(header));
+    header = nullptr;
+    slotArray = nullptr;
+    if (!map(slotCount) && !map(previous)) {
+        capacity = 0;
+        return false;
+    }
+    atomicField(header->capacity).store(static_cast<quint32>(capacity), std::memory_order_release);
+    return capacity >= required;
+}
+
+bool SharedTagTable::setLayout(const TagTable& table)
+{
+    if (!header) {
+        return false;
+    }
+
+    const int size = table.size();
+    bool ok = true;
+    if (size > capacity) {
+        ok = grow(size);
+        if (!header) {
+            return false;
+        }
+    }
+
+    beginWrite(header->layout_seq);
+    tagCount = qMin(size, capacity);
+    TagTable::Sample sample;
+    for (int id = 0; id < tagCount; ++id) {
+        table.read(id, sample);
+        writeSlot(id, sample);
+    }
+    atomicField(header->tag_count).store(static_cast<quint32>(tagCount), std::memory_order_release);
+    endWrite(header->layout_seq);
+
+    if (!ok) {
+        lastError = QString("Shared segment %1 holds %2 of %3 tags").arg(file.fileName()).arg(tagCount).arg(size);
+    }
+    return ok;
+}
+
+void SharedTagTable::update(const TagTable& table, const QBitArray& changed)
+{
+    if (!header) {
+        return;
+    }
+
+    const int count = qMin(tagCount, changed.size());
+    TagTable::Sample sample;
+    for (int id = 0; id < count; ++id) {
+        if (changed.testBit(id) && table.read(id, sample)) {
+            writeSlot(id, sample);
+        }
+    }
+
+    atomicField(header->update_count).fetch_add(1, std::memory_order_relaxed);
+    atomicField(header->heartbeat).store(QDateTime::currentMSecsSinceEpoch(), std::memory_order_release);
+}
+
+void SharedTagTable::writeSlot(int id, const TagTable::Sample& sample)
+{
+    qmodbus_shm_slot& slot = slotArray[id];
+    beginWrite(slot.seq);
+    slot.address = static_cast<quint16>(sample.address);
+    slot.word_count = sample.wordCount;
+    slot.quality = sample.quality;
+    slot.alarm_flags = sample.alarmFlags;
+    slot.timestamp = sample.timestamp;
+    slot.value = sample.scaled;
+    memcpy(slot.words, sample.words, sizeof(slot.words));
+    endWrite(slot.seq);
+}
@@ -0,0 +1,52 @@
+#ifndef SHARED_TAG_TABLE_H
+#define SHARED_TAG_TABLE_H
+
+#include "TagTable.h"
+#include "qmodbus_shm.h"
+#include <QString>
+#include <QFile>
+#include <QBitArray>
+
+// Bir cihazın tag tablosunu diğer süreçlere açan paylaşımlı bellek segmenti
+// (yazıcı tarafı). Yerleşim qmodbus_shm.h'dedir; okuyucular Qt'siz C
+// kütüphanesiyle bağlanır. Her slot kendi seqlock sayacını taşır:
+// okuyucu kilit almaz, yazıcı hiçbir zaman okuyucuyu beklemez.
+// Segment, QSharedMemory yerine /dev/shm (ya da geçici dizin) altında
+// eşlenmiş bir dosyadır; böylece isim Qt'nin anahtar dönüşümüne bağlı kalmaz.
+class SharedTagTable {
+public:
+    explicit SharedTagTable(const QString& deviceName);
+    ~SharedTagTable();
+
+    static QString segmentPath(const QString& deviceName);
+
+    // Var olan (eski) segmenti siler ve yenisini oluşturur
+    bool open(int capacity = 256);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    QString getPath() const { return file.fileName(); }
+    QString getLastError() const { return lastError; }
+
+    // Tag listesi değişince (yazıcı thread'i); tüm slotlar yeniden yazılır
+    bool setLayout(const TagTable& table);
+    // Poll döngüsü sonunda: yalnızca değişen id'ler kopyalanır, heartbeat ilerler
+    void update(const TagTable& table, const QBitArray& changed);
+
+private:
+    QString deviceName;
+    QFile file;
+    qmodbus_shm_header* header;
+    qmodbus_shm_slot* slotArray;
+    int capacity;
+    int tagCount;
+    QString lastError;
+
+    bool map(int slotCount);
+    bool grow(int required);
+    void writeSlot(int id, const TagTable::Sample& sample);
+
+    SharedTagTable(const SharedTagTable&) = delete;
+    SharedTagTable& operator=(const SharedTagTable&) = delete;
+};
+
+#endif // SHARED_TAG_TABLE_H
@@ -0,0 +1,202 @@
+#include "TagTable.h"
+#include <cstring>
+
+namespace {
+
+// Yazıcının sütunlarıyla bellek paylaşmayan kopya: paylaşımlı (COW) kopya
+// yazıcıyı bir sonraki store'da sütunu ayırmaya zorlardı.
+template<typename T>
+QVector<T> deepCopy(const QVector<T>& source)
+{
+    QVector<T> copy(source.size());
+    if (!source.isEmpty()) {
+        memcpy(copy.data(), source.constData(), source.size() * sizeof(T));
+    }
+    return copy;
+}
+
+} // namespace
+
+TagTable::TagTable()
+    : dirtyColumns(0)
+    , published(std::make_shared<const Snapshot>())
+    , publishedVersion(0)
+{
+}
+
+int TagTable::addTag(int address, int wordCount)
+{
+    if (addressIds.contains(address)) {
+        return addressIds.value(address);
+    }
+
+    if (wordCount < 1) wordCount = 1;
+    if (wordCount > MAX_WORDS) wordCount = MAX_WORDS;
+
+    int id = addresses.size();
+    addresses.append(static_cast<quint16>(address));
+    wordCounts.append(static_cast<quint8>(wordCount));
+    for (int i = 0; i < MAX_WORDS; ++i) {
+        rawWords.append(0);
+    }
+    scaledValues.append(0.0);
+    timestamps.append(0);
+    qualities.append(QUALITY_UNCERTAIN);
+    alarmFlags.append(ALARM_NONE);
+    texts.append(QString());
+    addressIds.insert(address, id);
+    dirtyColumns = DIRTY_ALL;
+
+    return id;
+}
+
+bool TagTable::removeTag(int address)
+{
+    int id = idForAddress(address);
+    if (id < 0) {
+        return false;
+    }
+
+    // Son elemanı silinen yere taşı, id'ler yoğun kalsın
+    int last = addresses.size() - 1;
+    if (id != last) {
+        addresses[id] = addresses[last];
+        wordCounts[id] = wordCounts[last];
+        memcpy(rawWords.data() + id * MAX_WORDS,
+               rawWords.constData() + last * MAX_WORDS,
+               MAX_WORDS * sizeof(quint16));
+        scaledValues[id] = scaledValues[last];
+        timestamps[id] = timestamps[last];
+        qualities[id] = qualities[last];
+        alarmFlags[id] = alarmFlags[last];
+        texts[id] = texts[last];
+        addressIds[addresses[id]] = id;
+    }
+
+    addresses.removeLast();
+    wordCounts.removeLast();
+    rawWords.resize(last * MAX_WORDS);
+    scaledValues.removeLast();
+    timestamps.removeLast();
+    qualities.removeLast();
+    alarmFlags.removeLast();
+    texts.removeLast();
+    addressIds.remove(address);
+    dirtyColumns = DIRTY_ALL;
+
+    return true;
+}
+
+void TagTable::clear()
+{
+    addresses.clear();
+    wordCounts.clear();
+    rawWords.clear();
+    scaledValues.clear();
+    timestamps.clear();
+    qualities.clear();
+    alarmFlags.clear();
+    texts.clear();
+    addressIds.clear();
+    dirtyColumns = DIRTY_ALL;
+}
+
+void TagTable::reserve(int count)
+{
+    addresses.reserve(count);
+    wordCounts.reserve(count);
+    rawWords.reserve(count * MAX_WORDS);
+    scaledValues.reserve(count);
+    timestamps.reserve(count);
+    qualities.reserve(count);
+    alarmFlags.reserve(count);
+    texts.reserve(count);
+    addressIds.reserve(count);
+}
+
+void TagTable::store(int id, const quint16* words, double scaled, qint64 timestamp, quint8 flags)
+{
+    memcpy(rawWords.data() + id * MAX_WORDS, words, wordCounts[id] * sizeof(quint16));
+    scaledValues[id] = scaled;
+    timestamps[id] = timestamp;
+    qualities[id] = QUALITY_GOOD;
+    alarmFlags[id] = flags;
+    dirtyColumns |= DIRTY_WORDS | DIRTY_SCALED | DIRTY_TIMESTAMPS | DIRTY_QUALITIES | DIRTY_ALARMS;
+}
+
+void TagTable::markBad(int id, qint64 timestamp)
+{
+    timestamps[id] = timestamp;
+    qualities[id] = QUALITY_BAD;
+    dirtyColumns |= DIRTY_TIMESTAMPS | DIRTY_QUALITIES;
+}
+
+void TagTable::setText(int id, const QString& text)
+{
+    texts[id] = text;
+    dirtyColumns |= DIRTY_TEXTS;
+}
+
+void TagTable::publish()
+{
+    if (!dirtyColumns) {
+        return;
+    }
+
+    // Değişmeyen sütunlar önceki kopyayla paylaşılır; önceki kopyanın
+    // sütunları yazıcınınkilerden bağımsız olduğundan bu güvenlidir.
+    auto next = std::make_shared<Snapshot>(*snapshot());
+    next->version = ++publishedVersion;
+    if (dirtyColumns & DIRTY_LAYOUT) {
+        next->addresses = deepCopy(addresses);
+        next->wordCounts = deepCopy(wordCounts);
+        next->addressIds = addressIds;  // Yalnızca yapısal işlemlerde değişir
+    }
+    if (dirtyColumns & DIRTY_WORDS) next->rawWords = deepCopy(rawWords);
+    if (dirtyColumns & DIRTY_SCALED) next->scaledValues = deepCopy(scaledValues);
+    if (dirtyColumns & DIRTY_TIMESTAMPS) next->timestamps = deepCopy(timestamps);
+    if (dirtyColumns & DIRTY_QUALITIES) next->qualities = deepCopy(qualities);
+    if (dirtyColumns & DIRTY_ALARMS) next->alarmFlags = deepCopy(alarmFlags);
+    if (dirtyColumns & DIRTY_TEXTS) next->texts = texts;   // QString'ler zaten paylaşımlı
+    dirtyColumns = 0;
+
+    std::atomic_store(&published, std::shared_ptr<const Snapshot>(std::move(next)));
+}
+
+std::shared_ptr<const TagTable::Snapshot> TagTable::snapshot() const
+{
+    return std::atomic_load(&published);
+}
+
+bool TagTable::Snapshot::read(int id, Sample& out) const
+{
+    if (id < 0 || id >= addresses.size()) {
+        return false;
+    }
+
+    out.address = addresses[id];
+    out.wordCount = wordCounts[id];
+    memcpy(out.words, rawWords.constData() + id * MAX_WORDS, MAX_WORDS * sizeof(quint16));
+    out.scaled = scaledValues[id];
+    out.timestamp = timestamps[id];
+    out.quality = qualities[id];
+    out.alarmFlags = alarmFlags[id];
+    return true;
+}
+
+bool TagTable::read(int id, Sample& out) const
+{
+    if (id < 0 || id >= addresses.size()) {
+        return false;
+    }
+
+    // Sahibi olan thread okuduğundan yazma ile yarışmaz
+    out.address = addresses[id];
+    out.wordCount = wordCounts[id];
+    memcpy(out.words, rawWords.constData() + id * MAX_WORDS, MAX_WORDS * sizeof(quint16));
+    out.scaled = scaledValues[id];
+    out.timestamp = timestamps[id];
+    out.quality = qualities[id];
+    out.alarmFlags = alarmFlags[id];
+    return true;
+}
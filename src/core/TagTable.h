@@ -0,0 +1,136 @@
+#ifndef TAG_TABLE_H
+#define TAG_TABLE_H
+
+#include "ModbusTypes.h"
+#include <QVector>
+#include <QString>
+#include <QHash>
+#include <memory>
+
+// Bir cihazın tüm tag değerlerini yoğun (dense) id ile tutan
+// struct-of-arrays tablo. Sütunlara yalnızca tablonun sahibi olan thread
+// (poller) dokunur; addTag/removeTag sütunları yeniden ayırabildiğinden
+// başka thread'lerin sütunları doğrudan okuması güvenli değildir.
+// Diğer thread'ler için yazıcı, poll döngüsü ve yapısal değişiklikler
+// sonunda değişmez bir kopya (Snapshot) yayınlar; görünümler bu kopyayı
+// tuttukları sürece yazıcıyla hiç yarışmadan okur. Yayında yalnızca son
+// yayından beri değişen sütunlar kopyalanır, diğerleri önceki kopyayla
+// paylaşılır.
+class TagTable {
+public:
+    // Tek tag için tabloda tutulan en fazla word sayısı (LREAL = 4 word).
+    // Daha uzun metinlerin ilk word'leri tutulur; metnin tamamı texts sütunundadır.
+    static const int MAX_WORDS = 4;
+
+    enum Quality : quint8 {
+        QUALITY_UNCERTAIN = 0,  // Henüz okunmadı
+        QUALITY_GOOD = 1,       // Son okuma başarılı
+        QUALITY_BAD = 2         // Son okuma başarısız
+    };
+
+    enum AlarmFlag : quint8 {
+        ALARM_NONE = 0x00,
+        ALARM_LOW = 0x01,
+        ALARM_HIGH = 0x02
+    };
+
+    // Okuyucuya verilen tutarlı kopya
+    struct Sample {
+        int address;
+        quint16 words[MAX_WORDS];
+        quint8 wordCount;
+        double scaled;
+        qint64 timestamp;       // ms (epoch)
+        quint8 quality;
+        quint8 alarmFlags;
+
+        Sample() : address(0), words{0, 0, 0, 0}, wordCount(0), scaled(0.0),
+                   timestamp(0), quality(QUALITY_UNCERTAIN), alarmFlags(ALARM_NONE) {}
+    };
+
+    // Sürümlü, değişmez kopya (RCU). Yayınlandıktan sonra hiç değiştirilmez.
+    struct Snapshot {
+        quint64 version;
+        QVector<quint16> addresses;
+        QVector<quint8> wordCounts;
+        QVector<quint16> rawWords;
+        QVector<double> scaledValues;
+        QVector<qint64> timestamps;
+        QVector<quint8> qualities;
+        QVector<quint8> alarmFlags;
+        QVector<QString> texts;
+        QHash<int, int> addressIds;
+
+        Snapshot() : version(0) {}
+        int size() const { return addresses.size(); }
+        int idForAddress(int address) const { return addressIds.value(address, -1); }
+        bool read(int id, Sample& out) const;
+        // STRING/WSTRING tag'lerinin tam metni (Sample yalnızca ilk word'leri taşır)
+        QString text(int id) const { return (id >= 0 && id < texts.size()) ? texts[id] : QString(); }
+    };
+
+    TagTable();
+
+    // Yapısal işlemler (yalnızca sahibi olan thread'den çağrılır)
+    int addTag(int address, int wordCount);
+    bool removeTag(int address);
+    void clear();
+    void reserve(int count);
+    int size() const { return addresses.size(); }
+    int idForAddress(int address) const { return addressIds.value(address, -1); }
+    int addressForId(int id) const { return addresses[id]; }
+    int wordCount(int id) const { return wordCounts[id]; }
+
+    // Yazıcı tarafı; değişiklikler publish() ile görünür olur
+    void store(int id, const quint16* words, double scaled, qint64 timestamp, quint8 alarmFlags);
+    void markBad(int id, qint64 timestamp);
+    // Metin sütunu Sample'a girmez; yalnızca Snapshot::text ile okunur
+    void setText(int id, const QString& text);
+
+    // Güncel durumu yeni bir Snapshot olarak atomik yayınlar (yazıcı thread'i).
+    // Son yayından beri değişiklik yoksa bir şey yapmaz.
+    void publish();
+
+    // Yalnızca sahibi olan thread'den; diğer thread'ler snapshot() kullanır
+    bool read(int id, Sample& out) const;
+
+    // Herhangi bir thread'den (kilitsiz)
+    // Son yayınlanan kopya; hiç yayın yapılmadıysa boş bir kopya döner
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+private:
+    // Son yayından beri değişen sütun grupları
+    enum DirtyColumn : quint8 {
+        DIRTY_LAYOUT = 0x01,        // addresses, wordCounts, addressIds
+        DIRTY_WORDS = 0x02,
+        DIRTY_SCALED = 0x04,
+        DIRTY_TIMESTAMPS = 0x08,
+        DIRTY_QUALITIES = 0x10,
+        DIRTY_ALARMS = 0x20,
+        DIRTY_TEXTS = 0x40,
+        DIRTY_ALL = 0x7F
+    };
+
+    // Sütunlar (id ile indekslenir)
+    QVector<quint16> addresses;
+    QVector<quint8> wordCounts;
+    QVector<quint16> rawWords;      // id * MAX_WORDS adımlı
+    QVector<double> scaledValues;
+    QVector<qint64> timestamps;
+    QVector<quint8> qualities;
+    QVector<quint8> alarmFlags;
+    QVector<QString> texts;         // Metin tag'lerinin çözülmüş değeri
+
+    QHash<int, int> addressIds;
+
+    quint8 dirtyColumns;
+
+    // Yalnızca std::atomic_load / std::atomic_store ile erişilir
+    std::shared_ptr<const Snapshot> published;
+    quint64 publishedVersion;
+
+    TagTable(const TagTable&) = delete;
+    TagTable& operator=(const TagTable&) = delete;
+};
+
+#endif // TAG_TABLE_H
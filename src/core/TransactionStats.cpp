@@ -0,0 +1,167 @@
+#include "TransactionStats.h"
+#include <modbus.h>
+#include <errno.h>
+
+TransactionStats::Series::Series(quint8 functionCode, quint8 slaveId)
+    : functionCode(functionCode)
+    , slaveId(slaveId)
+    , requests(0)
+    , failures(0)
+    , timeouts(0)
+{
+    for (std::atomic<quint64>& counter : exceptions) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+TransactionStats::TransactionStats()
+    : count(0)
+    , reconnects(0)
+    , queueDepth(0)
+    , connected(false)
+{
+    for (std::atomic<Series*>& entry : entries) {
+        entry.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+TransactionStats::~TransactionStats()
+{
+    for (std::atomic<Series*>& entry : entries) {
+        delete entry.load(std::memory_order_relaxed);
+    }
+}
+
+TransactionStats::Series* TransactionStats::find(quint8 functionCode, quint8 slaveId) const
+{
+    const int n = count.load(std::memory_order_acquire);
+    for (int index = 0; index < n; ++index) {
+        Series* series = entries[index].load(std::memory_order_acquire);
+        if (series->functionCode == functionCode && series->slaveId == slaveId) {
+            return series;
+        }
+    }
+    return nullptr;
+}
+
+TransactionStats::Series* TransactionStats::obtain(quint8 functionCode, int slaveId)
+{
+    const quint8 slave = static_cast<quint8>(slaveId);
+    Series* series = find(functionCode, slave);
+    if (series) {
+        return series;
+    }
+
+    QMutexLocker locker(&mutex);
+    series = find(functionCode, slave);
+    if (!series) {
+        const int n = count.load(std::memory_order_relaxed);
+        if (n >= MAX_SERIES) {
+            return nullptr;
+        }
+        series = new Series(functionCode, slave);
+        entries[n].store(series, std::memory_order_release);
+        count.store(n + 1, std::memory_order_release);
+    }
+    return series;
+}
+
+void TransactionStats::record(quint8 functionCode, int slaveId, Phase phase, quint64 micros)
+{
+    if (Series* series = obtain(functionCode, slaveId)) {
+        series->phases[phase].record(micros);
+    }
+}
+
+void TransactionStats::recordResult(quint8 functionCode, int slaveId, bool success, int errorCode)
+{
+    Series* series = obtain(functionCode, slaveId);
+    if (!series) {
+        return;
+    }
+
+    series->requests.fetch_add(1, std::memory_order_relaxed);
+    if (success) {
+        return;
+    }
+    series->failures.fetch_add(1, std::memory_order_relaxed);
+
+    const int exception = errorCode - MODBUS_ENOBASE;
+    if (exception > 0 && exception < EXCEPTION_CODE_COUNT) {
+        series->exceptions[exception].fetch_add(1, std::memory_order_relaxed);
+    } else if (errorCode == ETIMEDOUT) {
+        series->timeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::Snapshot TransactionStats::aggregate(Phase phase) const
+{
+    LatencyHistogram::Snapshot result;
+    const int n = seriesCount();
+    for (int index = 0; index < n; ++index) {
+        result.merge(series(index)->phases[phase].snapshot());
+    }
+    return result;
+}
+
+double TransactionStats::averageMillis(Phase phase) const
+{
+    // Yalnızca sayaçlar; kovalar dolaşılmaz
+    quint64 total = 0;
+    quint64 samples = 0;
+    const int n = seriesCount();
+    for (int index = 0; index < n; ++index) {
+        const LatencyHistogram& histogram = series(index)->phases[phase];
+        total += histogram.getSum();
+        samples += histogram.getCount();
+    }
+    return samples > 0 ? static_cast<double>(total) / samples / 1000.0 : 0.0;
+}
+
+void TransactionStats::reset()
+{
+    const int n = seriesCount();
+    for (int index = 0; index < n; ++index) {
+        Series* entry = entries[index].load(std::memory_order_acquire);
+        entry->requests.store(0, std::memory_order_relaxed);
+        entry->failures.store(0, std::memory_order_relaxed);
+        entry->timeouts.store(0, std::memory_order_relaxed);
+        for (std::atomic<quint64>& counter : entry->exceptions) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (LatencyHistogram& histogram : entry->phases) {
+            histogram.reset();
+        }
+    }
+}
+
+quint8 TransactionStats::functionCodeFor(ModbusTypes::RegisterType type, bool isWrite, int quantity)
+{
+    switch (type) {
+        case ModbusTypes::RegisterType::COIL:
+            if (isWrite) {
+                return quantity == 1 ? 0x05 : 0x0F;
+            }
+            return 0x01;
+        case ModbusTypes::RegisterType::DISCRETE_INPUT:
+            return 0x02;
+        case ModbusTypes::RegisterType::HOLDING_REGISTER:
+            if (isWrite) {
+                return quantity == 1 ? 0x06 : 0x10;
+            }
+            return 0x03;
+        case ModbusTypes::RegisterType::INPUT_REGISTER:
+            return 0x04;
+    }
+    return 0;
+}
+
+const char* TransactionStats::phaseName(Phase phase)
+{
+    switch (phase) {
+        case QUEUE_WAIT: return "queue_wait";
+        case WIRE:       return "wire";
+        case DECODE:     return "decode";
+        default:         return "unknown";
+    }
+}
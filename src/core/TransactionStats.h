@@ -0,0 +1,81 @@
+#ifndef TRANSACTION_STATS_H
+#define TRANSACTION_STATS_H
+
+#include "ModbusTypes.h"
+#include "LatencyHistogram.h"
+#include <QMutex>
+#include <atomic>
+
+// Bağlantı (cihaz) başına işlem istatistikleri. Fonksiyon kodu + slave id
+// ikilisi başına bir seri; her seride sayaçlar ve evre başına histogram:
+//   QUEUE_WAIT: isteğin kuyrukta / poll döngüsünde sıra beklemesi
+//   WIRE:       libmodbus çağrısı (gönderme + yanıt)
+//   DECODE:     yanıtın çözülüp tag'lere işlenmesi
+// Süreler monoton saatle (QElapsedTimer) ölçülür. Tüm alanlar atomiktir;
+// seriler yalnızca eklenir, silinmez; okuyucular (exporter, UI) kilitsiz dolaşır.
+class TransactionStats {
+public:
+    enum Phase {
+        QUEUE_WAIT,
+        WIRE,
+        DECODE,
+        PHASE_COUNT
+    };
+
+    static const int MAX_SERIES = 64;
+    static const int EXCEPTION_CODE_COUNT = 12;     // Modbus istisna kodları 1-11
+
+    struct Series {
+        Series(quint8 functionCode, quint8 slaveId);
+
+        const quint8 functionCode;
+        const quint8 slaveId;
+        std::atomic<quint64> requests;
+        std::atomic<quint64> failures;
+        std::atomic<quint64> timeouts;
+        std::atomic<quint64> exceptions[EXCEPTION_CODE_COUNT];
+        LatencyHistogram phases[PHASE_COUNT];
+    };
+
+    TransactionStats();
+    ~TransactionStats();
+
+    void record(quint8 functionCode, int slaveId, Phase phase, quint64 micros);
+    // errorCode: başarısız isteğin errno değeri (libmodbus istisnaları dahil)
+    void recordResult(quint8 functionCode, int slaveId, bool success, int errorCode);
+
+    // Bağlantı düzeyi
+    void recordReconnect() { reconnects.fetch_add(1, std::memory_order_relaxed); }
+    void setQueueDepth(int depth) { queueDepth.store(depth, std::memory_order_relaxed); }
+    void setConnected(bool value) { connected.store(value, std::memory_order_relaxed); }
+    quint64 getReconnects() const { return reconnects.load(std::memory_order_relaxed); }
+    int getQueueDepth() const { return queueDepth.load(std::memory_order_relaxed); }
+    bool isConnected() const { return connected.load(std::memory_order_relaxed); }
+
+    int seriesCount() const { return count.load(std::memory_order_acquire); }
+    const Series* series(int index) const { return entries[index].load(std::memory_order_acquire); }
+
+    // Tüm serilerin birleşimi
+    LatencyHistogram::Snapshot aggregate(Phase phase) const;
+    double averageMillis(Phase phase) const;
+    void reset();
+
+    static quint8 functionCodeFor(ModbusTypes::RegisterType type, bool isWrite, int quantity);
+    static const char* phaseName(Phase phase);
+
+private:
+    std::atomic<Series*> entries[MAX_SERIES];
+    std::atomic<int> count;
+    QMutex mutex;       // Yalnızca yeni seri eklenirken
+    std::atomic<quint64> reconnects;
+    std::atomic<int> queueDepth;
+    std::atomic<bool> connected;
+
+    Series* find(quint8 functionCode, quint8 slaveId) const;
+    Series* obtain(quint8 functionCode, int slaveId);
+
+    TransactionStats(const TransactionStats&) = delete;
+    TransactionStats& operator=(const TransactionStats&) = delete;
+};
+
+#endif // TRANSACTION_STATS_H
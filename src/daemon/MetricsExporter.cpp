@@ -0,0 +1,304 @@
+#include "MetricsExporter.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+
+namespace {
+
+// Histogram sınırları (saniye). HDR kovası sınırı aşıyorsa bir üst sınıra
+// sayılır; kova genişliği en fazla ~%1.6 olduğundan sapma küçüktür.
+const double BUCKET_BOUNDS[] = {
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+    0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+const int BUCKET_BOUND_COUNT = sizeof(BUCKET_BOUNDS) / sizeof(BUCKET_BOUNDS[0]);
+
+const int MAX_REQUEST_SIZE = 8192;
+
+// Her sınır için üst sınırı sınırı aşmayan son HDR kovası
+QVector<int> bucketBoundIndexes()
+{
+    QVector<int> indexes;
+    for (double bound : BUCKET_BOUNDS) {
+        const quint64 micros = static_cast<quint64>(bound * 1e6 + 0.5);
+        int index = LatencyHistogram::bucketIndex(micros);
+        if (LatencyHistogram::bucketUpperBound(index) > micros) {
+            --index;
+        }
+        indexes.append(index);
+    }
+    return indexes;
+}
+
+QByteArray escapeLabel(const QString& value)
+{
+    QByteArray out = value.toUtf8();
+    out.replace('\\', "\\\\");
+    out.replace('"', "\\\"");
+    out.replace('\n', "\\n");
+    return out;
+}
+
+void writeHeader(QByteArray& out, const char* name, const char* type, const char* help)
+{
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+void writeSample(QByteArray& out, const char* name, const QByteArray& labels, quint64 value)
+{
+    out += name;
+    out += '{';
+    out += labels;
+    out += "} ";
+    out += QByteArray::number(value);
+    out += '\n';
+}
+
+QByteArray seriesLabels(const QByteArray& device, const TransactionStats::Series* series)
+{
+    return "device=\"" + device + "\",function=\"" + QByteArray::number(series->functionCode) +
+           "\",slave=\"" + QByteArray::number(series->slaveId) + "\"";
+}
+
+QByteArray httpResponse(const char* status, const QByteArray& contentType, const QByteArray& body,
+                        bool includeBody)
+{
+    QByteArray response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: ";
+    response += QByteArray::number(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    if (includeBody) {
+        response += body;
+    }
+    return response;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(QObject* parent)
+    : QObject(parent)
+    , worker(nullptr)
+    , port(0)
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    stop();
+}
+
+void MetricsExporter::addDevice(const QString& name, const TransactionStats* stats)
+{
+    Q_ASSERT(!isRunning());
+    Source source;
+    source.name = name;
+    source.stats = stats;
+    sources.append(source);
+}
+
+bool MetricsExporter::start(const QHostAddress& address, quint16 requestedPort)
+{
+    if (isRunning()) {
+        return true;
+    }
+
+    worker = new QObject;
+    worker->moveToThread(&thread);
+    connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+    thread.start(QThread::LowPriority);
+
+    // Sunucu, soketleriyle aynı iş parçacığında oluşturulmalı
+    bool ok = false;
+    QString error;
+    quint16 boundPort = 0;
+    QMetaObject::invokeMethod(worker, [this, address, requestedPort, &ok, &error, &boundPort]() {
+        QTcpServer* server = new QTcpServer(worker);
+        if (!server->listen(address, requestedPort)) {
+            error = server->errorString();
+            return;
+        }
+        boundPort = server->serverPort();
+        connect(server, &QTcpServer::newConnection, worker, [this, server]() {
+            while (QTcpSocket* socket = server->nextPendingConnection()) {
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+                    handleRequest(socket);
+                });
+            }
+        });
+        ok = true;
+    }, Qt::BlockingQueuedConnection);
+
+    if (!ok) {
+        lastError = tr("Metrics endpoint could not listen on %1:%2: %3")
+                        .arg(address.toString()).arg(requestedPort).arg(error);
+        stop();
+        return false;
+    }
+    port = boundPort;
+    return true;
+}
+
+void MetricsExporter::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+    thread.quit();
+    thread.wait();
+    worker = nullptr;       // finished -> deleteLater
+    port = 0;
+}
+
+void MetricsExporter::handleRequest(QTcpSocket* socket)
+{
+    // Başlık tamamlanana kadar bekle; gövde beklenmez
+    const QByteArray pending = socket->peek(MAX_REQUEST_SIZE);
+    if (!pending.contains("\r\n\r\n") && !pending.contains("\n\n")) {
+        if (pending.size() >= MAX_REQUEST_SIZE) {
+            socket->abort();
+        }
+        return;
+    }
+    socket->readAll();
+    disconnect(socket, &QTcpSocket::readyRead, nullptr, nullptr);
+
+    const QList<QByteArray> requestLine = pending.left(pending.indexOf('\n')).trimmed().split(' ');
+    const QByteArray method = requestLine.value(0);
+    const QByteArray path = requestLine.value(1).split('?').value(0);
+    const bool head = (method == "HEAD");
+
+    QByteArray response;
+    if (method != "GET" && !head) {
+        response = httpResponse("405 Method Not Allowed", "text/plain", "Method not allowed\n", true);
+    } else if (path == "/metrics") {
+        response = httpResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8", render(), !head);
+    } else {
+        response = httpResponse("404 Not Found", "text/plain", "Try /metrics\n", !head);
+    }
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+QByteArray MetricsExporter::render() const
+{
+    static const QVector<int> boundIndex = bucketBoundIndexes();
+
+    QVector<QByteArray> devices;
+    devices.reserve(sources.size());
+    for (const Source& source : sources) {
+        devices.append(escapeLabel(source.name));
+    }
+
+    QByteArray out;
+    out.reserve(16384);
+
+    writeHeader(out, "qmodbus_up", "gauge", "Whether the device connection is open.");
+    for (int d = 0; d < sources.size(); ++d) {
+        writeSample(out, "qmodbus_up", "device=\"" + devices[d] + "\"",
+                    sources[d].stats->isConnected() ? 1 : 0);
+    }
+
+    writeHeader(out, "qmodbus_queue_depth", "gauge", "Requests waiting in the connection queue.");
+    for (int d = 0; d < sources.size(); ++d) {
+        writeSample(out, "qmodbus_queue_depth", "device=\"" + devices[d] + "\"",
+                    static_cast<quint64>(qMax(0, sources[d].stats->getQueueDepth())));
+    }
+
+    writeHeader(out, "qmodbus_reconnects_total", "counter", "Connection re-establishments.");
+    for (int d = 0; d < sources.size(); ++d) {
+        writeSample(out, "qmodbus_reconnects_total", "device=\"" + devices[d] + "\"",
+                    sources[d].stats->getReconnects());
+    }
+
+    writeHeader(out, "qmodbus_requests_total", "counter", "Modbus transactions issued.");
+    for (int d = 0; d < sources.size(); ++d) {
+        const TransactionStats* stats = sources[d].stats;
+        for (int s = 0; s < stats->seriesCount(); ++s) {
+            const TransactionStats::Series* series = stats->series(s);
+            writeSample(out, "qmodbus_requests_total", seriesLabels(devices[d], series),
+                        series->requests.load(std::memory_order_relaxed));
+        }
+    }
+
+    writeHeader(out, "qmodbus_request_failures_total", "counter", "Modbus transactions that failed.");
+    for (int d = 0; d < sources.size(); ++d) {
+        const TransactionStats* stats = sources[d].stats;
+        for (int s = 0; s < stats->seriesCount(); ++s) {
+            const TransactionStats::Series* series = stats->series(s);
+            writeSample(out, "qmodbus_request_failures_total", seriesLabels(devices[d], series),
+                        series->failures.load(std::memory_order_relaxed));
+        }
+    }
+
+    writeHeader(out, "qmodbus_request_timeouts_total", "counter", "Modbus transactions that timed out.");
+    for (int d = 0; d < sources.size(); ++d) {
+        const TransactionStats* stats = sources[d].stats;
+        for (int s = 0; s < stats->seriesCount(); ++s) {
+            const TransactionStats::Series* series = stats->series(s);
+            writeSample(out, "qmodbus_request_timeouts_total", seriesLabels(devices[d], series),
+                        series->timeouts.load(std::memory_order_relaxed));
+        }
+    }
+
+    writeHeader(out, "qmodbus_exceptions_total", "counter", "Modbus exception responses by exception code.");
+    for (int d = 0; d < sources.size(); ++d) {
+        const TransactionStats* stats = sources[d].stats;
+        for (int s = 0; s < stats->seriesCount(); ++s) {
+            const TransactionStats::Series* series = stats->series(s);
+            const QByteArray labels = seriesLabels(devices[d], series);
+            for (int code = 1; code < TransactionStats::EXCEPTION_CODE_COUNT; ++code) {
+                const quint64 value = series->exceptions[code].load(std::memory_order_relaxed);
+                if (value > 0) {
+                    writeSample(out, "qmodbus_exceptions_total",
+                                labels + ",code=\"" + QByteArray::number(code) + "\"", value);
+                }
+            }
+        }
+    }
+
+    writeHeader(out, "qmodbus_transaction_duration_seconds", "histogram",
+                "Transaction time by phase (queue_wait, wire, decode).");
+    for (int d = 0; d < sources.size(); ++d) {
+        const TransactionStats* stats = sources[d].stats;
+        for (int s = 0; s < stats->seriesCount(); ++s) {
+            const TransactionStats::Series* series = stats->series(s);
+            for (int phase = 0; phase < TransactionStats::PHASE_COUNT; ++phase) {
+                const LatencyHistogram::Snapshot snapshot = series->phases[phase].snapshot();
+                if (snapshot.count == 0) {
+                    continue;
+                }
+                const QByteArray labels = seriesLabels(devices[d], series) + ",phase=\"" +
+                    TransactionStats::phaseName(static_cast<TransactionStats::Phase>(phase)) + "\"";
+
+                quint64 cumulative = 0;
+                int next = 0;
+                for (int b = 0; b < BUCKET_BOUND_COUNT; ++b) {
+                    for (; next <= boundIndex[b]; ++next) {
+                        cumulative += snapshot.counts[next];
+                    }
+                    out += "qmodbus_transaction_duration_seconds_bucket{" + labels + ",le=\"" +
+                           QByteArray::number(BUCKET_BOUNDS[b]) + "\"} " +
+                           QByteArray::number(cumulative) + '\n';
+                }
+                out += "qmodbus_transaction_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " +
+                       QByteArray::number(snapshot.count) + '\n';
+                out += "qmodbus_transaction_duration_seconds_sum{" + labels + "} " +
+                       QByteArray::number(snapshot.sum / 1e6, 'g', 12) + '\n';
+                writeSample(out, "qmodbus_transaction_duration_seconds_count", labels, snapshot.count);
+            }
+        }
+    }
+
+    return out;
+}
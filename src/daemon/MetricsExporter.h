@@ -0,0 +1,53 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include "TransactionStats.h"
+#include <QObject>
+#include <QHostAddress>
+#include <QThread>
+#include <QVector>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Prometheus metin biçiminde (0.0.4) /metrics uç noktası. Sunucu kendi
+// iş parçacığında çalışır ve yalnızca TransactionStats atomiklerini okur;
+// scrape hiçbir kilit almaz, poll döngüsünü bekletmez.
+class MetricsExporter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MetricsExporter(QObject* parent = nullptr);
+    ~MetricsExporter();
+
+    // start()'tan önce çağrılır; stats exporter durana kadar geçerli kalmalı
+    void addDevice(const QString& name, const TransactionStats* stats);
+
+    bool start(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 9502);
+    void stop();
+    bool isRunning() const { return worker != nullptr; }
+    quint16 serverPort() const { return port; }
+    QString getLastError() const { return lastError; }
+
+    // Her iş parçacığından çağrılabilir
+    QByteArray render() const;
+
+private:
+    struct Source {
+        QString name;
+        const TransactionStats* stats;
+    };
+
+    QVector<Source> sources;
+    QThread thread;
+    QObject* worker;        // thread içinde yaşar; sunucu ve soketlerin sahibi
+    quint16 port;
+    QString lastError;
+
+    void handleRequest(QTcpSocket* socket);
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+#endif // METRICS_EXPORTER_H
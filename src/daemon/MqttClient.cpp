@@ -0,0 +1,276 @@
+#include "MqttClient.h"
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace {
+
+// Sabit başlık tipleri
+const quint8 CONNECT = 0x10;
+const quint8 CONNACK = 0x20;
+const quint8 PUBLISH = 0x30;
+const quint8 PUBACK = 0x40;
+const quint8 PINGREQ = 0xC0;
+const quint8 PINGRESP = 0xD0;
+const quint8 DISCONNECT = 0xE0;
+
+const int MAX_REMAINING_LENGTH = 268435455;
+
+void appendUint16(QByteArray& out, quint16 value)
+{
+    out.append(static_cast<char>(value >> 8));
+    out.append(static_cast<char>(value & 0xFF));
+}
+
+void appendString(QByteArray& out, const QByteArray& value)
+{
+    appendUint16(out, static_cast<quint16>(value.size()));
+    out.append(value);
+}
+
+} // namespace
+
+MqttClient::MqttClient(QObject* parent)
+    : QObject(parent)
+    , socket(new QTcpSocket(this))
+    , keepAliveTimer(new QTimer(this))
+    , nextPacketId(1)
+    , sessionUp(false)
+    , pingOutstanding(false)
+{
+    connect(socket, &QTcpSocket::connected, this, &MqttClient::onSocketConnected);
+    connect(socket, &QTcpSocket::disconnected, this, &MqttClient::onSocketDisconnected);
+    connect(socket, &QTcpSocket::readyRead, this, &MqttClient::onReadyRead);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    connect(socket, &QAbstractSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+#else
+    connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
+            [this](QAbstractSocket::SocketError) {
+#endif
+        // Bağlantı hiç kurulamadıysa disconnected gelmez
+        const bool wasOpen = socket->state() == QAbstractSocket::ConnectedState;
+        fail(socket->errorString());
+        if (!wasOpen) {
+            socket->abort();
+        }
+    });
+    connect(keepAliveTimer, &QTimer::timeout, this, &MqttClient::onKeepAliveTimeout);
+}
+
+MqttClient::~MqttClient()
+{
+    socket->abort();
+}
+
+void MqttClient::setOptions(const Options& newOptions)
+{
+    options = newOptions;
+}
+
+void MqttClient::connectToBroker()
+{
+    if (socket->state() != QAbstractSocket::UnconnectedState) {
+        return;
+    }
+    buffer.clear();
+    sessionUp = false;
+    pingOutstanding = false;
+    socket->connectToHost(options.host, options.port);
+}
+
+void MqttClient::disconnectFromBroker()
+{
+    keepAliveTimer->stop();
+    if (sessionUp) {
+        // Düzgün kapanışta broker will'i yayınlamaz
+        sendPacket(DISCONNECT, QByteArray());
+        socket->flush();
+    }
+    sessionUp = false;
+    socket->disconnectFromHost();
+    if (socket->state() != QAbstractSocket::UnconnectedState) {
+        socket->waitForDisconnected(1000);
+    }
+}
+
+int MqttClient::publish(const QString& topic, const QByteArray& payload, int qos)
+{
+    if (!sessionUp) {
+        return -1;
+    }
+
+    QByteArray body;
+    appendString(body, topic.toUtf8());
+    quint16 packetId = 0;
+    if (qos > 0) {
+        packetId = nextPacketId;
+        nextPacketId = (nextPacketId == 0xFFFF) ? 1 : nextPacketId + 1;
+        appendUint16(body, packetId);
+    }
+    body.append(payload);
+    sendPacket(static_cast<quint8>(PUBLISH | (qos > 0 ? 0x02 : 0x00)), body);
+    return packetId;
+}
+
+void MqttClient::onSocketConnected()
+{
+    const QByteArray username = options.username.toUtf8();
+    const QByteArray password = options.password.toUtf8();
+    const bool hasWill = !options.willTopic.isEmpty();
+
+    quint8 flags = 0x02;    // Temiz oturum; kuyruk yayıncının elinde
+    if (hasWill) {
+        flags |= 0x04 | static_cast<quint8>(qBound(0, options.willQos, 1) << 3);
+    }
+    if (!username.isEmpty()) {
+        flags |= 0x80;
+        if (!password.isEmpty()) {
+            flags |= 0x40;
+        }
+    }
+
+    QByteArray body;
+    appendString(body, "MQTT");
+    body.append(static_cast<char>(4));      // 3.1.1
+    body.append(static_cast<char>(flags));
+    appendUint16(body, static_cast<quint16>(options.keepAlive));
+    appendString(body, options.clientId.toUtf8());
+    if (hasWill) {
+        appendString(body, options.willTopic.toUtf8());
+        appendString(body, options.willPayload);
+    }
+    if (!username.isEmpty()) {
+        appendString(body, username);
+        if (!password.isEmpty()) {
+            appendString(body, password);
+        }
+    }
+    sendPacket(CONNECT, body);
+
+    // İlk tikte CONNACK gelmemişse bağlantı kesilir
+    keepAliveTimer->start(qMax(1, options.keepAlive) * 500);
+}
+
+void MqttClient::onSocketDisconnected()
+{
+    keepAliveTimer->stop();
+    const bool wasUp = sessionUp;
+    sessionUp = false;
+    if (wasUp) {
+        emit disconnected();
+    }
+}
+
+void MqttClient::onReadyRead()
+{
+    buffer.append(socket->readAll());
+
+    while (buffer.size() >= 2) {
+        // Kalan uzunluk: en fazla 4 baytlık varint
+        int length = 0;
+        int multiplier = 1;
+        int pos = 1;
+        bool complete = false;
+        while (pos < buffer.size() && pos <= 4) {
+            const quint8 byte = static_cast<quint8>(buffer[pos++]);
+            length += (byte & 0x7F) * multiplier;
+            multiplier *= 128;
+            if (!(byte & 0x80)) {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete) {
+            if (pos > 4) {
+                fail("Malformed MQTT packet length");
+                socket->abort();
+            }
+            return;
+        }
+        if (buffer.size() < pos + length) {
+            return;
+        }
+
+        const quint8 header = static_cast<quint8>(buffer[0]);
+        const QByteArray body = buffer.mid(pos, length);
+        buffer.remove(0, pos + length);
+        handlePacket(header, body);
+    }
+}
+
+void MqttClient::handlePacket(quint8 header, const QByteArray& body)
+{
+    switch (header & 0xF0) {
+        case CONNACK:
+            if (body.size() < 2 || body[1] != 0) {
+                fail(QString("Broker refused connection (code %1)")
+                         .arg(body.size() < 2 ? -1 : static_cast<int>(static_cast<quint8>(body[1]))));
+                socket->abort();
+                return;
+            }
+            sessionUp = true;
+            keepAliveTimer->start(qMax(1, options.keepAlive) * 1000);
+            emit connected();
+            break;
+
+        case PUBACK:
+            if (body.size() >= 2) {
+                emit published(static_cast<quint16>((static_cast<quint8>(body[0]) << 8) |
+                                                    static_cast<quint8>(body[1])));
+            }
+            break;
+
+        case PINGRESP:
+            pingOutstanding = false;
+            break;
+
+        case PUBLISH:
+            // Abone olunmadığından beklenmez; QoS 1 ise yine de onaylanır
+            if ((header & 0x06) == 0x02 && body.size() >= 2) {
+                const int topicLength = (static_cast<quint8>(body[0]) << 8) | static_cast<quint8>(body[1]);
+                if (body.size() >= topicLength + 4) {
+                    sendPacket(PUBACK, body.mid(2 + topicLength, 2));
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MqttClient::onKeepAliveTimeout()
+{
+    if (!sessionUp || pingOutstanding) {
+        fail(sessionUp ? "MQTT keep-alive timed out" : "MQTT connect timed out");
+        socket->abort();
+        return;
+    }
+    pingOutstanding = true;
+    sendPacket(PINGREQ, QByteArray());
+}
+
+void MqttClient::sendPacket(quint8 header, const QByteArray& body)
+{
+    Q_ASSERT(body.size() <= MAX_REMAINING_LENGTH);
+
+    QByteArray packet;
+    packet.reserve(body.size() + 5);
+    packet.append(static_cast<char>(header));
+    quint32 length = static_cast<quint32>(body.size());
+    do {
+        quint8 byte = length % 128;
+        length /= 128;
+        if (length > 0) {
+            byte |= 0x80;
+        }
+        packet.append(static_cast<char>(byte));
+    } while (length > 0);
+    packet.append(body);
+    socket->write(packet);
+}
+
+void MqttClient::fail(const QString& error)
+{
+    lastError = error;
+    emit connectionError(error);
+}
@@ -0,0 +1,79 @@
+#ifndef MQTT_CLIENT_H
+#define MQTT_CLIENT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+class QTcpSocket;
+class QTimer;
+
+// Yayıncının ihtiyacı kadar MQTT 3.1.1 istemcisi: CONNECT (will ile),
+// QoS 0/1 PUBLISH, PUBACK, PINGREQ ve DISCONNECT. Abonelik yoktur.
+// Yeniden bağlanma kararı kullanıcıya bırakılır.
+class MqttClient : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString host;
+        quint16 port;
+        QString clientId;
+        QString username;
+        QString password;
+        int keepAlive;          // saniye
+        QString willTopic;      // Boşsa will gönderilmez
+        QByteArray willPayload;
+        int willQos;
+
+        Options() : port(1883), keepAlive(30), willQos(1) {}
+    };
+
+    explicit MqttClient(QObject* parent = nullptr);
+    ~MqttClient();
+
+    // Will içeriği her bağlantıda değişebilir; connectToBroker'dan önce verilir
+    void setOptions(const Options& options);
+    const Options& getOptions() const { return options; }
+
+    void connectToBroker();
+    void disconnectFromBroker();
+    bool isConnected() const { return sessionUp; }
+
+    // QoS 1 için paket id'si döner (PUBACK'te published() yayınlanır);
+    // QoS 0 için 0. Bağlı değilse -1.
+    int publish(const QString& topic, const QByteArray& payload, int qos = 0);
+
+    QString getLastError() const { return lastError; }
+
+signals:
+    void connected();
+    void disconnected();
+    void published(quint16 packetId);
+    void connectionError(const QString& error);
+
+private slots:
+    void onSocketConnected();
+    void onSocketDisconnected();
+    void onReadyRead();
+    void onKeepAliveTimeout();
+
+private:
+    Options options;
+    QTcpSocket* socket;
+    QTimer* keepAliveTimer;
+    QByteArray buffer;
+    quint16 nextPacketId;
+    bool sessionUp;
+    bool pingOutstanding;
+    QString lastError;
+
+    void sendPacket(quint8 header, const QByteArray& body);
+    void handlePacket(quint8 header, const QByteArray& body);
+    void fail(const QString& error);
+
+    MqttClient(const MqttClient&) = delete;
+    MqttClient& operator=(const MqttClient&) = delete;
+};
+
+#endif // MQTT_CLIENT_H
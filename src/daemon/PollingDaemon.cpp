@@ -0,0 +1,185 @@
+#include "PollingDaemon.h"
+#include "ConfigImage.h"
+#include <QDebug>
+
+PollingDaemon::PollingDaemon(QObject* parent)
+    : QObject(parent)
+    , recorder(nullptr)
+    , metrics(nullptr)
+    , metricsPort(0)
+    , metricsEnabled(false)
+    , sharedMemoryEnabled(false)
+    , publisher(nullptr)
+    , mqttEnabled(false)
+{
+}
+
+PollingDaemon::~PollingDaemon()
+{
+    stop();
+}
+
+void PollingDaemon::setLogDirectory(const QString& directory)
+{
+    logDirectory = directory;
+}
+
+void PollingDaemon::setMetricsEndpoint(const QHostAddress& address, quint16 port)
+{
+    metricsAddress = address;
+    metricsPort = port;
+    metricsEnabled = true;
+}
+
+void PollingDaemon::setMqttOptions(const SparkplugPublisher::Options& options)
+{
+    mqttOptions = options;
+    mqttEnabled = true;
+}
+
+bool PollingDaemon::loadConfiguration(const QString& filename)
+{
+    if (ConfigImage::isImageFile(filename)) {
+        ConfigImage image;
+        if (!image.open(filename)) {
+            lastError = image.getLastError();
+            return false;
+        }
+        for (int i = 0; i < image.deviceCount(); ++i) {
+            auto device = std::make_shared<ModbusDevice>(QString());
+            if (!device->loadFromImage(image, i) || !addDevice(device)) {
+                lastError = device->getLastError().isEmpty() ? lastError : device->getLastError();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto device = std::make_shared<ModbusDevice>(QString());
+    if (!device->loadConfiguration(filename)) {
+        lastError = device->getLastError();
+        return false;
+    }
+    return addDevice(device);
+}
+
+bool PollingDaemon::addDevice(std::shared_ptr<ModbusDevice> device)
+{
+    const QString name = device->getName();
+    if (deviceStates.contains(name)) {
+        lastError = QString("Duplicate device name: %1").arg(name);
+        return false;
+    }
+
+    DeviceState state;
+    state.device = device.get();
+    for (int address : device->getRegisterAddresses()) {
+        state.units.insert(address, device->getRegisterConfig(address).unit);
+    }
+    deviceStates.insert(name, state);
+    devices.append(device);
+
+    connect(device.get(), &ModbusDevice::blockUpdated, this, &PollingDaemon::onBlockUpdated);
+    connect(device.get(), &ModbusDevice::connectionError, this, [name](const QString& error) {
+        qWarning() << "Device" << name << "connection error:" << error;
+    });
+    return true;
+}
+
+bool PollingDaemon::start()
+{
+    if (devices.isEmpty()) {
+        lastError = "No devices configured";
+        return false;
+    }
+
+    if (!recorder) {
+        recorder = new DataRecorder(logDirectory, this);
+    }
+
+    if (metricsEnabled && !metrics) {
+        metrics = new MetricsExporter(this);
+        for (const auto& device : devices) {
+            metrics->addDevice(device->getName(), &device->getTransactionStats());
+        }
+        if (!metrics->start(metricsAddress, metricsPort)) {
+            lastError = metrics->getLastError();
+            delete metrics;
+            metrics = nullptr;
+            return false;
+        }
+    }
+
+    // Broker erişilemese de başlar; yayıncı yeniden dener ve kuyruğa alır
+    if (mqttEnabled && !publisher) {
+        publisher = new SparkplugPublisher(mqttOptions, this);
+        for (const auto& device : devices) {
+            publisher->addDevice(device.get());
+        }
+        if (!publisher->start()) {
+            lastError = publisher->getLastError();
+            delete publisher;
+            publisher = nullptr;
+            return false;
+        }
+    }
+
+    // Bağlanamayan cihaz diğerlerini durdurmaz; startPolling isteği korunur ve
+    // ModbusDevice bağlantı kurulana dek artan aralıklarla yeniden dener
+    for (const auto& device : devices) {
+        if (sharedMemoryEnabled && !device->enableSharedMemory()) {
+            qWarning() << "Device" << device->getName() << "shared memory disabled:" << device->getLastError();
+        }
+        if (!device->connectToDevice()) {
+            qWarning() << "Device" << device->getName() << "could not connect:" << device->getLastError();
+        }
+        device->startPolling();
+    }
+    return true;
+}
+
+void PollingDaemon::stop()
+{
+    if (metrics) {
+        metrics->stop();
+    }
+    if (publisher) {
+        publisher->stop();
+    }
+    for (const auto& device : devices) {
+        device->stopPolling();
+        device->disconnectDevice();
+        device->disableSharedMemory();
+    }
+    if (recorder) {
+        recorder->flush();
+    }
+}
+
+void PollingDaemon::onBlockUpdated(const QString& deviceName, const QBitArray& changedTags)
+{
+    auto it = deviceStates.constFind(deviceName);
+    if (it == deviceStates.constEnd()) {
+        return;
+    }
+
+    // Döngü başına tek kopya; tag'ler kilitsiz okunur
+    const auto snapshot = it->device->getTagTable()->snapshot();
+    const int count = qMin(changedTags.size(), snapshot->size());
+    for (int id = 0; id < count; ++id) {
+        if (!changedTags.testBit(id)) {
+            continue;
+        }
+
+        TagTable::Sample sample;
+        if (!snapshot->read(id, sample)) {
+            continue;
+        }
+        const bool good = (sample.quality == TagTable::QUALITY_GOOD);
+        const QString unit = it->units.value(sample.address);
+        if (good && recorder) {
+            recorder->logDeviceData(deviceName, sample.address, sample.scaled, unit, sample.timestamp);
+        }
+        emit tagChanged(deviceName, sample.address, sample.scaled, unit, sample.timestamp, good);
+    }
+}
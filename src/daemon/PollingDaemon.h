@@ -0,0 +1,70 @@
+#ifndef POLLING_DAEMON_H
+#define POLLING_DAEMON_H
+
+#include "ModbusDevice.h"
+#include "DataRecorder.h"
+#include "MetricsExporter.h"
+#include "SparkplugPublisher.h"
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <memory>
+
+// Pencere olmadan çalışan polling servisi. Cihaz yapılandırmalarını yükler,
+// cihazları bağlar ve poll eder, değişen tag'leri kaydedicilere iletir.
+class PollingDaemon : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PollingDaemon(QObject* parent = nullptr);
+    ~PollingDaemon();
+
+    // JSON dosyası tek cihaz, ConfigImage dosyası içindeki tüm cihazlar
+    bool loadConfiguration(const QString& filename);
+    void setLogDirectory(const QString& directory);
+    // start() ile birlikte /metrics uç noktası açılır
+    void setMetricsEndpoint(const QHostAddress& address, quint16 port);
+    // start() ile her cihazın tag tablosu paylaşımlı belleğe yayınlanır
+    void setSharedMemoryEnabled(bool enabled) { sharedMemoryEnabled = enabled; }
+    // start() ile değişen tag'ler MQTT broker'ına (Sparkplug B) yayınlanır
+    void setMqttOptions(const SparkplugPublisher::Options& options);
+
+    bool start();
+    void stop();
+
+    int deviceCount() const { return devices.size(); }
+    const ModbusDevice* device(int index) const { return devices.at(index).get(); }
+    QString getLastError() const { return lastError; }
+
+signals:
+    // Değişen her tag için; kaydediciler ve dışa aktarıcılar buna bağlanır
+    void tagChanged(const QString& deviceName, int address, double scaledValue,
+                    const QString& unit, qint64 timestamp, bool good);
+
+private slots:
+    void onBlockUpdated(const QString& deviceName, const QBitArray& changedTags);
+
+private:
+    struct DeviceState {
+        ModbusDevice* device;
+        QHash<int, QString> units;      // Adres -> birim (yüklemede bir kez)
+    };
+
+    QList<std::shared_ptr<ModbusDevice>> devices;
+    QHash<QString, DeviceState> deviceStates;
+    DataRecorder* recorder;
+    MetricsExporter* metrics;
+    QHostAddress metricsAddress;
+    quint16 metricsPort;
+    bool metricsEnabled;
+    bool sharedMemoryEnabled;
+    SparkplugPublisher* publisher;
+    SparkplugPublisher::Options mqttOptions;
+    bool mqttEnabled;
+    QString logDirectory;
+    QString lastError;
+
+    bool addDevice(std::shared_ptr<ModbusDevice> device);
+};
+
+#endif // POLLING_DAEMON_H
@@ -0,0 +1,439 @@
+#include "SparkplugPublisher.h"
+#include <QDateTime>
+#include <QSet>
+#include <QTimer>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+
+// Sparkplug B veri tipleri
+const quint32 TYPE_UINT64 = 8;
+const quint32 TYPE_DOUBLE = 10;
+
+const int MIN_RECONNECT_DELAY = 1000;
+const int MAX_RECONNECT_DELAY = 30000;
+
+// Protobuf alan kodlaması (sparkplug_b.proto); üretici kod gerekmez
+void appendVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+void appendUInt(QByteArray& out, int field, quint64 value)
+{
+    appendVarint(out, static_cast<quint64>(field) << 3);
+    appendVarint(out, value);
+}
+
+void appendDouble(QByteArray& out, int field, double value)
+{
+    appendVarint(out, (static_cast<quint64>(field) << 3) | 1);
+    char bytes[sizeof(double)];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, sizeof(bytes));
+}
+
+void appendBytes(QByteArray& out, int field, const QByteArray& value)
+{
+    appendVarint(out, (static_cast<quint64>(field) << 3) | 2);
+    appendVarint(out, static_cast<quint64>(value.size()));
+    out.append(value);
+}
+
+// Metric: name=1, alias=2, timestamp=3, datatype=4, is_historical=5,
+// is_null=7, long_value=11, double_value=13
+QByteArray encodeMetric(const QByteArray& name, quint64 alias, qint64 timestamp,
+                        bool historical, bool isNull, double value)
+{
+    QByteArray metric;
+    if (!name.isEmpty()) {
+        appendBytes(metric, 1, name);
+    }
+    appendUInt(metric, 2, alias);
+    appendUInt(metric, 3, static_cast<quint64>(timestamp));
+    if (!name.isEmpty()) {
+        appendUInt(metric, 4, TYPE_DOUBLE);     // Tip yalnızca birth'te
+    }
+    if (historical) {
+        appendUInt(metric, 5, 1);
+    }
+    if (isNull) {
+        appendUInt(metric, 7, 1);
+    } else {
+        appendDouble(metric, 13, value);
+    }
+    return metric;
+}
+
+// Payload: timestamp=1, metrics=2, seq=3
+QByteArray encodePayload(qint64 timestamp, const QVector<QByteArray>& metrics, quint64 seq)
+{
+    QByteArray payload;
+    appendUInt(payload, 1, static_cast<quint64>(timestamp));
+    for (const QByteArray& metric : metrics) {
+        appendBytes(payload, 2, metric);
+    }
+    appendUInt(payload, 3, seq);
+    return payload;
+}
+
+QByteArray encodeBdSeq(quint64 bdSeq, qint64 timestamp)
+{
+    QByteArray metric;
+    appendBytes(metric, 1, "bdSeq");
+    appendUInt(metric, 3, static_cast<quint64>(timestamp));
+    appendUInt(metric, 4, TYPE_UINT64);
+    appendUInt(metric, 11, bdSeq);
+    return metric;
+}
+
+// Sparkplug kimlikleri '/', '+' ve '#' içeremez
+QString sanitizeId(const QString& id)
+{
+    QString out = id;
+    for (QChar& c : out) {
+        if (c == '/' || c == '+' || c == '#' || c.isSpace()) {
+            c = '_';
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+SparkplugPublisher::SparkplugPublisher(const Options& options, QObject* parent)
+    : QObject(parent)
+    , options(options)
+    , client(new MqttClient(this))
+    , reconnectTimer(new QTimer(this))
+    , reconnectDelay(MIN_RECONNECT_DELAY)
+    , running(false)
+    , queuedMetricCount(0)
+    , droppedMetricCount(0)
+    , publishedCount(0)
+    , bdSeq(0)
+    , seq(0)
+{
+    reconnectTimer->setSingleShot(true);
+    connect(reconnectTimer, &QTimer::timeout, this, &SparkplugPublisher::reconnect);
+    connect(client, &MqttClient::connected, this, &SparkplugPublisher::onConnected);
+    connect(client, &MqttClient::disconnected, this, &SparkplugPublisher::onDisconnected);
+    connect(client, &MqttClient::connectionError, this, &SparkplugPublisher::onConnectionError);
+    connect(client, &MqttClient::published, this, &SparkplugPublisher::onPublished);
+}
+
+SparkplugPublisher::~SparkplugPublisher()
+{
+    stop();
+}
+
+void SparkplugPublisher::addDevice(const ModbusDevice* device)
+{
+    Q_ASSERT(!running);
+    const int index = devices.size();
+
+    DeviceEntry entry;
+    entry.device = device;
+    entry.deviceId = sanitizeId(device->getName());
+    if (entry.deviceId.isEmpty()) {
+        entry.deviceId = QString("device%1").arg(index);
+    }
+    // Alias'lar uç düğüm içinde tekil olmalı: cihaz sırası << 16 | adres
+    entry.aliasBase = static_cast<quint64>(index + 1) << 16;
+    entry.birthSize = -1;
+    devices.append(entry);
+    deviceIndex.insert(device->getName(), index);
+
+    connect(device, &ModbusDevice::blockUpdated, this, &SparkplugPublisher::onBlockUpdated);
+}
+
+bool SparkplugPublisher::start()
+{
+    if (running) {
+        return true;
+    }
+    if (options.host.isEmpty() || options.groupId.isEmpty() || options.edgeNodeId.isEmpty()) {
+        lastError = "MQTT host, group id and edge node id are required";
+        return false;
+    }
+
+    running = true;
+    reconnectDelay = MIN_RECONNECT_DELAY;
+    reconnect();
+    return true;
+}
+
+void SparkplugPublisher::stop()
+{
+    if (!running) {
+        return;
+    }
+    running = false;
+    reconnectTimer->stop();
+
+    if (client->isConnected()) {
+        // Düzgün kapanışta broker will'i göndermez; NDEATH elle yayınlanır
+        client->publish(topic("NDEATH"), deathPayload(), 0);
+        client->disconnectFromBroker();
+        bdSeq = (bdSeq + 1) % 256;
+    }
+
+    // Onaylanmamışlar kuyruğa döner (bellekte; bir sonraki start'ta gönderilir)
+    for (int i = inflight.size() - 1; i >= 0; --i) {
+        Batch batch = inflight[i].second;
+        batch.historical = true;
+        queue.prepend(batch);
+    }
+    inflight.clear();
+}
+
+void SparkplugPublisher::reconnect()
+{
+    if (!running || client->isConnected()) {
+        return;
+    }
+
+    // Will, bu oturumun bdSeq'iyle NDEATH'tir
+    MqttClient::Options clientOptions;
+    clientOptions.host = options.host;
+    clientOptions.port = options.port;
+    clientOptions.clientId = QString("qmodbus-%1-%2").arg(options.groupId, options.edgeNodeId);
+    clientOptions.username = options.username;
+    clientOptions.password = options.password;
+    clientOptions.keepAlive = options.keepAlive;
+    clientOptions.willTopic = topic("NDEATH");
+    clientOptions.willPayload = deathPayload();
+    clientOptions.willQos = 1;
+    client->setOptions(clientOptions);
+    client->connectToBroker();
+}
+
+void SparkplugPublisher::scheduleReconnect()
+{
+    if (!running || reconnectTimer->isActive()) {
+        return;
+    }
+    reconnectTimer->start(reconnectDelay);
+    reconnectDelay = qMin(reconnectDelay * 2, MAX_RECONNECT_DELAY);
+}
+
+void SparkplugPublisher::onConnected()
+{
+    reconnectDelay = MIN_RECONNECT_DELAY;
+    seq = 0;
+    publishBirths();
+    sendQueued();
+    emit connectionStateChanged(true);
+}
+
+void SparkplugPublisher::onDisconnected()
+{
+    bdSeq = (bdSeq + 1) % 256;
+
+    // Onay gelmeyenler gönderim sırasıyla kuyruğun başına döner
+    for (int i = inflight.size() - 1; i >= 0; --i) {
+        queue.prepend(inflight[i].second);
+    }
+    inflight.clear();
+    for (Batch& batch : queue) {
+        batch.historical = true;
+    }
+
+    emit connectionStateChanged(false);
+    scheduleReconnect();
+}
+
+void SparkplugPublisher::onConnectionError(const QString& error)
+{
+    lastError = error;
+    qWarning() << "MQTT" << options.host << ":" << error;
+    if (!client->isConnected()) {
+        scheduleReconnect();
+    }
+}
+
+void SparkplugPublisher::onPublished(quint16 packetId)
+{
+    for (int i = 0; i < inflight.size(); ++i) {
+        if (inflight[i].first == packetId) {
+            queuedMetricCount -= inflight[i].second.metrics.size();
+            inflight.removeAt(i);
+            ++publishedCount;
+            break;
+        }
+    }
+    sendQueued();
+}
+
+void SparkplugPublisher::onBlockUpdated(const QString& deviceName, const QBitArray& changedTags)
+{
+    auto it = deviceIndex.constFind(deviceName);
+    if (it == deviceIndex.constEnd()) {
+        return;
+    }
+    const int index = *it;
+    DeviceEntry& entry = devices[index];
+
+    // Tag listesi değiştiyse yeni DBIRTH güncel değerleri zaten taşır
+    const auto snapshot = entry.device->getTagTable()->snapshot();
+    if (snapshot->size() != entry.birthSize && client->isConnected()) {
+        publishDeviceBirth(index);
+        return;
+    }
+
+    Batch batch;
+    batch.device = index;
+    batch.timestamp = QDateTime::currentMSecsSinceEpoch();
+    batch.historical = false;
+
+    const int count = qMin(changedTags.size(), snapshot->size());
+    for (int id = 0; id < count; ++id) {
+        if (!changedTags.testBit(id)) {
+            continue;
+        }
+        TagTable::Sample sample;
+        if (!snapshot->read(id, sample)) {
+            continue;
+        }
+
+        // Hatalı blok her döngüde işaretlenir; yalnızca geçiş yayınlanır
+        const bool good = (sample.quality == TagTable::QUALITY_GOOD);
+        auto last = entry.lastValues.find(sample.address);
+        if (last != entry.lastValues.end()) {
+            if (last->good == good && (!good || last->value == sample.scaled)) {
+                continue;
+            }
+            last->good = good;
+            last->value = sample.scaled;
+        } else {
+            entry.lastValues.insert(sample.address, LastValue{sample.scaled, good});
+        }
+
+        Metric metric;
+        metric.alias = entry.aliasBase + static_cast<quint64>(sample.address);
+        metric.timestamp = sample.timestamp;
+        metric.value = sample.scaled;
+        metric.isNull = !good;
+        batch.metrics.append(metric);
+    }
+
+    if (!batch.metrics.isEmpty()) {
+        enqueue(batch);
+        sendQueued();
+    }
+}
+
+void SparkplugPublisher::enqueue(const Batch& batch)
+{
+    Batch queued = batch;
+    queued.historical = !client->isConnected();
+    queue.append(queued);
+    queuedMetricCount += queued.metrics.size();
+
+    // Sınır aşılırsa en eski döngüler düşürülür
+    while (queuedMetricCount > options.maxQueuedMetrics && queue.size() > 1) {
+        const int dropped = queue.takeFirst().metrics.size();
+        queuedMetricCount -= dropped;
+        droppedMetricCount += static_cast<quint64>(dropped);
+    }
+}
+
+void SparkplugPublisher::sendQueued()
+{
+    while (client->isConnected() && inflight.size() < options.inflightWindow && !queue.isEmpty()) {
+        const Batch& batch = queue.first();
+
+        QVector<QByteArray> metrics;
+        metrics.reserve(batch.metrics.size());
+        for (const Metric& metric : batch.metrics) {
+            metrics.append(encodeMetric(QByteArray(), metric.alias, metric.timestamp,
+                                        batch.historical, metric.isNull, metric.value));
+        }
+
+        const int packetId = client->publish(topic("DDATA", devices[batch.device].deviceId),
+                                             encodePayload(batch.timestamp, metrics, nextSeq()), 1);
+        if (packetId < 0) {
+            break;
+        }
+        inflight.append(qMakePair(static_cast<quint16>(packetId), queue.takeFirst()));
+    }
+}
+
+void SparkplugPublisher::publishBirths()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QVector<QByteArray> metrics;
+    metrics.append(encodeBdSeq(bdSeq, now));
+    client->publish(topic("NBIRTH"), encodePayload(now, metrics, nextSeq()), 0);
+
+    for (int index = 0; index < devices.size(); ++index) {
+        publishDeviceBirth(index);
+    }
+}
+
+void SparkplugPublisher::publishDeviceBirth(int index)
+{
+    DeviceEntry& entry = devices[index];
+    const auto snapshot = entry.device->getTagTable()->snapshot();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QVector<QByteArray> metrics;
+    metrics.reserve(snapshot->size());
+    QSet<QString> names;
+    entry.lastValues.clear();
+    for (int id = 0; id < snapshot->size(); ++id) {
+        TagTable::Sample sample;
+        if (!snapshot->read(id, sample)) {
+            continue;
+        }
+
+        // Ad tekil değilse adres eklenir
+        QString name = entry.device->getRegisterConfig(sample.address).name;
+        if (name.isEmpty()) {
+            name = QString::number(sample.address);
+        } else if (names.contains(name)) {
+            name = QString("%1 (%2)").arg(name).arg(sample.address);
+        }
+        names.insert(name);
+
+        const bool good = (sample.quality == TagTable::QUALITY_GOOD);
+        metrics.append(encodeMetric(name.toUtf8(), entry.aliasBase + static_cast<quint64>(sample.address),
+                                    sample.timestamp ? sample.timestamp : now, false, !good, sample.scaled));
+        entry.lastValues.insert(sample.address, LastValue{sample.scaled, good});
+    }
+    entry.birthSize = snapshot->size();
+
+    client->publish(topic("DBIRTH", entry.deviceId), encodePayload(now, metrics, nextSeq()), 0);
+}
+
+QByteArray SparkplugPublisher::deathPayload() const
+{
+    // NDEATH seq taşımaz; yalnızca zaman damgası ve bdSeq
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QByteArray payload;
+    appendUInt(payload, 1, static_cast<quint64>(now));
+    appendBytes(payload, 2, encodeBdSeq(bdSeq, now));
+    return payload;
+}
+
+QString SparkplugPublisher::topic(const char* type, const QString& deviceId) const
+{
+    QString result = QString("spBv1.0/%1/%2/%3").arg(sanitizeId(options.groupId), QString::fromLatin1(type),
+                                                     sanitizeId(options.edgeNodeId));
+    if (!deviceId.isEmpty()) {
+        result += '/' + deviceId;
+    }
+    return result;
+}
+
+quint64 SparkplugPublisher::nextSeq()
+{
+    const quint64 current = seq;
+    seq = (seq + 1) % 256;
+    return current;
+}
@@ -0,0 +1,124 @@
+#ifndef SPARKPLUG_PUBLISHER_H
+#define SPARKPLUG_PUBLISHER_H
+
+#include "ModbusDevice.h"
+#include "MqttClient.h"
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QPair>
+#include <QBitArray>
+
+class QTimer;
+
+// Poll edilen tag'leri Sparkplug B konu ve yük biçimiyle bir MQTT broker'ına
+// yayınlar. Cihaz başına her poll döngüsü tek DDATA mesajıdır ve yalnızca
+// değeri ya da kalitesi değişen tag'leri taşır (report-by-exception).
+// Mesajlar yerel kuyrukta bekler: broker erişilemezken birikir, bağlantı
+// dönünce "historical" işaretiyle sırayla gönderilir. QoS 1 DDATA, PUBACK
+// gelene kadar kuyruktan düşmez.
+class SparkplugPublisher : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString host;
+        quint16 port;
+        QString groupId;
+        QString edgeNodeId;
+        QString username;
+        QString password;
+        int keepAlive;          // saniye
+        int maxQueuedMetrics;   // Aşılınca en eski DDATA düşürülür
+        int inflightWindow;     // PUBACK beklenen en fazla mesaj
+
+        Options() : port(1883), groupId("qmodbus"), keepAlive(30),
+                    maxQueuedMetrics(100000), inflightWindow(16) {}
+    };
+
+    explicit SparkplugPublisher(const Options& options, QObject* parent = nullptr);
+    ~SparkplugPublisher();
+
+    // start()'tan önce çağrılır; cihaz yayıncıdan uzun yaşamalı
+    void addDevice(const ModbusDevice* device);
+
+    bool start();
+    void stop();
+    bool isConnected() const { return client->isConnected(); }
+
+    int queuedMetrics() const { return queuedMetricCount; }
+    quint64 droppedMetrics() const { return droppedMetricCount; }
+    quint64 publishedMessages() const { return publishedCount; }
+    QString getLastError() const { return lastError; }
+
+signals:
+    void connectionStateChanged(bool connected);
+
+private slots:
+    void onBlockUpdated(const QString& deviceName, const QBitArray& changedTags);
+    void onConnected();
+    void onDisconnected();
+    void onConnectionError(const QString& error);
+    void onPublished(quint16 packetId);
+    void reconnect();
+
+private:
+    struct Metric {
+        quint64 alias;
+        qint64 timestamp;
+        double value;
+        bool isNull;            // Kalite BAD
+    };
+
+    // Bir cihazın bir poll döngüsündeki değişiklikleri
+    struct Batch {
+        int device;
+        qint64 timestamp;
+        bool historical;        // Bağlantı yokken biriktirildi
+        QVector<Metric> metrics;
+    };
+
+    struct LastValue {
+        double value;
+        bool good;
+    };
+
+    struct DeviceEntry {
+        const ModbusDevice* device;
+        QString deviceId;               // Konu için temizlenmiş ad
+        quint64 aliasBase;
+        int birthSize;                  // Son DBIRTH'teki tag sayısı
+        QHash<int, LastValue> lastValues;   // Adres -> son yayınlanan
+    };
+
+    Options options;
+    MqttClient* client;
+    QTimer* reconnectTimer;
+    int reconnectDelay;
+    bool running;
+
+    QVector<DeviceEntry> devices;
+    QHash<QString, int> deviceIndex;
+
+    QList<Batch> queue;
+    QList<QPair<quint16, Batch>> inflight;  // Gönderim sırasıyla
+    int queuedMetricCount;
+    quint64 droppedMetricCount;
+    quint64 publishedCount;
+
+    quint64 bdSeq;              // Oturum (birth/death) sırası
+    quint64 seq;                // 0..255, NBIRTH ile sıfırlanır
+    QString lastError;
+
+    QString topic(const char* type, const QString& deviceId = QString()) const;
+    QByteArray deathPayload() const;
+    void publishBirths();
+    void publishDeviceBirth(int device);
+    void enqueue(const Batch& batch);
+    void sendQueued();
+    void scheduleReconnect();
+    quint64 nextSeq();
+};
+
+#endif // SPARKPLUG_PUBLISHER_H
@@ -0,0 +1,138 @@
+#include "PollingDaemon.h"
+#include "Logger.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSysInfo>
+#include <QTimer>
+#include <QDebug>
+#include <csignal>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void handleSignal(int)
+{
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qmodbusd");
+    QCoreApplication::setApplicationVersion("0.1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless Modbus polling daemon");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption logDirOption(QStringList() << "l" << "log-dir",
+                                    "Directory for recorded data.", "directory");
+    parser.addOption(logDirOption);
+    QCommandLineOption binaryLogOption(QStringList() << "b" << "binary-log",
+                                       "Write the diagnostic log in binary form (read with qmodbuslog).", "file");
+    parser.addOption(binaryLogOption);
+    QCommandLineOption debugOption(QStringList() << "d" << "debug", "Enable DEBUG level logging.");
+    parser.addOption(debugOption);
+    QCommandLineOption metricsPortOption("metrics-port",
+                                         "Serve Prometheus metrics at http://<address>:<port>/metrics.", "port");
+    parser.addOption(metricsPortOption);
+    QCommandLineOption metricsAddressOption("metrics-address",
+                                            "Address for the metrics endpoint (default 127.0.0.1).", "address",
+                                            "127.0.0.1");
+    parser.addOption(metricsAddressOption);
+    QCommandLineOption mqttHostOption("mqtt-host", "Publish changed tags to this MQTT broker (Sparkplug B).",
+                                      "host");
+    parser.addOption(mqttHostOption);
+    QCommandLineOption mqttPortOption("mqtt-port", "MQTT broker port (default 1883).", "port", "1883");
+    parser.addOption(mqttPortOption);
+    QCommandLineOption mqttGroupOption("mqtt-group", "Sparkplug group id (default qmodbus).", "group", "qmodbus");
+    parser.addOption(mqttGroupOption);
+    QCommandLineOption mqttNodeOption("mqtt-node", "Sparkplug edge node id (default host name).", "node",
+                                      QSysInfo::machineHostName());
+    parser.addOption(mqttNodeOption);
+    QCommandLineOption mqttUserOption("mqtt-user", "MQTT user name.", "user");
+    parser.addOption(mqttUserOption);
+    QCommandLineOption mqttPasswordOption("mqtt-password", "MQTT password.", "password");
+    parser.addOption(mqttPasswordOption);
+    QCommandLineOption shmOption("shm", "Publish tag values to a shared-memory segment per device.");
+    parser.addOption(shmOption);
+    parser.addPositionalArgument("config", "Device configuration files (JSON or binary image).",
+                                 "config...");
+    parser.process(app);
+
+    const QStringList configs = parser.positionalArguments();
+    if (configs.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    if (parser.isSet(debugOption)) {
+        Logger::instance().setLogLevel(Logger::Level::DEBUG);
+    }
+    if (parser.isSet(binaryLogOption)) {
+        Logger::instance().setFileFormat(Logger::FileFormat::BINARY);
+        if (!Logger::instance().setLogFile(parser.value(binaryLogOption))) {
+            qCritical() << "Cannot open log file" << parser.value(binaryLogOption);
+            return 1;
+        }
+    }
+
+    PollingDaemon daemon;
+    daemon.setLogDirectory(parser.value(logDirOption));
+    if (parser.isSet(metricsPortOption)) {
+        bool ok = false;
+        const uint port = parser.value(metricsPortOption).toUInt(&ok);
+        const QHostAddress address(parser.value(metricsAddressOption));
+        if (!ok || port > 65535 || address.isNull()) {
+            qCritical() << "Invalid metrics endpoint" << parser.value(metricsAddressOption)
+                        << parser.value(metricsPortOption);
+            return 1;
+        }
+        daemon.setMetricsEndpoint(address, static_cast<quint16>(port));
+    }
+    daemon.setSharedMemoryEnabled(parser.isSet(shmOption));
+    if (parser.isSet(mqttHostOption)) {
+        bool ok = false;
+        const uint port = parser.value(mqttPortOption).toUInt(&ok);
+        if (!ok || port == 0 || port > 65535) {
+            qCritical() << "Invalid MQTT port" << parser.value(mqttPortOption);
+            return 1;
+        }
+        SparkplugPublisher::Options mqtt;
+        mqtt.host = parser.value(mqttHostOption);
+        mqtt.port = static_cast<quint16>(port);
+        mqtt.groupId = parser.value(mqttGroupOption);
+        mqtt.edgeNodeId = parser.value(mqttNodeOption);
+        mqtt.username = parser.value(mqttUserOption);
+        mqtt.password = parser.value(mqttPasswordOption);
+        daemon.setMqttOptions(mqtt);
+    }
+    for (const QString& config : configs) {
+        if (!daemon.loadConfiguration(config)) {
+            qCritical() << "Failed to load" << config << ":" << daemon.getLastError();
+            return 1;
+        }
+    }
+
+    if (!daemon.start()) {
+        qCritical() << "Failed to start:" << daemon.getLastError();
+        return 1;
+    }
+    qInfo() << "Polling" << daemon.deviceCount() << "device(s)";
+
+    // Sinyal işleyicide yalnızca bayrak kurulur; çıkış olay döngüsünden yapılır
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    QTimer signalTimer;
+    QObject::connect(&signalTimer, &QTimer::timeout, &app, [&app]() {
+        if (stopRequested) {
+            app.quit();
+        }
+    });
+    signalTimer.start(200);
+
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &daemon, &PollingDaemon::stop);
+    return app.exec();
+}
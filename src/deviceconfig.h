@@ -14,12 +14,14 @@ struct RegisterConfig {
     QString unit;         // Birim (°C, Bar, mA, vs.)
     double minValue;      // Minimum değer
     double maxValue;      // Maximum değer
+    double deadband;      // Ölü bant (ölçeklenmiş birimde, 0 = kapalı)
 
     RegisterConfig() : 
         address(0),
         scaleFactor(1.0),
         minValue(0.0),
-        maxValue(65535.0)
+        maxValue(65535.0),
+        deadband(0.0)
     {}
 };
 
@@ -0,0 +1,152 @@
+#include "BinaryLog.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const char* const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+const int LEVEL_COUNT = 5;
+
+int parseLevel(const QString& text)
+{
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        if (text.compare(LEVEL_NAMES[level], Qt::CaseInsensitive) == 0) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+// Sayı (ms epoch) ya da ISO tarih kabul edilir
+bool parseTime(const QString& text, qint64& out)
+{
+    bool ok = false;
+    out = text.toLongLong(&ok);
+    if (ok) {
+        return true;
+    }
+    const QDateTime time = QDateTime::fromString(text, Qt::ISODateWithMs);
+    if (!time.isValid()) {
+        return false;
+    }
+    out = time.toMSecsSinceEpoch();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qmodbuslog");
+    QCoreApplication::setApplicationVersion("0.1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decode and filter binary qmodbus log files");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption levelOption(QStringList() << "l" << "level",
+                                   "Minimum level (DEBUG, INFO, WARNING, ERROR, CRITICAL).", "level");
+    QCommandLineOption contextOption(QStringList() << "c" << "context",
+                                     "Only entries whose context contains this text.", "text");
+    QCommandLineOption grepOption(QStringList() << "g" << "grep",
+                                  "Only entries whose message matches this regular expression.", "regex");
+    QCommandLineOption sinceOption("since", "Only entries at or after this time (ISO or ms epoch).", "time");
+    QCommandLineOption untilOption("until", "Only entries before this time (ISO or ms epoch).", "time");
+    QCommandLineOption formatsOption("formats", "Print entry counts per format string instead of entries.");
+    parser.addOption(levelOption);
+    parser.addOption(contextOption);
+    parser.addOption(grepOption);
+    parser.addOption(sinceOption);
+    parser.addOption(untilOption);
+    parser.addOption(formatsOption);
+    parser.addPositionalArgument("file", "Binary log files, in order.", "file...");
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    int minimumLevel = 0;
+    if (parser.isSet(levelOption)) {
+        minimumLevel = parseLevel(parser.value(levelOption));
+        if (minimumLevel < 0) {
+            qCritical() << "Unknown level:" << parser.value(levelOption);
+            return 1;
+        }
+    }
+    qint64 since = std::numeric_limits<qint64>::min();
+    qint64 until = std::numeric_limits<qint64>::max();
+    if ((parser.isSet(sinceOption) && !parseTime(parser.value(sinceOption), since)) ||
+        (parser.isSet(untilOption) && !parseTime(parser.value(untilOption), until))) {
+        qCritical() << "Invalid time; use ISO 8601 or milliseconds since epoch";
+        return 1;
+    }
+    const QString context = parser.value(contextOption);
+    QRegularExpression pattern;
+    if (parser.isSet(grepOption)) {
+        pattern.setPattern(parser.value(grepOption));
+        if (!pattern.isValid()) {
+            qCritical() << "Invalid regular expression:" << pattern.errorString();
+            return 1;
+        }
+    }
+    const bool countFormats = parser.isSet(formatsOption);
+
+    QTextStream out(stdout);
+    QHash<QString, int> formatCounts;
+    for (const QString& file : files) {
+        BinaryLog::Decoder decoder;
+        if (!decoder.open(file)) {
+            qCritical() << decoder.getLastError();
+            return 1;
+        }
+
+        BinaryLog::Entry entry;
+        while (decoder.next(entry)) {
+            if (entry.level < minimumLevel || entry.timestamp < since || entry.timestamp >= until) {
+                continue;
+            }
+            if (!context.isEmpty() && !entry.context.contains(context)) {
+                continue;
+            }
+            if (parser.isSet(grepOption) && !pattern.match(entry.message).hasMatch()) {
+                continue;
+            }
+
+            if (countFormats) {
+                formatCounts[entry.context + ": " + (entry.format.isEmpty() ? entry.message : entry.format)]++;
+                continue;
+            }
+
+            // Logger::formatLogMessage ile aynı satır biçimi
+            out << QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString("yyyy-MM-dd hh:mm:ss.zzz")
+                << " [" << (entry.level < LEVEL_COUNT ? LEVEL_NAMES[entry.level] : "UNKNOWN") << "] ";
+            if (!entry.context.isEmpty()) {
+                out << entry.context << ": ";
+            }
+            out << entry.message << '\n';
+        }
+    }
+
+    if (countFormats) {
+        QVector<QPair<int, QString>> sorted;
+        for (auto it = formatCounts.constBegin(); it != formatCounts.constEnd(); ++it) {
+            sorted.append(qMakePair(it.value(), it.key()));
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const QPair<int, QString>& a, const QPair<int, QString>& b) {
+            return a.first > b.first;
+        });
+        for (const auto& item : sorted) {
+            out << item.first << '\t' << item.second << '\n';
+        }
+    }
+    return 0;
+}
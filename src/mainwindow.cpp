@@ -9,10 +9,14 @@
 #include <QApplication>
 #include "DeviceConfigDialog.h"
 #include <QThread>
+#include <QSignalBlocker>
+#include <QScrollBar>
 #include "RegisterTableModel.h"
+#include "RegisterDecoder.h"
 #include <QStyledItemDelegate>
 #include <QComboBox>
 #include <errno.h>
+#include <cstring>
 
 MainWindow::MainWindow(QWidget *parent) :
 	QMainWindow(parent),
@@ -21,9 +25,11 @@ MainWindow::MainWindow(QWidget *parent) :
 	isPolling(false),
 	pollRate(1000),
 	currentDeviceId(0),
+	tableRefresh(nullptr),
 	dataLogger(nullptr)
 {
     ui->setupUi(this);
+    tableRefresh = new RefreshScheduler(this);
     setupConnections();
     setupTable();
 	setupPolling(); 
@@ -65,6 +71,8 @@ void MainWindow::updateRegisterValue(int row, uint16_t value)
 {
     if (row < 0 || row >= ui->registerTable->rowCount()) return;
     
+    // Programdan yazılan değer cellChanged ile PLC'ye geri yazılmamalı
+    const QSignalBlocker blocker(ui->registerTable);
     QTableWidgetItem* item = ui->registerTable->item(row, 1);
     if (!item) {
         item = new QTableWidgetItem();
@@ -78,44 +86,149 @@ void MainWindow::updateRegisterValue(int row, uint16_t value)
     item->setText(formattedValue);
 }
 
+// Cihaz yapılandırmasındaki veri tipi metnini decoder tipine çevirir
+static ModbusTypes::DataType decoderDataType(const QString& dataType)
+{
+    if (dataType == "INT16") return ModbusTypes::DataType::INT;
+    if (dataType.startsWith("INT32")) return ModbusTypes::DataType::DINT;
+    if (dataType.startsWith("UINT32")) return ModbusTypes::DataType::DWORD;
+    if (dataType == "FLOAT32") return ModbusTypes::DataType::REAL;
+    if (dataType == "BOOL") return ModbusTypes::DataType::BIT;
+    return ModbusTypes::DataType::WORD;
+}
+
+// Byte order metnini decoder sırasına çevirir
+static ModbusTypes::ByteOrder decoderByteOrder(const QString& byteOrder)
+{
+    if (byteOrder.startsWith("CD AB")) return ModbusTypes::ByteOrder::CD_AB;
+    if (byteOrder.startsWith("BA DC")) return ModbusTypes::ByteOrder::BA_DC;
+    if (byteOrder.startsWith("DC BA")) return ModbusTypes::ByteOrder::DC_BA;
+    return ModbusTypes::ByteOrder::AB_CD;
+}
+
 void MainWindow::processReadResults(int deviceId, uint16_t* registers, int count)
 {
     auto &config = deviceConfigs[deviceId];
-    
+
+    // Önceki okumayla karşılaştır; aynı blok için hiçbir şey yapılmaz
+    QVector<uint16_t> &previous = lastReadBlocks[deviceId];
+    QVector<double> &reported = lastReportedValues[deviceId];
+    const bool fullRefresh = (previous.size() != count);
+    if (fullRefresh) {
+        previous.resize(count);
+        reported.fill(0.0, count);
+    } else if (memcmp(previous.constData(), registers, count * sizeof(uint16_t)) == 0) {
+        return;
+    }
+
+    // Her satır kendi adresinden başlayan bir tag; yalnızca word'leri değişen
+    // satırlar tek geçişte çözülür
+    const ModbusTypes::DataType dataType = decoderDataType(config.dataType);
+    const ModbusTypes::ByteOrder byteOrder = (dataType == ModbusTypes::DataType::REAL) ?
+        decoderByteOrder(config.byteOrder) : ModbusTypes::ByteOrder::AB_CD;
+    const int wordCount = ModbusTypes::registerWordCount(dataType);
+
+    QVector<int> changedRows;
+    QVector<RegisterDecoder::TagLayout> layouts;
     for(int i = 0; i < count; i++) {
-        qDebug() << "Register" << i << "raw value:" << registers[i];
-        
-        // Tabloyu güncelle
-        QTableWidgetItem* item = ui->registerTable->item(i, 1);
-        if (!item) {
-            item = new QTableWidgetItem();
-            ui->registerTable->setItem(i, 1, item);
+        bool changed = fullRefresh;
+        for(int k = 0; !changed && k < wordCount && i + k < count; k++) {
+            changed = (registers[i + k] != previous[i + k]);
+        }
+        if (!changed) continue;
+
+        RegisterDecoder::TagLayout layout;
+        layout.wordOffset = static_cast<quint16>(i);
+        layout.wordCount = static_cast<quint8>(wordCount);
+        layout.dataType = dataType;
+        layout.byteOrder = byteOrder;
+        layouts.append(layout);
+        changedRows.append(i);
+    }
+    memcpy(previous.data(), registers, count * sizeof(uint16_t));
+
+    QVector<quint64> rawBits(layouts.size());
+    QVector<double> decoded(layouts.size());
+    RegisterDecoder::decodeBlock(registers, count, layouts.constData(), layouts.size(),
+                                 rawBits.data(), decoded.data());
+
+    for(int j = 0; j < changedRows.size(); j++) {
+        const int i = changedRows[j];
+        const int address = config.startAddress + i;
+        QString unit = "";
+        double scaledValue = decoded[j];
+        double deadband = 0.0;
+
+        if (config.registers.contains(address)) {
+            const auto& regConfig = config.registers[address];
+            unit = regConfig.unit;
+            scaledValue = decoded[j] * regConfig.scaleFactor;
+            deadband = regConfig.deadband;
+        }
+
+        // Ölü bant içindeki değişimler gösterilmez ve loglanmaz
+        if (!fullRefresh && deadband > 0.0 && qAbs(scaledValue - reported[i]) <= deadband) {
+            continue;
         }
+        reported[i] = scaledValue;
         
-        QString value = formatRegisterValue(registers[i], 
-                                         config.registerFormats[i],
-                                         i < count-1 ? registers[i+1] : 0);
-                                         
-        qDebug() << "Register" << i << "formatted value:" << value;
-        item->setText(value);
+        QString value;
+        if (config.registerFormats[i] == "Dec") {
+            if (dataType == ModbusTypes::DataType::REAL) {
+                value = QString::number(decoded[j], 'f', 2);
+            } else {
+                value = QString::number(static_cast<qint64>(decoded[j]));
+            }
+        } else {
+            value = formatRegisterValue(registers[i], 
+                                        config.registerFormats[i],
+                                        i < count-1 ? registers[i+1] : 0);
+        }
+        // Tablo kare sonunda, yalnızca görünür satırlar için güncellenir
+        if (i < pendingValues.size()) {
+            pendingValues[i] = value;
+            tableRefresh->markDirty(i);
+        }
         
         // DataLogger'a veri gönder
         if (dataLogger) {
-            int address = config.startAddress + i;
-            QString unit = "";
-            double scaledValue = registers[i];
-            
-            if (config.registers.contains(address)) {
-                const auto& regConfig = config.registers[address];
-                unit = regConfig.unit;
-                scaledValue = registers[i] * regConfig.scaleFactor;
-            }
-            
             dataLogger->logData(address, QVariant(scaledValue), unit);
         }
     }
 }
 
+void MainWindow::applyPendingValues(int first, int last)
+{
+    // Poll güncellemeleri cellChanged üretmemeli; aksi halde her hücre için
+    // onRegisterValueChanged tetiklenip değer PLC'ye geri yazılır
+    const QSignalBlocker blocker(ui->registerTable);
+
+    last = qMin(last, qMin(pendingValues.size(), ui->registerTable->rowCount()) - 1);
+    for (int row = first; row <= last; ++row) {
+        QTableWidgetItem* item = ui->registerTable->item(row, 1);
+        if (!item) {
+            item = new QTableWidgetItem();
+            ui->registerTable->setItem(row, 1, item);
+        }
+        item->setText(pendingValues[row]);
+    }
+}
+
+void MainWindow::updateVisibleRows()
+{
+    QTableWidget* table = ui->registerTable;
+    const int first = table->rowAt(0);
+    if (first < 0) {
+        tableRefresh->setVisibleRange(-1, -1);
+        return;
+    }
+    int last = table->rowAt(table->viewport()->height() - 1);
+    if (last < 0) {
+        last = table->rowCount() - 1;
+    }
+    tableRefresh->setVisibleRange(first, last);
+}
+
 QString MainWindow::getRegisterTypeString(const QString& plcType) const
 {
     if (plcType == "Input Register") return "3x";
@@ -158,6 +271,13 @@ void MainWindow::setupConnections()
     connect(ui->loadButton, &QPushButton::clicked, this, &MainWindow::onLoadConfigClicked);
     connect(ui->deviceComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onDeviceSelectionChanged(int)));
     connect(ui->setupButton, &QPushButton::clicked, this, &MainWindow::onRegisterSetupClicked);
+
+    // Kaydırma ve yeniden boyutlandırmada görünür aralık yenilenir
+    connect(tableRefresh, &RefreshScheduler::rowsReady, this, &MainWindow::applyPendingValues);
+    connect(ui->registerTable->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &MainWindow::updateVisibleRows);
+    connect(ui->registerTable->verticalScrollBar(), &QScrollBar::rangeChanged,
+            this, &MainWindow::updateVisibleRows);
 }
 
 class ComboBoxDelegate : public QStyledItemDelegate {
@@ -506,6 +626,7 @@ void MainWindow::onRegisterValueChanged(int row, int column)
         }
         
         // Değeri yeniden formatla
+        lastReadBlocks.remove(currentDeviceId);
         if (modbusContexts.contains(currentDeviceId)) {
             updateRegisters();
         }
@@ -672,6 +793,7 @@ QVariant MainWindow::deviceConfigToVariant(const DeviceConfig &config)
         regMap["unit"] = it.value().unit;
         regMap["minValue"] = it.value().minValue;
         regMap["maxValue"] = it.value().maxValue;
+        regMap["deadband"] = it.value().deadband;
         registersMap[QString::number(it.key())] = regMap;
     }
     map["registers"] = registersMap;
@@ -709,6 +831,7 @@ DeviceConfig MainWindow::variantToDeviceConfig(const QVariant &variant)
         regConfig.unit = regMap["unit"].toString();
         regConfig.minValue = regMap["minValue"].toDouble();
         regConfig.maxValue = regMap["maxValue"].toDouble();
+        regConfig.deadband = regMap["deadband"].toDouble();
         config.registers[it.key().toInt()] = regConfig;
     }
     
@@ -831,7 +954,12 @@ void MainWindow::setupRegisterTable(const DeviceConfig &config)
     qDebug() << "  Formats size:" << config.registerFormats.size();
     qDebug() << "  Start Address:" << config.startAddress;
     
+    // Satır oluşturma cellChanged üretmemeli; "0" değerleri PLC'ye yazılır
+    const QSignalBlocker blocker(ui->registerTable);
     ui->registerTable->setRowCount(0);
+    lastReadBlocks.remove(currentDeviceId);
+    tableRefresh->clear();
+    pendingValues.clear();
     
     if (config.quantity <= 0) {
         qDebug() << "Invalid quantity:" << config.quantity;
@@ -884,6 +1012,8 @@ void MainWindow::setupRegisterTable(const DeviceConfig &config)
         QTableWidgetItem* descItem = new QTableWidgetItem("");
         ui->registerTable->setItem(i, 3, descItem);
     }
+    pendingValues.resize(config.quantity);
+    updateVisibleRows();
     qDebug() << "=== End setupRegisterTable ===";
 }
 
@@ -18,6 +18,7 @@
 #include "DeviceConfigDialog.h"
 #include "deviceconfig.h"
 #include "utils/DataLogger.h"
+#include "RefreshScheduler.h"
 
 
 namespace Ui {
@@ -45,6 +46,8 @@ private slots:
     void onLoadConfigClicked();
     void onDeviceSelectionChanged(int index);
     void onRegisterSetupClicked();
+    void applyPendingValues(int first, int last);
+    void updateVisibleRows();
 
 private:
     Ui::MainWindow *ui;
@@ -54,6 +57,10 @@ private:
     bool isPolling;       // Polling durumu
     int pollRate;         // Polling hızı (ms)
     int currentDeviceId;  // Aktif PLC ID
+    QMap<int, QVector<uint16_t>> lastReadBlocks;    // Değişim tespiti için son okunan bloklar
+    QMap<int, QVector<double>> lastReportedValues;  // Ölü bant için son gösterilen değerler
+    RefreshScheduler *tableRefresh;   // Değer hücrelerini kare başına bir kez günceller
+    QVector<QString> pendingValues;   // Satır -> henüz tabloya yazılmamış değer
 
     void setupPolling();
     void updateRegisterValue(int row, uint16_t value);
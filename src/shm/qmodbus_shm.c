@@ -0,0 +1,404 @@
+#include "qmodbus_shm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+/* Yazıcı slotu bu kadar denemede bırakmazsa (ör. yazarken çöktü) EBUSY */
+#define MAX_READ_ATTEMPTS 10000
+
+struct qmodbus_shm {
+    const qmodbus_shm_header* header;
+    const qmodbus_shm_slot* slots;
+    uint32_t capacity;          /* Eşlenmiş slot sayısı */
+    size_t length;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+};
+
+#ifdef _WIN32
+static uint32_t load_acquire(const uint32_t* p)
+{
+    uint32_t value = *(const volatile uint32_t*)p;
+    MemoryBarrier();
+    return value;
+}
+
+static void fence_acquire(void)
+{
+    MemoryBarrier();
+}
+#else
+static uint32_t load_acquire(const uint32_t* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void fence_acquire(void)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+#endif
+
+static uint32_t load_relaxed(const uint32_t* p)
+{
+    return *(const volatile uint32_t*)p;
+}
+
+size_t qmodbus_shm_path(const char* device, char* buffer, size_t size)
+{
+    char name[QMODBUS_SHM_DEVICE_SIZE];
+    size_t i;
+    int written;
+
+    /* SharedTagTable::segmentPath ile aynı kural */
+    if (!device || !*device) {
+        device = "default";
+    }
+    for (i = 0; device[i] && i < sizeof(name) - 1; ++i) {
+        const char c = device[i];
+        const int safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                         (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+        name[i] = safe ? c : '_';
+    }
+    name[i] = '\0';
+
+#if defined(__linux__)
+    written = snprintf(buffer, size, "/dev/shm/qmodbus-%s", name);
+#elif defined(_WIN32)
+    {
+        char temp[MAX_PATH + 1];
+        DWORD length = GetTempPathA(sizeof(temp), temp);
+        while (length > 0 && (temp[length - 1] == '\\' || temp[length - 1] == '/')) {
+            temp[--length] = '\0';
+        }
+        written = snprintf(buffer, size, "%s\\qmodbus-%s.shm", length > 0 ? temp : ".", name);
+    }
+#else
+    {
+        const char* temp = getenv("TMPDIR");
+        size_t length;
+        char dir[1024];
+        if (!temp || !*temp) {
+            temp = "/tmp";
+        }
+        snprintf(dir, sizeof(dir), "%s", temp);
+        length = strlen(dir);
+        while (length > 1 && dir[length - 1] == '/') {
+            dir[--length] = '\0';
+        }
+        written = snprintf(buffer, size, "%s/qmodbus-%s.shm", dir, name);
+    }
+#endif
+    return written < 0 ? 0 : (size_t)written;
+}
+
+static void unmap(qmodbus_shm* shm)
+{
+    if (!shm->header) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(shm->header);
+    CloseHandle(shm->mapping);
+    shm->mapping = NULL;
+#else
+    munmap((void*)shm->header, shm->length);
+#endif
+    shm->header = NULL;
+    shm->slots = NULL;
+    shm->capacity = 0;
+    shm->length = 0;
+}
+
+/*
+ * Dosyanın güncel boyutuyla yeniden eşler (yazıcı kapasiteyi büyüttüyse).
+ * Yeni görünüm önce kurulup doğrulanır; yalnızca başarılıysa eskisiyle
+ * değiştirilir. Hata durumunda eski görünüm geçerli kalır.
+ */
+static int map(qmodbus_shm* shm)
+{
+    const qmodbus_shm_header* header;
+    size_t length;
+    void* data;
+#ifdef _WIN32
+    HANDLE mapping;
+    {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(shm->file, &size)) {
+            return QMODBUS_SHM_ESYSTEM;
+        }
+        length = (size_t)size.QuadPart;
+        if (length < sizeof(qmodbus_shm_header)) {
+            return QMODBUS_SHM_EFORMAT;
+        }
+        mapping = CreateFileMappingA(shm->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping) {
+            return QMODBUS_SHM_ESYSTEM;
+        }
+        data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            CloseHandle(mapping);
+            return QMODBUS_SHM_ESYSTEM;
+        }
+    }
+#else
+    {
+        struct stat st;
+        if (fstat(shm->fd, &st) != 0) {
+            return QMODBUS_SHM_ESYSTEM;
+        }
+        length = (size_t)st.st_size;
+        if (length < sizeof(qmodbus_shm_header)) {
+            return QMODBUS_SHM_EFORMAT;
+        }
+        data = mmap(NULL, length, PROT_READ, MAP_SHARED, shm->fd, 0);
+        if (data == MAP_FAILED) {
+            return QMODBUS_SHM_ESYSTEM;
+        }
+    }
+#endif
+
+    header = (const qmodbus_shm_header*)data;
+    if (header->magic != QMODBUS_SHM_MAGIC || header->version != QMODBUS_SHM_VERSION ||
+        header->header_size != sizeof(qmodbus_shm_header) ||
+        header->slot_size != sizeof(qmodbus_shm_slot)) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+#else
+        munmap(data, length);
+#endif
+        return QMODBUS_SHM_EFORMAT;
+    }
+
+    unmap(shm);
+#ifdef _WIN32
+    shm->mapping = mapping;
+#endif
+    shm->header = header;
+    shm->length = length;
+    shm->slots = (const qmodbus_shm_slot*)((const char*)data + header->header_size);
+    shm->capacity = (uint32_t)((length - header->header_size) / header->slot_size);
+    return QMODBUS_SHM_OK;
+}
+
+qmodbus_shm* qmodbus_shm_open(const char* device, int* error)
+{
+    char path[1024];
+    if (qmodbus_shm_path(device, path, sizeof(path)) >= sizeof(path)) {
+        if (error) {
+            *error = QMODBUS_SHM_ENOENT;
+        }
+        return NULL;
+    }
+    return qmodbus_shm_open_path(path, error);
+}
+
+qmodbus_shm* qmodbus_shm_open_path(const char* path, int* error)
+{
+    int result;
+    qmodbus_shm* shm = (qmodbus_shm*)calloc(1, sizeof(qmodbus_shm));
+    if (!shm) {
+        if (error) {
+            *error = QMODBUS_SHM_ESYSTEM;
+        }
+        return NULL;
+    }
+
+#ifdef _WIN32
+    shm->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (shm->file == INVALID_HANDLE_VALUE) {
+        free(shm);
+        if (error) {
+            *error = QMODBUS_SHM_ENOENT;
+        }
+        return NULL;
+    }
+#else
+    shm->fd = open(path, O_RDONLY);
+    if (shm->fd < 0) {
+        free(shm);
+        if (error) {
+            *error = QMODBUS_SHM_ENOENT;
+        }
+        return NULL;
+    }
+#endif
+
+    result = map(shm);
+    if (result != QMODBUS_SHM_OK) {
+        qmodbus_shm_close(shm);
+        if (error) {
+            *error = result;
+        }
+        return NULL;
+    }
+    if (error) {
+        *error = QMODBUS_SHM_OK;
+    }
+    return shm;
+}
+
+void qmodbus_shm_close(qmodbus_shm* shm)
+{
+    if (!shm) {
+        return;
+    }
+    unmap(shm);
+#ifdef _WIN32
+    CloseHandle(shm->file);
+#else
+    close(shm->fd);
+#endif
+    free(shm);
+}
+
+const char* qmodbus_shm_device(const qmodbus_shm* shm)
+{
+    if (!shm || !shm->header) {
+        return "";
+    }
+    return shm->header->device;
+}
+
+uint32_t qmodbus_shm_layout(const qmodbus_shm* shm)
+{
+    if (!shm || !shm->header) {
+        return 0;
+    }
+    return load_acquire(&shm->header->layout_seq);
+}
+
+int qmodbus_shm_tag_count(const qmodbus_shm* shm)
+{
+    if (!shm || !shm->header) {
+        return QMODBUS_SHM_ESYSTEM;
+    }
+    return (int)load_acquire(&shm->header->tag_count);
+}
+
+int64_t qmodbus_shm_heartbeat(const qmodbus_shm* shm)
+{
+    int64_t value;
+    if (!shm || !shm->header) {
+        return 0;
+    }
+    value = *(const volatile int64_t*)&shm->header->heartbeat;
+    fence_acquire();
+    return value;
+}
+
+int qmodbus_shm_find(qmodbus_shm* shm, int address)
+{
+    int attempt;
+    if (!shm || !shm->header) {
+        return -1;
+    }
+    for (attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = load_acquire(&shm->header->layout_seq);
+        uint32_t count;
+        uint32_t i;
+        int found = -1;
+
+        if (before & 1) {
+            continue;   /* Tag listesi yeniden yazılıyor */
+        }
+        count = load_acquire(&shm->header->tag_count);
+        if (count > shm->capacity && map(shm) != QMODBUS_SHM_OK) {
+            return -1;
+        }
+        for (i = 0; i < count && i < shm->capacity; ++i) {
+            if (*(const volatile uint16_t*)&shm->slots[i].address == (uint16_t)address) {
+                found = (int)i;
+                break;
+            }
+        }
+        fence_acquire();
+        if (load_relaxed(&shm->header->layout_seq) == before) {
+            return found;
+        }
+    }
+    return -1;
+}
+
+int qmodbus_shm_read(qmodbus_shm* shm, int index, qmodbus_shm_sample* out)
+{
+    const qmodbus_shm_slot* slot;
+    int attempt;
+
+    if (!shm || !out || index < 0) {
+        return QMODBUS_SHM_ERANGE;
+    }
+    if (!shm->header) {
+        return QMODBUS_SHM_ESYSTEM;
+    }
+    if ((uint32_t)index >= load_acquire(&shm->header->tag_count)) {
+        return QMODBUS_SHM_ERANGE;
+    }
+    if ((uint32_t)index >= shm->capacity) {
+        const int result = map(shm);
+        if (result != QMODBUS_SHM_OK) {
+            return result;
+        }
+        if ((uint32_t)index >= shm->capacity) {
+            return QMODBUS_SHM_ERANGE;
+        }
+    }
+
+    slot = &shm->slots[index];
+    for (attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        const uint32_t before = load_acquire(&slot->seq);
+        if (before & 1) {
+            continue;   /* Yazıcı bu slotta */
+        }
+
+        out->address = slot->address;
+        out->word_count = slot->word_count;
+        out->quality = slot->quality;
+        out->alarm_flags = slot->alarm_flags;
+        memcpy(out->words, slot->words, sizeof(out->words));
+        out->timestamp = slot->timestamp;
+        out->value = slot->value;
+
+        fence_acquire();
+        if (load_relaxed(&slot->seq) == before) {
+            return QMODBUS_SHM_OK;
+        }
+    }
+    return QMODBUS_SHM_EBUSY;
+}
+
+int qmodbus_shm_read_address(qmodbus_shm* shm, int address, qmodbus_shm_sample* out)
+{
+    int attempt;
+    for (attempt = 0; attempt < 2; ++attempt) {
+        const int index = qmodbus_shm_find(shm, address);
+        int result;
+        if (index < 0) {
+            return QMODBUS_SHM_ENOENT;
+        }
+        result = qmodbus_shm_read(shm, index, out);
+        /* Arada tag listesi değiştiyse bir kez daha ara */
+        if (result != QMODBUS_SHM_OK || out->address == (uint16_t)address) {
+            return result;
+        }
+    }
+    return QMODBUS_SHM_ENOENT;
+}
@@ -0,0 +1,112 @@
+#ifndef QMODBUS_SHM_H
+#define QMODBUS_SHM_H
+
+/*
+ * qmodbus paylaşımlı bellek tag tablosu: yerleşim ve okuyucu kütüphanesi.
+ *
+ * Poller (SharedTagTable) her cihaz için bir segment yazar:
+ *   Linux:  /dev/shm/qmodbus-<cihaz>
+ *   Diğer:  <geçici dizin>/qmodbus-<cihaz>.shm
+ * Segment = başlık (128 bayt) + capacity adet 64 baytlık slot. Her slot kendi
+ * seqlock sayacını taşır; okuyucu kilit almaz, sistem çağrısı yapmaz.
+ * Tag listesi değişince başlıktaki layout_seq artar; find() sonuçları
+ * layout değeri değişene kadar önbelleklenebilir.
+ *
+ * Yazıcı her açılışta segmenti siler ve yeniden oluşturur; kapanırken de
+ * siler. Açık bir okuyucu eski (bağlantısı kopmuş) dosyayı görmeye devam
+ * eder: değerler donar, heartbeat ilerlemez. Heartbeat polling aralığının
+ * birkaç katı boyunca değişmezse okuyucu qmodbus_shm_close + qmodbus_shm_open
+ * ile yeniden açmalıdır.
+ *
+ * Qt gerektirmez; C ve C++'tan kullanılabilir.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define QMODBUS_SHM_MAGIC       0x4D48534Du     /* "MSHM" */
+#define QMODBUS_SHM_VERSION     1
+#define QMODBUS_SHM_MAX_WORDS   4
+#define QMODBUS_SHM_DEVICE_SIZE 64
+
+/* Kalite (TagTable::Quality ile aynı) */
+#define QMODBUS_SHM_UNCERTAIN   0
+#define QMODBUS_SHM_GOOD        1
+#define QMODBUS_SHM_BAD         2
+
+/* Hata kodları */
+#define QMODBUS_SHM_OK          0
+#define QMODBUS_SHM_ENOENT      (-1)    /* Segment ya da tag yok */
+#define QMODBUS_SHM_EFORMAT     (-2)    /* Tanınmayan segment */
+#define QMODBUS_SHM_ERANGE      (-3)    /* Geçersiz indeks */
+#define QMODBUS_SHM_EBUSY       (-4)    /* Yazıcı slotu bırakmadı */
+#define QMODBUS_SHM_ESYSTEM     (-5)    /* open/mmap hatası */
+
+typedef struct qmodbus_shm_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t slot_size;
+    uint32_t capacity;          /* Ayrılmış slot sayısı; yalnızca büyür */
+    uint32_t layout_seq;        /* Tek: tag listesi yeniden yazılıyor */
+    uint32_t tag_count;
+    uint64_t writer_pid;
+    uint64_t update_count;      /* Yayın turu sayacı */
+    int64_t  heartbeat;         /* Son yayın, ms (epoch) */
+    char     device[QMODBUS_SHM_DEVICE_SIZE];
+    uint8_t  reserved[16];
+} qmodbus_shm_header;
+
+typedef struct qmodbus_shm_slot {
+    uint32_t seq;               /* Tek: yazım sürüyor */
+    uint16_t address;
+    uint8_t  word_count;
+    uint8_t  quality;
+    uint8_t  alarm_flags;
+    uint8_t  reserved0[7];
+    int64_t  timestamp;         /* ms (epoch) */
+    double   value;             /* Ölçeklenmiş değer */
+    uint16_t words[QMODBUS_SHM_MAX_WORDS];  /* Uzun metinlerde yalnızca ilk word'ler */
+    uint8_t  reserved1[24];
+} qmodbus_shm_slot;
+
+/* Okuyucuya verilen tutarlı kopya */
+typedef struct qmodbus_shm_sample {
+    uint16_t address;
+    uint8_t  word_count;
+    uint8_t  quality;
+    uint8_t  alarm_flags;
+    uint16_t words[QMODBUS_SHM_MAX_WORDS];
+    int64_t  timestamp;
+    double   value;
+} qmodbus_shm_sample;
+
+typedef struct qmodbus_shm qmodbus_shm;
+
+/* Cihaz adından segment yolu; gereken uzunluğu (NUL hariç) döndürür */
+size_t qmodbus_shm_path(const char* device, char* buffer, size_t size);
+
+qmodbus_shm* qmodbus_shm_open(const char* device, int* error);
+qmodbus_shm* qmodbus_shm_open_path(const char* path, int* error);
+void qmodbus_shm_close(qmodbus_shm* shm);
+
+const char* qmodbus_shm_device(const qmodbus_shm* shm);
+uint32_t qmodbus_shm_layout(const qmodbus_shm* shm);
+int qmodbus_shm_tag_count(const qmodbus_shm* shm);
+/* Durursa yazıcı yeniden başlamış olabilir: segment yeniden açılmalı */
+int64_t qmodbus_shm_heartbeat(const qmodbus_shm* shm);
+
+/* Adresin slot indeksi, yoksa -1 (doğrusal arama; sonucu önbellekleyin) */
+int qmodbus_shm_find(qmodbus_shm* shm, int address);
+int qmodbus_shm_read(qmodbus_shm* shm, int index, qmodbus_shm_sample* out);
+int qmodbus_shm_read_address(qmodbus_shm* shm, int address, qmodbus_shm_sample* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QMODBUS_SHM_H */
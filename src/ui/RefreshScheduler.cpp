@@ -0,0 +1,157 @@
+#include "RefreshScheduler.h"
+#include <QTimer>
+#include <algorithm>
+
+RefreshScheduler::RefreshScheduler(QObject* parent)
+    : QObject(parent)
+    , frameTimer(new QTimer(this))
+    , visibleFirst(-1)
+    , visibleLast(-1)
+{
+    frameTimer->setSingleShot(true);
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(16);
+    connect(frameTimer, &QTimer::timeout, this, &RefreshScheduler::flush);
+}
+
+void RefreshScheduler::setInterval(int ms)
+{
+    frameTimer->setInterval(qMax(1, ms));
+}
+
+int RefreshScheduler::interval() const
+{
+    return frameTimer->interval();
+}
+
+void RefreshScheduler::setVisibleRange(int first, int last)
+{
+    if (first < 0 || last < first) {
+        visibleFirst = visibleLast = -1;
+        return;
+    }
+
+    // Yeni açılan satırlar bekleyen değişiklikleri bir sonraki karede alır
+    visibleFirst = first;
+    visibleLast = last;
+    if (!dirtyRows.isEmpty() && !frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void RefreshScheduler::markDirty(int row)
+{
+    if (row < 0) {
+        return;
+    }
+    if (row >= dirtyMask.size()) {
+        dirtyMask.resize(qMax(row + 1, dirtyMask.size() * 2));
+    }
+    if (dirtyMask.testBit(row)) {
+        return;
+    }
+    dirtyMask.setBit(row);
+    dirtyRows.append(row);
+
+    // Kare içindeki tüm değişiklikler tek flush'ta toplanır
+    if (!frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void RefreshScheduler::markDirty(int first, int last)
+{
+    for (int row = qMax(0, first); row <= last; ++row) {
+        markDirty(row);
+    }
+}
+
+void RefreshScheduler::insertRows(int first, int count)
+{
+    if (count > 0) {
+        shiftRows(first, count);
+    }
+}
+
+void RefreshScheduler::removeRows(int first, int count)
+{
+    if (count > 0) {
+        shiftRows(first, -count);
+    }
+}
+
+void RefreshScheduler::shiftRows(int first, int delta)
+{
+    if (dirtyRows.isEmpty()) {
+        return;
+    }
+
+    // first'ten önceki satırlar yerinde kalır; silme aralığındakiler düşer
+    QVector<int> shifted;
+    shifted.reserve(dirtyRows.size());
+    for (int row : dirtyRows) {
+        if (row < first) {
+            shifted.append(row);
+        } else if (delta > 0 || row >= first - delta) {
+            shifted.append(row + delta);
+        }
+    }
+
+    dirtyMask.fill(false);
+    for (int row : shifted) {
+        if (row >= dirtyMask.size()) {
+            dirtyMask.resize(qMax(row + 1, dirtyMask.size() * 2));
+        }
+        dirtyMask.setBit(row);
+    }
+    dirtyRows.swap(shifted);
+    if (dirtyRows.isEmpty()) {
+        frameTimer->stop();
+    }
+}
+
+void RefreshScheduler::clear()
+{
+    frameTimer->stop();
+    dirtyRows.clear();
+    dirtyMask.fill(false);
+}
+
+bool RefreshScheduler::isVisible(int row) const
+{
+    return visibleFirst < 0 || (row >= visibleFirst && row <= visibleLast);
+}
+
+void RefreshScheduler::flush()
+{
+    if (dirtyRows.isEmpty()) {
+        return;
+    }
+
+    std::sort(dirtyRows.begin(), dirtyRows.end());
+
+    // Görünmeyen satırlar kirli kalır; kaydırıldıklarında gönderilir
+    QVector<int> pending;
+    int first = -1;
+    int last = -1;
+    for (int row : dirtyRows) {
+        if (!isVisible(row)) {
+            pending.append(row);
+            continue;
+        }
+        dirtyMask.clearBit(row);
+        if (first >= 0 && row == last + 1) {
+            last = row;
+            continue;
+        }
+        if (first >= 0) {
+            emit rowsReady(first, last);
+        }
+        first = last = row;
+    }
+    if (first >= 0) {
+        emit rowsReady(first, last);
+    }
+
+    dirtyRows.swap(pending);
+}
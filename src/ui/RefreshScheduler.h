@@ -0,0 +1,55 @@
+#ifndef REFRESH_SCHEDULER_H
+#define REFRESH_SCHEDULER_H
+
+#include <QObject>
+#include <QVector>
+#include <QBitArray>
+
+class QTimer;
+
+// Bir kare boyunca kirlenen satırları toplar ve kare sonunda yalnızca
+// görünür aralıkla kesişenleri ardışık aralıklar halinde bildirir.
+// Bildirim hızı kare aralığıyla sınırlıdır (varsayılan ~60 Hz).
+class RefreshScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RefreshScheduler(QObject* parent = nullptr);
+
+    // Kare aralığı (ms)
+    void setInterval(int ms);
+    int interval() const;
+
+    // Görünür satır aralığı; first < 0 ise tüm satırlar görünür sayılır
+    void setVisibleRange(int first, int last);
+
+    void markDirty(int row);
+    void markDirty(int first, int last);
+
+    // Satır eklenip silindiğinde bekleyen satırları yeni indekslerine taşır;
+    // silinen satırların bekleyenleri düşer
+    void insertRows(int first, int count);
+    void removeRows(int first, int count);
+
+    // Tüm satırlar geçersizleştiğinde (reset) bekleyenleri at
+    void clear();
+
+signals:
+    // Görünür ve kirli ardışık satır aralığı
+    void rowsReady(int first, int last);
+
+private slots:
+    void flush();
+
+private:
+    QTimer* frameTimer;
+    QVector<int> dirtyRows;     // Sırasız; tekrarları dirtyMask engeller
+    QBitArray dirtyMask;
+    int visibleFirst;
+    int visibleLast;
+
+    bool isVisible(int row) const;
+    void shiftRows(int first, int delta);
+};
+
+#endif // REFRESH_SCHEDULER_H
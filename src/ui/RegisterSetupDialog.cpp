@@ -41,7 +41,9 @@ void RegisterSetupDialog::setupUi()
         {ModbusTypes::DataType::REAL, 6},
         {ModbusTypes::DataType::LREAL, 7},
         {ModbusTypes::DataType::STRING, 8},
-        {ModbusTypes::DataType::WSTRING, 9}
+        {ModbusTypes::DataType::WSTRING, 9},
+        {ModbusTypes::DataType::LINT, 10},
+        {ModbusTypes::DataType::ULINT, 11}
     };
 
     // Register type mapping
@@ -143,7 +145,9 @@ void RegisterSetupDialog::setupDataTypeLimits()
         {ModbusTypes::DataType::REAL, {-3.4e38, 3.4e38, 6}},
         {ModbusTypes::DataType::LREAL, {-1.7e308, 1.7e308, 15}},
         {ModbusTypes::DataType::STRING, {0, 0, 0}},  // String için sınır yok
-        {ModbusTypes::DataType::WSTRING, {0, 0, 0}}  // WString için sınır yok
+        {ModbusTypes::DataType::WSTRING, {0, 0, 0}},  // WString için sınır yok
+        {ModbusTypes::DataType::LINT, {-9.2e18, 9.2e18, 0}},
+        {ModbusTypes::DataType::ULINT, {0, 1.8e19, 0}}
     };
 }
 
@@ -161,6 +165,8 @@ void RegisterSetupDialog::populateComboBoxes()
     ui->dataTypeCombo->addItem("LREAL", static_cast<int>(ModbusTypes::DataType::LREAL));
     ui->dataTypeCombo->addItem("STRING", static_cast<int>(ModbusTypes::DataType::STRING));
     ui->dataTypeCombo->addItem("WSTRING", static_cast<int>(ModbusTypes::DataType::WSTRING));
+    ui->dataTypeCombo->addItem("LINT", static_cast<int>(ModbusTypes::DataType::LINT));
+    ui->dataTypeCombo->addItem("ULINT", static_cast<int>(ModbusTypes::DataType::ULINT));
 
     // Register type combo
     ui->registerTypeCombo->clear();
@@ -391,7 +397,9 @@ void RegisterSetupDialog::updateDataTypeUI()
                          currentConfig.dataType == ModbusTypes::DataType::DWORD ||
                          currentConfig.dataType == ModbusTypes::DataType::DINT ||
                          currentConfig.dataType == ModbusTypes::DataType::REAL ||
-                         currentConfig.dataType == ModbusTypes::DataType::LREAL);
+                         currentConfig.dataType == ModbusTypes::DataType::LREAL ||
+                         currentConfig.dataType == ModbusTypes::DataType::LINT ||
+                         currentConfig.dataType == ModbusTypes::DataType::ULINT);
     
     ui->byteOrderLabel->setVisible(showByteOrder);
     ui->byteOrderCombo->setVisible(showByteOrder);
@@ -606,6 +614,8 @@ QString RegisterSetupDialog::getDataTypeString(ModbusTypes::DataType type) const
         case ModbusTypes::DataType::LREAL: return "LREAL";
         case ModbusTypes::DataType::STRING: return "STRING";
         case ModbusTypes::DataType::WSTRING: return "WSTRING";
+        case ModbusTypes::DataType::LINT: return "LINT";
+        case ModbusTypes::DataType::ULINT: return "ULINT";
         default: return "UNKNOWN";
     }
 }
@@ -1,11 +1,16 @@
 #include "RegisterTableModel.h"
 #include "ModbusRegister.h"
+#include "RegisterCodec.h"
+#include "Csv.h"
 #include <QDateTime>
 #include <QColor>
 #include <QFont>
 #include <QFile>
-#include <QTextStream>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QDebug>
+#include <algorithm>
+#include <cstring>
 
 RegisterTableModel::RegisterTableModel(QObject* parent)
     : QAbstractTableModel(parent)
@@ -15,6 +20,11 @@ RegisterTableModel::RegisterTableModel(QObject* parent)
     , highlightAlarms(true)
 {
     setupViewConstants();
+
+    refreshScheduler = new RefreshScheduler(this);
+    connect(refreshScheduler, &RefreshScheduler::rowsReady, this, [this](int first, int last) {
+        emit dataChanged(index(first, 0), index(last, COLUMN_COUNT - 1));
+    });
     
     connect(this, &RegisterTableModel::formatChanged, this, &RegisterTableModel::onFormatChanged);
 }
@@ -112,6 +122,8 @@ bool RegisterTableModel::validateRegisterConfig(const ModbusTypes::RegisterConfi
         case ModbusTypes::DataType::LREAL:
         case ModbusTypes::DataType::STRING:
         case ModbusTypes::DataType::WSTRING:
+        case ModbusTypes::DataType::LINT:
+        case ModbusTypes::DataType::ULINT:
             break;
         default:
             return false;
@@ -137,6 +149,12 @@ bool RegisterTableModel::validateRegisterConfig(const ModbusTypes::RegisterConfi
         }
     }
 
+    // Metin uzunluğu tek okuma isteğine sığmalı
+    if (RegisterCodec::isText(config.dataType) &&
+        (config.stringLength < 1 || config.stringLength > ModbusTypes::MAX_STRING_WORDS)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -163,10 +181,12 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
     }
 
     int address = sortedAddresses[index.row()];
-    const auto& regData = registers[address];
-    if (!regData.reg) {
+    auto it = registers.constFind(address);
+    if (it == registers.constEnd() || !it->reg) {
         return QVariant();
     }
+    const RegisterData& regData = *it;
+    refreshRowCache(address, regData);
 
     switch (role) {
         case Qt::DisplayRole:
@@ -180,13 +200,7 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
                     return regData.reg->getName();
                 
                 case Column::VALUE:
-                {
-                    QVariant rawValue = regData.reg->getValue();
-                    qDebug() << "VALUE gösteriliyor: adres =" << address << ", değer =" << rawValue << ", format =" << formatToString(regData.format);
-                    QString formattedValue = formatValue(rawValue, regData.format);
-                    qDebug() << "Formatlanmış değer: " << formattedValue;
-                    return formattedValue;
-                }
+                    return regData.cachedText;
                 
                 case Column::FORMAT:
                     return formatToString(regData.format);
@@ -213,19 +227,24 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
                     return regData.reg->getDescription();
                 
                 case Column::LAST_UPDATE:
-                    return showTimestamps ? 
-                           formatDateTime(regData.reg->getLastUpdateTime()) : 
-                           QString();
+                {
+                    if (!showTimestamps) {
+                        return QString();
+                    }
+                    return formatDateTime(regData.cachedTimestamp > 0 ?
+                                          QDateTime::fromMSecsSinceEpoch(regData.cachedTimestamp) :
+                                          QDateTime());
+                }
                 
                 case Column::STATUS:
-                    return getStatusString(regData.reg.get());
+                    return regData.cachedStatus;
             }
             break;
 
         case Qt::EditRole:
             switch (index.column()) {
                 case Column::VALUE:
-                    return regData.reg->getValue();
+                    return regData.cachedValue;
                 
                 case Column::FORMAT:
                     return formatToString(regData.format);
@@ -264,10 +283,10 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
             break;
 
         case Qt::BackgroundRole:
-            if (!regData.reg->isValid() && index.column() == Column::VALUE) {
+            if (!regData.cachedValid && index.column() == Column::VALUE) {
                 return viewConst.invalidColor;
             }
-            if (highlightAlarms && regData.reg->isInAlarmState()) {
+            if (highlightAlarms && regData.cachedAlarm) {
                 return viewConst.alarmColor;
             }
             if (regData.reg->isReadOnly() && index.column() == Column::VALUE) {
@@ -276,17 +295,17 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
             return viewConst.validColor;
 
         case Qt::ForegroundRole:
-            if (!regData.reg->isValid() && index.column() == Column::VALUE) {
+            if (!regData.cachedValid && index.column() == Column::VALUE) {
                 return QColor(Qt::red);
             }
-            if (regData.reg->isInAlarmState()) {
+            if (regData.cachedAlarm) {
                 return QColor(Qt::darkRed);
             }
             return QColor(Qt::black);
 
         case Qt::FontRole:
             if (index.column() == Column::ADDRESS || 
-                (regData.reg->isInAlarmState() && index.column() == Column::VALUE)) {
+                (regData.cachedAlarm && index.column() == Column::VALUE)) {
                 return viewConst.boldFont;
             }
             return viewConst.normalFont;
@@ -295,14 +314,14 @@ QVariant RegisterTableModel::data(const QModelIndex& index, int role) const
             switch (index.column()) {
                 case Column::VALUE:
                     return QString("Raw: %1\nScaled: %2")
-                            .arg(regData.reg->getValue().toString())
-                            .arg(regData.reg->getScaledValue().toString());
+                            .arg(regData.cachedValue.toString())
+                            .arg(regData.cachedScaled.toString());
                 
                 case Column::STATUS:
-                    if (!regData.reg->isValid()) {
+                    if (!regData.cachedValid) {
                         return tr("Invalid value");
                     }
-                    if (regData.reg->isInAlarmState()) {
+                    if (regData.cachedAlarm) {
                         return tr("Alarm: Value out of range");
                     }
                     return tr("Valid");
@@ -678,6 +697,7 @@ bool RegisterTableModel::setData(const QModelIndex& index, const QVariant& value
     }
 
     if (success) {
+        invalidateRow(address);
         emit dataChanged(index, index);
         emit registerUpdated(address);
     }
@@ -699,23 +719,38 @@ bool RegisterTableModel::addRegister(const ModbusTypes::RegisterConfig& config)
         return false;
     }
     
+    registers[config.address] = createRegisterData(config);
+    
+    // Sıralı konuma ekle; sonraki satırların indeksi bir kayar
+    auto pos = std::lower_bound(sortedAddresses.begin(), sortedAddresses.end(), config.address);
+    int row = static_cast<int>(pos - sortedAddresses.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    sortedAddresses.insert(row, config.address);
+    for (int i = row; i < sortedAddresses.size(); ++i) {
+        addressRows[sortedAddresses[i]] = i;
+    }
+    refreshScheduler->insertRows(row, 1);
+    endInsertRows();
+    
+    emit registerAdded(config.address);
+    emit configurationChanged();
+    
+    return true;
+}
+
+RegisterTableModel::RegisterData RegisterTableModel::createRegisterData(const ModbusTypes::RegisterConfig& config)
+{
     RegisterData regData;
     regData.reg = std::make_shared<ModbusRegister>(config);
+    regData.codec = &RegisterCodec::codecFor(config.dataType, config.byteOrder);
     regData.format = DisplayFormat::DEC;
-    registers[config.address] = regData;
-    
+
     connect(regData.reg.get(), &ModbusRegister::valueChanged,
             this, [this, address = config.address](const QVariant& value) {
+                invalidateRow(address);
                 emit valueChanged(address, value);  // registerValueChanged yerine valueChanged kullanıyoruz
             });
-    
-    sortedAddresses.append(config.address);
-    std::sort(sortedAddresses.begin(), sortedAddresses.end());
-    
-    emit registerAdded(config.address);
-    emit configurationChanged();
-    
-    return true;
+    return regData;
 }
 
 bool RegisterTableModel::removeRegister(int address)
@@ -731,7 +766,12 @@ bool RegisterTableModel::removeRegister(int address)
 
     beginRemoveRows(QModelIndex(), row, row);
     registers.remove(address);
-    sortedAddresses.removeOne(address);
+    sortedAddresses.remove(row);
+    addressRows.remove(address);
+    for (int i = row; i < sortedAddresses.size(); ++i) {
+        addressRows[sortedAddresses[i]] = i;
+    }
+    refreshScheduler->removeRows(row, 1);
     endRemoveRows();
 
     emit registerRemoved(address);
@@ -754,6 +794,8 @@ bool RegisterTableModel::updateRegister(int address, const ModbusTypes::Register
     }
     
     regData.reg->updateConfig(config);
+    regData.codec = &RegisterCodec::codecFor(config.dataType, config.byteOrder);
+    ++regData.generation;
     emit registerUpdated(address);
     emit configurationChanged();
     
@@ -793,10 +835,8 @@ bool RegisterTableModel::setValue(int address, const QVariant& value)
     }
     
     if (regData.reg->setValue(value)) {
-        int row = addressToRow(address);
-        if (row >= 0) {
-            emit dataChanged(index(row, Column::VALUE), index(row, Column::STATUS));
-        }
+        ++regData.generation;
+        refreshScheduler->markDirty(addressToRow(address));
         return true;
     }
     
@@ -805,6 +845,19 @@ bool RegisterTableModel::setValue(int address, const QVariant& value)
 
 QVariant RegisterTableModel::getValue(int address) const
 {
+    // Cihaza bağlıysa değer kilitsiz olarak kopyadan okunur
+    auto it = registers.constFind(address);
+    TagTable::Sample sample;
+    if (it != registers.constEnd() && it->codec && readTagSample(address, sample)) {
+        if (sample.quality != TagTable::QUALITY_GOOD) {
+            return QVariant();
+        }
+        if (showScaledValues && it->codec->scaled) {
+            return sample.scaled;
+        }
+        return sampleValue(address, *it->codec, sample);
+    }
+
     QMutexLocker locker(&registerMutex);
     
     if (registers.contains(address) && registers[address].reg) {
@@ -817,6 +870,11 @@ QVariant RegisterTableModel::getValue(int address) const
 
 bool RegisterTableModel::isValid(int address) const
 {
+    TagTable::Sample sample;
+    if (readTagSample(address, sample)) {
+        return sample.quality == TagTable::QUALITY_GOOD;
+    }
+
     QMutexLocker locker(&registerMutex);
     
     if (registers.contains(address) && registers[address].reg) {
@@ -831,18 +889,30 @@ void RegisterTableModel::clear()
         beginResetModel();
         registers.clear();
         sortedAddresses.clear();
+        addressRows.clear();
+        refreshScheduler->clear();
         endResetModel();
     }
 }
 
 void RegisterTableModel::updateAll()
 {
+    invalidateAllRows();
     if (!registers.isEmpty()) {
-        emit dataChanged(index(0, 0), 
-                        index(sortedAddresses.size() - 1, COLUMN_COUNT - 1));
+        refreshScheduler->markDirty(0, sortedAddresses.size() - 1);
     }
 }
 
+void RegisterTableModel::setVisibleRows(int first, int last)
+{
+    refreshScheduler->setVisibleRange(first, last);
+}
+
+void RegisterTableModel::setRefreshInterval(int ms)
+{
+    refreshScheduler->setInterval(ms);
+}
+
 void RegisterTableModel::invalidateAll()
 {
     for (auto& regData : registers) {
@@ -858,6 +928,7 @@ void RegisterTableModel::setShowScaledValues(bool show)
 {
     if (showScaledValues != show) {
         showScaledValues = show;
+        invalidateAllRows();
         // Sadece değer sütununu güncelle
         if (!registers.isEmpty()) {
             emit dataChanged(index(0, Column::VALUE),
@@ -902,39 +973,179 @@ void RegisterTableModel::setHighlightAlarms(bool highlight)
     }
 }
 
+void RegisterTableModel::setTagTable(std::shared_ptr<const TagTable> table)
+{
+    tagTable = table;
+    snapshot = tagTable ? tagTable->snapshot() : std::shared_ptr<const TagTable::Snapshot>();
+    updateAll();
+}
+
+bool RegisterTableModel::readTagSample(int address, TagTable::Sample& sample) const
+{
+    if (!snapshot) {
+        return false;
+    }
+    return snapshot->read(snapshot->idForAddress(address), sample);
+}
+
+// Metinler sample'a sığmaz; kopyadaki metin sütunundan okunur
+QVariant RegisterTableModel::sampleValue(int address, const RegisterCodec::Codec& codec,
+                                         const TagTable::Sample& sample) const
+{
+    if (codec.text) {
+        return snapshot->text(snapshot->idForAddress(address));
+    }
+    return codec.toVariant(codec.load(sample.words));
+}
+
+void RegisterTableModel::refreshRowCache(int address, const RegisterData& regData) const
+{
+    if (regData.cachedGeneration == regData.generation) {
+        return;
+    }
+
+    // Cihaza bağlı tag'ler yayınlanmış kopyadan kilitsiz okunur; aksi halde
+    // register'a bir kez sorulur ve sonuç generation değişene kadar tutulur
+    TagTable::Sample sample;
+    if (regData.codec && readTagSample(address, sample)) {
+        regData.cachedValid = (sample.quality == TagTable::QUALITY_GOOD);
+        regData.cachedAlarm = regData.cachedValid && sample.alarmFlags != TagTable::ALARM_NONE;
+        regData.cachedTimestamp = sample.timestamp;
+        if (regData.cachedValid) {
+            regData.cachedValue = sampleValue(address, *regData.codec, sample);
+            regData.cachedScaled = regData.codec->scaled ? QVariant(sample.scaled) : regData.cachedValue;
+            regData.cachedText = formatValue(regData.cachedValue, regData.format);
+        } else {
+            regData.cachedValue = QVariant();
+            regData.cachedScaled = QVariant();
+            regData.cachedText = QString("---");
+        }
+    } else {
+        QDateTime updated = regData.reg->getLastUpdateTime();
+        regData.cachedValid = regData.reg->isValid();
+        regData.cachedAlarm = regData.reg->isInAlarmState();
+        regData.cachedTimestamp = updated.isValid() ? updated.toMSecsSinceEpoch() : 0;
+        regData.cachedValue = regData.reg->getValue();
+        regData.cachedScaled = regData.reg->getScaledValue();
+        regData.cachedText = formatValue(regData.cachedValue, regData.format);
+    }
+
+    if (!regData.cachedValid) {
+        regData.cachedStatus = tr("Invalid");
+    } else {
+        regData.cachedStatus = regData.cachedAlarm ? tr("Alarm") : tr("Valid");
+    }
+    regData.cachedGeneration = regData.generation;
+}
+
+void RegisterTableModel::invalidateRow(int address)
+{
+    auto it = registers.find(address);
+    if (it != registers.end()) {
+        ++it->generation;
+    }
+}
+
+void RegisterTableModel::invalidateAllRows()
+{
+    for (auto& regData : registers) {
+        ++regData.generation;
+    }
+}
+
 bool RegisterTableModel::importFromCsv(const QString& filename)
 {
     QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         emit error(tr("Cannot open file: %1").arg(filename));
         return false;
     }
 
-    QTextStream in(&file);
-    
+    // Dosya mümkünse belleğe eşlenir, değilse tek seferde okunur
+    QByteArray content;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (uchar* mapped = file.size() > 0 ? file.map(0, file.size()) : nullptr) {
+        begin = reinterpret_cast<const char*>(mapped);
+        end = begin + file.size();
+    } else {
+        content = file.readAll();
+        begin = content.constData();
+        end = begin + content.size();
+    }
+    if (end - begin >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        begin += 3;  // UTF-8 BOM
+    }
+
     // Header'ı oku ve doğrula
-    QString headerLine = in.readLine();
-    QStringList expectedHeaders = prepareCsvHeader();
-    QStringList actualHeaders = headerLine.split(',');
-    
-    if (actualHeaders != expectedHeaders) {
+    QStringList actualHeaders;
+    Csv::readRecord(begin, end, actualHeaders);
+    // Deadband ve StringLength sonradan eklendi; bu sütunları olmayan
+    // dosyalar da kabul edilir (eksik alanlar varsayılan değeri alır)
+    const QStringList expectedHeaders = prepareCsvHeader();
+    if (actualHeaders.size() < CSV_REQUIRED_COLUMNS ||
+        actualHeaders != expectedHeaders.mid(0, actualHeaders.size())) {
         emit error(tr("Invalid CSV header format"));
         return false;
     }
 
-    // Mevcut register'ları temizle
-    clear();
+    // Kayıt sınırına hizalı parçalar paralel olarak yapılandırmalara çevrilir
+    struct ParsedChunk {
+        Csv::Chunk chunk;
+        QVector<ModbusTypes::RegisterConfig> configs;
+        QStringList errors;
+    };
 
-    // Satır satır oku ve register'ları ekle
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList fields = line.split(',');
-        
-        if (!parseCsvRecord(fields)) {
-            emit error(tr("Error parsing CSV record: %1").arg(line));
-            continue;
+    QVector<ParsedChunk> parsed;
+    for (const Csv::Chunk& chunk : Csv::splitRecords(begin, end, QThread::idealThreadCount() * 4)) {
+        ParsedChunk item;
+        item.chunk = chunk;
+        parsed.append(item);
+    }
+
+    QtConcurrent::blockingMap(parsed, [this](ParsedChunk& item) {
+        const char* pos = item.chunk.begin;
+        QStringList fields;
+        while (Csv::readRecord(pos, item.chunk.end, fields)) {
+            if (Csv::isBlankRecord(fields)) {
+                continue;
+            }
+            ModbusTypes::RegisterConfig config;
+            if (parseCsvRecord(fields, config) && validateRegisterConfig(config)) {
+                item.configs.append(config);
+            } else {
+                item.errors.append(fields.join(','));
+            }
         }
+    });
+
+    // Tek bir model reset'i içinde toplu ekleme
+    QStringList errors;
+    beginResetModel();
+    {
+        QMutexLocker locker(&registerMutex);
+        registers.clear();
+        for (const ParsedChunk& item : parsed) {
+            for (const ModbusTypes::RegisterConfig& config : item.configs) {
+                if (registers.contains(config.address)) {
+                    errors.append(tr("Duplicate register address: %1").arg(config.address));
+                    continue;
+                }
+                registers.insert(config.address, createRegisterData(config));
+            }
+            for (const QString& line : item.errors) {
+                errors.append(tr("Error parsing CSV record: %1").arg(line));
+            }
+        }
+        updateSortedAddresses();
+        refreshScheduler->clear();
     }
+    endResetModel();
+
+    for (const QString& message : errors) {
+        emit error(message);
+    }
+    emit configurationChanged();
 
     return true;
 }
@@ -949,24 +1160,32 @@ bool RegisterTableModel::exportToCsv(const QString& filename) const
         return false;
     }
 
-    QTextStream out(&file);
-
-    // Header'ı yaz
-    QStringList headers = prepareCsvHeader();
-    out << headers.join(',') << "\n";
+    Csv::Writer writer(&file);
+    writer.writeRecord(prepareCsvHeader());
 
     // Her register için bir satır yaz
-    for (int address : sortedAddresses) {
-        QStringList record = prepareCsvRecord(address);
-        out << record.join(',') << "\n";
+    {
+        QMutexLocker locker(&registerMutex);
+        for (int address : sortedAddresses) {
+            auto it = registers.constFind(address);
+            if (it != registers.constEnd() && it->reg) {
+                writer.writeRecord(prepareCsvRecord(it->reg->getConfig()));
+            }
+        }
     }
 
+    if (!writer.flush()) {
+        const_cast<RegisterTableModel*>(this)->error(
+            tr("Error writing file: %1").arg(filename));
+        return false;
+    }
     return true;
 }
 
 void RegisterTableModel::onFormatChanged(int address, DisplayFormat format)
 {
-    qDebug() << "onFormatChanged: adres =" << address << ", format =" << formatToString(format);
+    Q_UNUSED(format);
+    invalidateRow(address);
     
     int row = addressToRow(address);
     if (row >= 0) {
@@ -976,6 +1195,7 @@ void RegisterTableModel::onFormatChanged(int address, DisplayFormat format)
 
 void RegisterTableModel::onRegisterAlarmStateChanged(int address, bool inAlarm)
 {
+    invalidateRow(address);
     int row = addressToRow(address);
     if (row >= 0) {
         // Durum sütununu ve muhtemelen arka plan rengini güncelle
@@ -987,17 +1207,41 @@ void RegisterTableModel::onRegisterAlarmStateChanged(int address, bool inAlarm)
 
 void RegisterTableModel::onRegisterValueChanged(int address, const QVariant& value)
 {
+    invalidateRow(address);
     int row = addressToRow(address);
     if (row >= 0) {
-        // Değer ve durum sütunlarını güncelle
-        emit dataChanged(index(row, Column::VALUE),
-                        index(row, Column::STATUS));
+        refreshScheduler->markDirty(row);
         emit valueChanged(address, value);
     }
 }
 
+void RegisterTableModel::onBlockUpdated(const QString& deviceName, const QBitArray& changedTags)
+{
+    Q_UNUSED(deviceName);
+
+    if (!tagTable) {
+        return;
+    }
+
+    // Poller'ın bu döngü için yayınladığı kopyayı al; data() bir sonraki
+    // yayına kadar yalnızca bu kopyayı okur
+    snapshot = tagTable->snapshot();
+
+    // Değişen tag'leri kirli satır olarak işaretle; yayın kare sonunda yapılır
+    const int count = qMin(changedTags.size(), snapshot->size());
+    for (int id = 0; id < count; ++id) {
+        if (!changedTags.testBit(id)) {
+            continue;
+        }
+        int address = snapshot->addresses[id];
+        invalidateRow(address);
+        refreshScheduler->markDirty(addressToRow(address));
+    }
+}
+
 void RegisterTableModel::onRegisterConfigChanged(int address)
 {
+    invalidateRow(address);
     int row = addressToRow(address);
     if (row >= 0) {
         // Tüm sütunları güncelle çünkü herhangi bir özellik değişmiş olabilir
@@ -1013,19 +1257,11 @@ QStringList RegisterTableModel::prepareCsvHeader() const
         << "Address" << "Name" << "Type" << "Access" 
         << "Scale" << "Unit" << "MinValue" << "MaxValue" 
         << "Description" << "AlarmEnabled" << "AlarmLowLimit" 
-        << "AlarmHighLimit" << "ByteOrder";
+        << "AlarmHighLimit" << "ByteOrder" << "Deadband" << "StringLength";
 }
 
-QStringList RegisterTableModel::prepareCsvRecord(int address) const
+QStringList RegisterTableModel::prepareCsvRecord(const ModbusTypes::RegisterConfig& config) const
 {
-    QMutexLocker locker(&registerMutex);
-    
-    const auto& regData = registers[address];
-    if (!regData.reg) {
-        return QStringList();
-    }
-
-    const auto& config = regData.reg->getConfig();
     return QStringList()
         << QString::number(config.address)
         << config.name
@@ -1039,14 +1275,15 @@ QStringList RegisterTableModel::prepareCsvRecord(int address) const
         << (config.isAlarmEnabled ? "1" : "0")
         << QString::number(config.alarmLowLimit)
         << QString::number(config.alarmHighLimit)
-        << QString::number(static_cast<int>(config.byteOrder));
+        << QString::number(static_cast<int>(config.byteOrder))
+        << QString::number(config.deadband)
+        << QString::number(config.stringLength);
 }
 
-bool RegisterTableModel::parseCsvRecord(const QStringList& fields)
+bool RegisterTableModel::parseCsvRecord(const QStringList& fields, ModbusTypes::RegisterConfig& config)
 {
-    if (fields.size() < 13) return false;
+    if (fields.size() < CSV_REQUIRED_COLUMNS) return false;
 
-    ModbusTypes::RegisterConfig config;
     bool ok;
 
     // Temel alanları parse et
@@ -1083,13 +1320,32 @@ bool RegisterTableModel::parseCsvRecord(const QStringList& fields)
     config.byteOrder = static_cast<ModbusTypes::ByteOrder>(fields[12].toInt(&ok));
     if (!ok) return false;
 
-    // Register'ı ekle
-    return addRegister(config);
+    // İsteğe bağlı sütunlar; boş ya da eksikse varsayılan kalır
+    if (fields.size() > 13 && !fields[13].isEmpty()) {
+        config.deadband = fields[13].toDouble(&ok);
+        if (!ok) return false;
+    }
+    if (fields.size() > 14 && !fields[14].isEmpty()) {
+        config.stringLength = fields[14].toInt(&ok);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void RegisterTableModel::updateSortedAddresses()
+{
+    // QMap anahtarları zaten sıralı
+    sortedAddresses = registers.keys().toVector();
+    addressRows.clear();
+    addressRows.reserve(sortedAddresses.size());
+    for (int row = 0; row < sortedAddresses.size(); ++row) {
+        addressRows.insert(sortedAddresses[row], row);
+    }
 }
 
 int RegisterTableModel::addressToRow(int address) const
 {
-    return sortedAddresses.indexOf(address);
+    return addressRows.value(address, -1);
 }
 
 int RegisterTableModel::rowToAddress(int row) const
@@ -1124,6 +1380,12 @@ QString RegisterTableModel::formatValue(const ModbusRegister* reg) const
         case ModbusTypes::DataType::DINT:
             return QString::number(value.toInt());
             
+        case ModbusTypes::DataType::LINT:
+            return QString::number(value.toLongLong());
+            
+        case ModbusTypes::DataType::ULINT:
+            return QString::number(value.toULongLong());
+            
         case ModbusTypes::DataType::REAL:
             return QString::number(value.toFloat(), 'f', 3);
             
@@ -1164,6 +1426,8 @@ QString RegisterTableModel::getDataTypeString(ModbusTypes::DataType type) const
         case ModbusTypes::DataType::LREAL: return "LREAL";
         case ModbusTypes::DataType::STRING: return "STRING";
         case ModbusTypes::DataType::WSTRING: return "WSTRING";
+        case ModbusTypes::DataType::LINT: return "LINT";
+        case ModbusTypes::DataType::ULINT: return "ULINT";
         default: return "UNKNOWN";
     }
 }
@@ -1410,6 +1674,7 @@ bool RegisterTableModel::setRegisterFormat(int address, DisplayFormat format)
     auto& regData = registers[address];
     if (regData.format != format) {
         regData.format = format;
+        ++regData.generation;
         int row = addressToRow(address);
         if (row >= 0) {
             emit dataChanged(index(row, Column::FORMAT), index(row, Column::FORMAT));
@@ -3,12 +3,17 @@
 
 #include "ModbusTypes.h"
 #include "ModbusRegister.h"
+#include "TagTable.h"
+#include "RegisterCodec.h"
+#include "RefreshScheduler.h"
 #include <QAbstractTableModel>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <QColor>
 #include <QFont>
 #include <QMutex>
+#include <QBitArray>
 #include <memory>
 
 class RegisterTableModel : public QAbstractTableModel {
@@ -88,6 +93,14 @@ public:
     void setShowHexAddresses(bool show);
     void setShowTimestamps(bool show);
     void setHighlightAlarms(bool highlight);
+
+    // Cihazın tag tablosu bağlanırsa değerler oradan okunur
+    void setTagTable(std::shared_ptr<const TagTable> table);
+
+    // Değer güncellemeleri kare başına bir kez ve yalnızca görünür satırlar için
+    // yayınlanır. Görünüm kaydırıldıkça setVisibleRows çağrılmalıdır (-1: tümü).
+    void setVisibleRows(int first, int last);
+    void setRefreshInterval(int ms);
     
     // Veri aktarımı
     bool importFromCsv(const QString& filename);
@@ -95,6 +108,8 @@ public:
 
 public slots:
     void onRegisterValueChanged(int address, const QVariant& value);
+    // ModbusDevice::blockUpdated için; bitler bağlı tag tablosunun id'leridir
+    void onBlockUpdated(const QString& deviceName, const QBitArray& changedTags);
     void onRegisterAlarmStateChanged(int address, bool inAlarm);
     void onRegisterConfigChanged(int address);
     void onFormatChanged(int address, DisplayFormat format);
@@ -113,13 +128,32 @@ private:
     // Register container
     struct RegisterData {
         std::shared_ptr<ModbusRegister> reg;
+        const RegisterCodec::Codec* codec;  // Kopyadaki word'leri çözmek için
         DisplayFormat format;
+        quint32 generation;             // Değer veya format değiştikçe artar
+
+        // data() önbelleği; generation eşleştiği sürece yeniden hesaplanmaz
+        mutable quint32 cachedGeneration;
+        mutable QString cachedText;
+        mutable QString cachedStatus;
+        mutable QVariant cachedValue;
+        mutable QVariant cachedScaled;
+        mutable qint64 cachedTimestamp;  // ms (epoch), 0 = yok
+        mutable bool cachedValid;
+        mutable bool cachedAlarm;
         
-        RegisterData() : format(DisplayFormat::DEC) {}
+        RegisterData() : codec(nullptr), format(DisplayFormat::DEC), generation(1),
+                         cachedGeneration(0), cachedTimestamp(0),
+                         cachedValid(false), cachedAlarm(false) {}
     };
     
     QMap<int, RegisterData> registers;
-    QVector<int> sortedAddresses;
+    QVector<int> sortedAddresses;       // Satır -> adres
+    QHash<int, int> addressRows;        // Adres -> satır
+    std::shared_ptr<const TagTable> tagTable;
+    // GUI thread'inin tuttuğu son kopya; data() yalnızca bunu okur
+    std::shared_ptr<const TagTable::Snapshot> snapshot;
+    RefreshScheduler* refreshScheduler;
     mutable QMutex registerMutex;
     QString lastError;
     
@@ -150,6 +184,13 @@ private:
     QString getDataTypeString(ModbusTypes::DataType type) const;
     QString getStatusString(const ModbusRegister* reg) const;
     bool validateRegisterConfig(const ModbusTypes::RegisterConfig& config) const;
+    bool readTagSample(int address, TagTable::Sample& sample) const;
+    QVariant sampleValue(int address, const RegisterCodec::Codec& codec,
+                         const TagTable::Sample& sample) const;
+    void refreshRowCache(int address, const RegisterData& regData) const;
+    void invalidateRow(int address);
+    void invalidateAllRows();
+    RegisterData createRegisterData(const ModbusTypes::RegisterConfig& config);
     
     // Data handling helpers
     QVariant getDisplayData(const ModbusRegister* reg, int column) const;
@@ -162,9 +203,11 @@ private:
     bool validateCellEdit(const ModbusRegister* reg, int column, const QVariant& value) const;
     
     // CSV helpers
+    static const int CSV_REQUIRED_COLUMNS = 13;    // Address .. ByteOrder
     QStringList prepareCsvHeader() const;
-    QStringList prepareCsvRecord(int address) const;
-    bool parseCsvRecord(const QStringList& fields);
+    QStringList prepareCsvRecord(const ModbusTypes::RegisterConfig& config) const;
+    // İş parçacıklarından çağrılır; üye duruma dokunmaz
+    static bool parseCsvRecord(const QStringList& fields, ModbusTypes::RegisterConfig& config);
     
     // Format helpers
     QString decimalToHex(const QVariant& value) const;
@@ -0,0 +1,334 @@
+#include "BinaryLog.h"
+#include <cstring>
+
+namespace BinaryLog {
+
+namespace {
+
+void putVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+quint64 zigzag(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+void putString(QByteArray& out, const QByteArray& utf8)
+{
+    putVarint(out, static_cast<quint64>(utf8.size()));
+    out.append(utf8);
+}
+
+void putRecord(QByteArray& out, RecordType type, const QByteArray& payload)
+{
+    out.append(static_cast<char>(type));
+    putVarint(out, static_cast<quint64>(payload.size()));
+    out.append(payload);
+}
+
+// Yük okuyucu; taşma durumunda ok false olur
+struct Reader {
+    const char* data;
+    int size;
+    int pos;
+    bool ok;
+
+    Reader(const char* data, int size) : data(data), size(size), pos(0), ok(true) {}
+
+    quint64 varint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= size) {
+                ok = false;
+                return 0;
+            }
+            const quint8 byte = static_cast<quint8>(data[pos++]);
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    quint8 byte()
+    {
+        if (pos >= size) {
+            ok = false;
+            return 0;
+        }
+        return static_cast<quint8>(data[pos++]);
+    }
+
+    QString string()
+    {
+        const quint64 length = varint();
+        if (!ok || length > static_cast<quint64>(size - pos)) {
+            ok = false;
+            return QString();
+        }
+        QString text = QString::fromUtf8(data + pos, static_cast<int>(length));
+        pos += static_cast<int>(length);
+        return text;
+    }
+
+    double real()
+    {
+        double value = 0.0;
+        if (size - pos < static_cast<int>(sizeof(value))) {
+            ok = false;
+            return value;
+        }
+        memcpy(&value, data + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+};
+
+} // namespace
+
+Encoder::Encoder()
+{
+    reset();
+}
+
+void Encoder::reset()
+{
+    formatIds.clear();
+    nextId = 1;
+    lastTimestamp = 0;
+    timeBasePending = true;
+}
+
+QByteArray Encoder::header()
+{
+    QByteArray out(HEADER_SIZE, '\0');
+    const quint32 magic = MAGIC;
+    const quint16 version = VERSION;
+    memcpy(out.data(), &magic, sizeof(magic));
+    memcpy(out.data() + 4, &version, sizeof(version));
+    return out;
+}
+
+qint64 Encoder::completeLength(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QByteArray data = file.readAll();
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    if (data.size() >= HEADER_SIZE) {
+        memcpy(&magic, data.constData(), sizeof(magic));
+        memcpy(&version, data.constData() + 4, sizeof(version));
+    }
+    if (magic != MAGIC || version != VERSION) {
+        return -1;
+    }
+
+    int position = HEADER_SIZE;
+    while (position < data.size()) {
+        Reader header(data.constData() + position, data.size() - position);
+        header.byte();
+        const quint64 length = header.varint();
+        if (!header.ok || length > static_cast<quint64>(header.size - header.pos)) {
+            break;
+        }
+        position += header.pos + static_cast<int>(length);
+    }
+    return position;
+}
+
+void Encoder::encode(const LogRecord& record, QByteArray& out)
+{
+    // Ekleme kipinde açılan dosyada önceki kayıtların zamanı bilinmez;
+    // farklar mutlak bir tabana göre başlar
+    if (timeBasePending) {
+        QByteArray base;
+        putVarint(base, zigzag(record.timestamp));
+        putRecord(out, TIME_BASE, base);
+        lastTimestamp = record.timestamp;
+        timeBasePending = false;
+    }
+
+    QByteArray payload;
+    putVarint(payload, zigzag(record.timestamp - lastTimestamp));
+    lastTimestamp = record.timestamp;
+    payload.append(static_cast<char>(record.level));
+
+    if (!record.format) {
+        putString(payload, record.contextText().toUtf8());
+        putString(payload, record.message.toUtf8());
+        putRecord(out, TEXT, payload);
+        return;
+    }
+
+    // Format dizgisi dosyada ilk kullanımda bir kez tanımlanır
+    const QPair<const void*, const void*> key(record.format, record.literalContext);
+    quint32 id = formatIds.value(key, 0);
+    if (id == 0) {
+        id = nextId++;
+        formatIds.insert(key, id);
+
+        QByteArray definition;
+        putVarint(definition, id);
+        putString(definition, record.literalContext ? QByteArray(record.literalContext) : QByteArray());
+        putString(definition, QByteArray(record.format));
+        putRecord(out, FORMAT, definition);
+    }
+
+    putVarint(payload, id);
+    payload.append(static_cast<char>(record.argCount));
+    for (int k = 0; k < record.argCount; ++k) {
+        const LogArg& arg = record.args[k];
+        payload.append(static_cast<char>(arg.type));
+        switch (arg.type) {
+            case LogArg::INT:
+                putVarint(payload, zigzag(arg.i));
+                break;
+            case LogArg::UINT:
+                putVarint(payload, arg.u);
+                break;
+            case LogArg::DOUBLE:
+                payload.append(reinterpret_cast<const char*>(&arg.d), sizeof(arg.d));
+                break;
+            case LogArg::LITERAL:
+                putString(payload, QByteArray(arg.s));
+                break;
+            case LogArg::STRING:
+                putString(payload, arg.text.toUtf8());
+                break;
+            default:
+                break;
+        }
+    }
+    putRecord(out, EVENT, payload);
+}
+
+Decoder::Decoder()
+    : position(0)
+    , lastTimestamp(0)
+{
+}
+
+bool Decoder::open(const QString& filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        lastError = QString("Cannot open %1: %2").arg(filename, file.errorString());
+        return false;
+    }
+    data = file.readAll();
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    if (data.size() >= HEADER_SIZE) {
+        memcpy(&magic, data.constData(), sizeof(magic));
+        memcpy(&version, data.constData() + 4, sizeof(version));
+    }
+    if (magic != MAGIC) {
+        lastError = QString("%1 is not a binary log").arg(filename);
+        return false;
+    }
+    if (version != VERSION) {
+        lastError = QString("Unsupported binary log version %1").arg(version);
+        return false;
+    }
+
+    position = HEADER_SIZE;
+    lastTimestamp = 0;
+    formats.clear();
+    return true;
+}
+
+bool Decoder::next(Entry& entry)
+{
+    while (position < data.size()) {
+        Reader header(data.constData() + position, data.size() - position);
+        const quint8 type = header.byte();
+        const quint64 length = header.varint();
+        if (!header.ok || length > static_cast<quint64>(header.size - header.pos)) {
+            return false;   // Yarım kalmış son kayıt
+        }
+
+        Reader payload(header.data + header.pos, static_cast<int>(length));
+        position += header.pos + static_cast<int>(length);
+
+        if (type == FORMAT) {
+            // TIME_BASE'siz eski dosyalarda kimlikler yeniden verilebilir; son tanım geçerlidir
+            const quint32 id = static_cast<quint32>(payload.varint());
+            Format format;
+            format.context = payload.string();
+            format.format = payload.string();
+            if (payload.ok) {
+                formats.insert(id, format);
+            }
+            continue;
+        }
+        if (type == TIME_BASE) {
+            // Yazıcı yeniden açıldı: yeni zaman tabanı, yeni format kimlikleri
+            const qint64 base = unzigzag(payload.varint());
+            if (payload.ok) {
+                lastTimestamp = base;
+                formats.clear();
+            }
+            continue;
+        }
+        if (type != EVENT && type != TEXT) {
+            continue;   // Bilinmeyen kayıt tipi atlanır
+        }
+
+        lastTimestamp += unzigzag(payload.varint());
+        entry.timestamp = lastTimestamp;
+        entry.level = payload.byte();
+
+        if (type == TEXT) {
+            entry.context = payload.string();
+            entry.format.clear();
+            entry.message = payload.string();
+            if (payload.ok) {
+                return true;
+            }
+            continue;
+        }
+
+        const Format format = formats.value(static_cast<quint32>(payload.varint()));
+        entry.context = format.context;
+        entry.format = format.format;
+        entry.message = format.format;
+        const int argCount = payload.byte();
+        for (int k = 0; k < argCount && payload.ok; ++k) {
+            QString value;
+            switch (payload.byte()) {
+                case LogArg::INT:     value = QString::number(unzigzag(payload.varint())); break;
+                case LogArg::UINT:    value = QString::number(payload.varint()); break;
+                case LogArg::DOUBLE:  value = QString::number(payload.real()); break;
+                case LogArg::LITERAL:
+                case LogArg::STRING:  value = payload.string(); break;
+                default: break;
+            }
+            entry.message = entry.message.arg(value);
+        }
+        if (payload.ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace BinaryLog
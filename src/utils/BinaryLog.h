@@ -0,0 +1,94 @@
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include "LogRing.h"
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+// Logger'ın ikili dosya biçimi. Metin yazıcıda oluşturulmaz; format
+// dizgisi dosyada bir kez tanımlanır, kayıtlar yalnızca kimliğini ve
+// paketlenmiş argümanları taşır. Okuma/süzme qmodbuslog aracıyla yapılır.
+//
+// Dosya: "QMBL" | u16 sürüm | u16 ayrılmış | kayıt*
+// Kayıt: u8 tip | varint yük uzunluğu | yük
+//   FORMAT: varint kimlik | dizgi bağlam | dizgi format
+//   EVENT:  zigzag zaman farkı (ms) | u8 seviye | varint format kimliği |
+//           u8 argüman sayısı | (u8 LogArg::Type | değer)*
+//   TEXT:   zigzag zaman farkı (ms) | u8 seviye | dizgi bağlam | dizgi mesaj
+//   TIME_BASE: zigzag mutlak zaman (ms, epoch)
+// Dizgi: varint uzunluk | UTF-8. Zaman farkı önceki kayda göredir.
+// Yazıcı her açılışta (ekleme dahil) önce TIME_BASE yazar; okuyucu zaman
+// tabanını ve format tablosunu bu kayıtta sıfırlar.
+namespace BinaryLog {
+
+const quint32 MAGIC = 0x4C424D51;   // "QMBL"
+const quint16 VERSION = 1;
+const int HEADER_SIZE = 8;
+
+enum RecordType : quint8 {
+    FORMAT = 1,
+    EVENT = 2,
+    TEXT = 3,
+    TIME_BASE = 4
+};
+
+// Yazıcı iş parçacığında kullanılır; iş parçacığı güvenli değildir
+class Encoder {
+public:
+    Encoder();
+
+    // Yeni oturum: format tablosu sıfırlanır, ilk kayıttan önce TIME_BASE yazılır
+    void reset();
+    static QByteArray header();
+    // Başlık ve tam kayıtların toplam uzunluğu; yarım kalmış son kayıt
+    // dışarıda kalır. Dosya ikili log değilse -1.
+    static qint64 completeLength(const QString& filename);
+
+    void encode(const LogRecord& record, QByteArray& out);
+
+private:
+    QHash<QPair<const void*, const void*>, quint32> formatIds;
+    quint32 nextId;
+    qint64 lastTimestamp;
+    bool timeBasePending;
+};
+
+// Çözülmüş kayıt
+struct Entry {
+    qint64 timestamp;       // ms (epoch)
+    quint8 level;
+    QString context;
+    QString format;         // TEXT kayıtlarında boş
+    QString message;        // Argümanlar yerleştirilmiş metin
+};
+
+class Decoder {
+public:
+    Decoder();
+
+    bool open(const QString& filename);
+    QString getLastError() const { return lastError; }
+
+    // Sıradaki kayıt; dosya bittiyse veya bozuksa false
+    bool next(Entry& entry);
+
+private:
+    struct Format {
+        QString context;
+        QString format;
+    };
+
+    QByteArray data;
+    int position;
+    qint64 lastTimestamp;
+    QHash<quint32, Format> formats;
+    QString lastError;
+};
+
+} // namespace BinaryLog
+
+#endif // BINARY_LOG_H
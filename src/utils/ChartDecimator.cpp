@@ -0,0 +1,153 @@
+#include "ChartDecimator.h"
+#include <cmath>
+
+ChartDecimator::ChartDecimator(qint64 windowMs, int columns)
+    : windowMs(qMax<qint64>(windowMs, 1))
+    , columnMs(1)
+{
+    setColumns(columns);
+}
+
+void ChartDecimator::setColumns(int columns)
+{
+    columnMs = qMax<qint64>(1, windowMs / qMax(columns, 1));
+}
+
+void ChartDecimator::setWindow(qint64 ms)
+{
+    const qint64 columnCount = qMax<qint64>(1, windowMs / columnMs);
+    windowMs = qMax<qint64>(ms, 1);
+    setColumns(static_cast<int>(columnCount));
+}
+
+void ChartDecimator::clear()
+{
+    columns.clear();
+    minQueue.clear();
+    maxQueue.clear();
+}
+
+bool ChartDecimator::append(qint64 timestamp, double value)
+{
+    if (std::isnan(value)) {
+        return false;
+    }
+
+    // Açık sütuna düşüyorsa yalnızca uç değerler güncellenir
+    if (!columns.empty() && timestamp < columns.back().end) {
+        Column& column = columns.back();
+        if (value < column.minY) {
+            column.minY = value;
+            column.minT = timestamp;
+        }
+        if (value > column.maxY) {
+            column.maxY = value;
+            column.maxT = timestamp;
+        }
+        return false;
+    }
+
+    Column column;
+    column.start = timestamp - timestamp % columnMs;
+    if (!columns.empty()) {
+        closeColumn(columns.back());
+        // Genişlik değiştiyse sütunlar üst üste binmesin
+        column.start = qMax(column.start, columns.back().end);
+    }
+    column.end = column.start + columnMs;
+    column.minT = column.maxT = timestamp;
+    column.minY = column.maxY = value;
+    columns.push_back(column);
+    return true;
+}
+
+void ChartDecimator::closeColumn(const Column& column)
+{
+    // Kapanan sütun kuyruklara bir kez girer; artık değişmez
+    while (!minQueue.empty() && minQueue.back().value >= column.minY) {
+        minQueue.pop_back();
+    }
+    minQueue.push_back({column.start, column.minY});
+
+    while (!maxQueue.empty() && maxQueue.back().value <= column.maxY) {
+        maxQueue.pop_back();
+    }
+    maxQueue.push_back({column.start, column.maxY});
+}
+
+int ChartDecimator::evict(qint64 cutoff)
+{
+    int removed = 0;
+    while (!columns.empty() && columns.front().end <= cutoff) {
+        const qint64 start = columns.front().start;
+        removed += pointCount(columns.front());
+        columns.pop_front();
+
+        if (!minQueue.empty() && minQueue.front().start == start) {
+            minQueue.pop_front();
+        }
+        if (!maxQueue.empty() && maxQueue.front().start == start) {
+            maxQueue.pop_front();
+        }
+    }
+    return removed;
+}
+
+int ChartDecimator::pointCount(const Column& column)
+{
+    return column.minY == column.maxY ? 1 : 2;
+}
+
+void ChartDecimator::appendPoints(const Column& column, QVector<QPointF>& out)
+{
+    if (column.minY == column.maxY) {
+        out.append(QPointF(column.minT, column.minY));
+    } else if (column.minT <= column.maxT) {
+        out.append(QPointF(column.minT, column.minY));
+        out.append(QPointF(column.maxT, column.maxY));
+    } else {
+        out.append(QPointF(column.maxT, column.maxY));
+        out.append(QPointF(column.minT, column.minY));
+    }
+}
+
+QVector<QPointF> ChartDecimator::points() const
+{
+    QVector<QPointF> out;
+    out.reserve(static_cast<int>(columns.size()) * 2);
+    for (const Column& column : columns) {
+        appendPoints(column, out);
+    }
+    return out;
+}
+
+void ChartDecimator::fillPoints(QVector<QPointF>& out, qint64 offset) const
+{
+    out.resize(0);
+    for (const Column& column : columns) {
+        const int first = out.size();
+        appendPoints(column, out);
+        for (int k = first; k < out.size(); ++k) {
+            out[k].rx() -= offset;
+        }
+    }
+}
+
+bool ChartDecimator::range(double& minY, double& maxY) const
+{
+    if (columns.empty()) {
+        return false;
+    }
+
+    // Kapanmış sütunlar kuyruk başında, açık sütun ayrıca
+    const Column& open = columns.back();
+    minY = open.minY;
+    maxY = open.maxY;
+    if (!minQueue.empty()) {
+        minY = qMin(minY, minQueue.front().value);
+    }
+    if (!maxQueue.empty()) {
+        maxY = qMax(maxY, maxQueue.front().value);
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef CHART_DECIMATOR_H
+#define CHART_DECIMATOR_H
+
+#include <QPointF>
+#include <QVector>
+#include <deque>
+
+// Canlı grafik için min/max seyreltici. Zaman penceresi piksel sütunlarına
+// bölünür; her sütun için yalnızca en küçük ve en büyük örnek tutulur, yani
+// seri en fazla sütun başına 2 nokta içerir. Pencere dışına düşen sütunlar
+// baştan atılır. Y aralığı monoton kuyruklarla örnek başına O(1) izlenir.
+class ChartDecimator {
+public:
+    explicit ChartDecimator(qint64 windowMs = 300000, int columns = 800);
+
+    // Sütun genişliği yalnızca bundan sonra açılan sütunlara uygulanır
+    void setColumns(int columns);
+    void setWindow(qint64 ms);
+    qint64 window() const { return windowMs; }
+
+    // Yeni sütun açıldıysa true
+    bool append(qint64 timestamp, double value);
+    // cutoff'tan önce biten sütunları atar; serinin başından silinecek
+    // nokta sayısını döndürür
+    int evict(qint64 cutoff);
+    void clear();
+
+    bool isEmpty() const { return columns.empty(); }
+    // Tüm noktalar, zaman sırasıyla
+    QVector<QPointF> points() const;
+    // Noktaları out'a yazar (x - offset); out'un kapasitesi korunur
+    void fillPoints(QVector<QPointF>& out, qint64 offset) const;
+    bool range(double& minY, double& maxY) const;
+
+private:
+    struct Column {
+        qint64 start;
+        qint64 end;             // Hariç
+        qint64 minT;
+        qint64 maxT;
+        double minY;
+        double maxY;
+    };
+
+    // Monoton kuyruk elemanı: sütun başlangıcı ve değeri
+    struct Extreme {
+        qint64 start;
+        double value;
+    };
+
+    qint64 windowMs;
+    qint64 columnMs;
+    std::deque<Column> columns;
+    std::deque<Extreme> minQueue;   // Artan
+    std::deque<Extreme> maxQueue;   // Azalan
+
+    void closeColumn(const Column& column);
+    static int pointCount(const Column& column);
+    static void appendPoints(const Column& column, QVector<QPointF>& out);
+};
+
+#endif // CHART_DECIMATOR_H
@@ -0,0 +1,180 @@
+#include "Csv.h"
+#include <QIODevice>
+#include <cstring>
+
+namespace Csv {
+
+namespace {
+
+inline bool isFieldEnd(char c)
+{
+    return c == ',' || c == '\n' || c == '\r';
+}
+
+// Alanın tırnaklanması gerekiyor mu?
+bool needsQuotes(const QByteArray& utf8)
+{
+    for (char c : utf8) {
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool readRecord(const char*& pos, const char* end, QStringList& fields)
+{
+    fields.clear();
+    if (pos >= end) {
+        return false;
+    }
+
+    QByteArray quoted;
+    for (;;) {
+        if (pos < end && *pos == '"') {
+            // Tırnaklı alan: "" tek tırnak olur, kapanış tırnağına kadar her şey alınır
+            ++pos;
+            quoted.clear();
+            for (;;) {
+                const char* quote = static_cast<const char*>(memchr(pos, '"', end - pos));
+                if (!quote) {
+                    // Kapanmamış tırnak: kalan veri alana aittir
+                    quoted.append(pos, static_cast<int>(end - pos));
+                    pos = end;
+                    break;
+                }
+                quoted.append(pos, static_cast<int>(quote - pos));
+                pos = quote + 1;
+                if (pos < end && *pos == '"') {
+                    quoted.append('"');
+                    ++pos;
+                    continue;
+                }
+                break;
+            }
+            // Kapanış tırnağından sonra ayraca kadar gelenler alana eklenir
+            const char* tail = pos;
+            while (pos < end && !isFieldEnd(*pos)) {
+                ++pos;
+            }
+            quoted.append(tail, static_cast<int>(pos - tail));
+            fields.append(QString::fromUtf8(quoted));
+        } else {
+            const char* start = pos;
+            while (pos < end && !isFieldEnd(*pos)) {
+                ++pos;
+            }
+            fields.append(QString::fromUtf8(start, static_cast<int>(pos - start)));
+        }
+
+        if (pos < end && *pos == ',') {
+            ++pos;
+            continue;
+        }
+
+        // Kayıt sonu: CRLF, LF veya tek CR
+        if (pos < end && *pos == '\r') {
+            ++pos;
+        }
+        if (pos < end && *pos == '\n') {
+            ++pos;
+        }
+        return true;
+    }
+}
+
+QVector<Chunk> splitRecords(const char* begin, const char* end, int maxChunks)
+{
+    QVector<Chunk> chunks;
+    if (begin >= end) {
+        return chunks;
+    }
+
+    const qint64 target = qMax<qint64>(1, (end - begin) / qMax(1, maxChunks));
+    const char* chunkStart = begin;
+    bool inQuotes = false;
+
+    // Tırnak durumunu izleyerek yalnızca tırnak dışındaki satır sonlarında böl
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == '"') {
+            inQuotes = !inQuotes;
+        } else if (*p == '\n' && !inQuotes && p + 1 - chunkStart >= target) {
+            chunks.append({chunkStart, p + 1});
+            chunkStart = p + 1;
+        }
+    }
+    if (chunkStart < end) {
+        chunks.append({chunkStart, end});
+    }
+    return chunks;
+}
+
+Writer::Writer(QIODevice* device, int bufferSize)
+    : device(device)
+    , capacity(qMax(1024, bufferSize))
+    , firstField(true)
+    , failed(false)
+{
+    buffer.reserve(capacity + 1024);
+}
+
+Writer::~Writer()
+{
+    flush();
+}
+
+void Writer::writeField(const QString& value)
+{
+    if (!firstField) {
+        buffer.append(',');
+    }
+    firstField = false;
+
+    const QByteArray utf8 = value.toUtf8();
+    if (!needsQuotes(utf8)) {
+        buffer.append(utf8);
+        return;
+    }
+
+    buffer.append('"');
+    for (char c : utf8) {
+        if (c == '"') {
+            buffer.append('"');
+        }
+        buffer.append(c);
+    }
+    buffer.append('"');
+}
+
+void Writer::writeRecord(const QStringList& fields)
+{
+    for (const QString& field : fields) {
+        writeField(field);
+    }
+    endRecord();
+}
+
+void Writer::endRecord()
+{
+    buffer.append("\r\n", 2);
+    firstField = true;
+    if (buffer.size() >= capacity) {
+        flush();
+    }
+}
+
+bool Writer::flush()
+{
+    if (buffer.isEmpty() || failed) {
+        return !failed;
+    }
+    if (device->write(buffer) != buffer.size()) {
+        failed = true;
+    }
+    buffer.resize(0);  // Ayrılan kapasite korunur
+    return !failed;
+}
+
+} // namespace Csv
@@ -0,0 +1,64 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QIODevice;
+
+// RFC 4180 CSV okuma/yazma yardımcıları.
+// Tırnaklı alanlarda virgül, satır sonu ve "" kaçışı desteklenir; CRLF ve LF
+// satır sonları kabul edilir. Metin UTF-8 olarak çözülür.
+namespace Csv {
+
+// Ham veri içinde kayıt sınırına hizalı bir aralık
+struct Chunk {
+    const char* begin;
+    const char* end;
+};
+
+// [pos, end) içinden bir kayıt okur ve pos'u sonraki kayda ilerletir.
+// Okunacak veri kalmadıysa false döner.
+bool readRecord(const char*& pos, const char* end, QStringList& fields);
+
+// Boş satır (tek ve boş alan) kontrolü
+inline bool isBlankRecord(const QStringList& fields)
+{
+    return fields.size() == 1 && fields.first().isEmpty();
+}
+
+// Veriyi en fazla maxChunks adet, kayıt sınırına hizalı parçaya böler.
+// Parçalar birbirinden bağımsız olarak (paralel) okunabilir.
+QVector<Chunk> splitRecords(const char* begin, const char* end, int maxChunks);
+
+// Tamponlu yazıcı: kayıtlar bellekte biriktirilir, tampon dolunca tek
+// seferde cihaza yazılır.
+class Writer {
+public:
+    explicit Writer(QIODevice* device, int bufferSize = 64 * 1024);
+    ~Writer();
+
+    void writeField(const QString& value);
+    void writeRecord(const QStringList& fields);
+    void endRecord();
+    bool flush();
+
+    // Yazma hatası olduysa true
+    bool hasError() const { return failed; }
+
+private:
+    QIODevice* device;
+    QByteArray buffer;
+    int capacity;
+    bool firstField;
+    bool failed;
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+};
+
+} // namespace Csv
+
+#endif // CSV_H
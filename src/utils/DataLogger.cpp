@@ -1,31 +1,30 @@
 #include "DataLogger.h"
 #include <QVBoxLayout>
-#include <QDir>
+#include <QResizeEvent>
+#include <QGuiApplication>
+#ifndef QT_NO_OPENGL
+#include <QOpenGLContext>
+#endif
 #include <QDebug>
 
 DataLogger::DataLogger(QWidget *parent)
     : QMainWindow(parent)
-    , saveTimer(new QTimer(this))
+    , recorder(new DataRecorder(QString(), this))
     , chart(new QChart())
     , chartView(new QChartView(chart))
     , axisX(new QDateTimeAxis)
+    , plotAxisX(new QValueAxis)
     , axisY(new QValueAxis)
+    , frameTimer(new QTimer(this))
+    , useOpenGL(openGLAvailable())
+    , timeBase(QDateTime::currentMSecsSinceEpoch())
 {
     setupUI();
 
-    // JSON kayıt dizinini oluştur
-    QString homeDir = QDir::homePath();
-    QString saveDir = homeDir + "/modbus_logs";
-    QDir().mkpath(saveDir);
-    
-    // Timestamp ile dosya adı oluştur
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm-ss");
-    logFilePath = saveDir + "/modbus_data_" + timestamp + ".json";
-
-    // Timer ayarları
-    saveTimer->setInterval(20000); // 20 saniye
-    connect(saveTimer, &QTimer::timeout, this, &DataLogger::saveToJson);
-    saveTimer->start();
+    frameTimer->setSingleShot(true);
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(FRAME_INTERVAL_MS);
+    connect(frameTimer, &QTimer::timeout, this, &DataLogger::renderFrame);
 
     // Pencere ayarları
     resize(800, 600);
@@ -34,8 +33,7 @@ DataLogger::DataLogger(QWidget *parent)
 
 DataLogger::~DataLogger()
 {
-    saveToJson(); // Son verileri kaydet
-    saveTimer->stop();
+    // Açık chunk'ları recorder kendi yıkıcısında mühürler
 }
 
 void DataLogger::setupUI()
@@ -49,6 +47,11 @@ void DataLogger::setupUI()
     axisX->setTitleText("Time");
     chart->addAxis(axisX, Qt::AlignBottom);
 
+    // Seriler gizli değer eksenine bağlanır; OpenGL yalnızca QValueAxis'i
+    // destekler. İki eksen her karede aynı aralığa ayarlanır.
+    plotAxisX->setVisible(false);
+    chart->addAxis(plotAxisX, Qt::AlignBottom);
+
     // Değer ekseni
     axisY->setTitleText("Value");
     chart->addAxis(axisY, Qt::AlignLeft);
@@ -61,65 +64,138 @@ void DataLogger::setupUI()
 void DataLogger::logData(int address, const QVariant& value, const QString& unit)
 {
     QDateTime timestamp = QDateTime::currentDateTime();
-    
-    // JSON verisi oluştur
-    QJsonObject dataPoint;
-    dataPoint["timestamp"] = timestamp.toString(Qt::ISODate);
-    dataPoint["address"] = address;
-    dataPoint["value"] = value.toDouble();
-    dataPoint["unit"] = unit;
-    
-    dataArray.append(dataPoint);
+    recorder->logData(address, value, unit);
 
     // Grafiği güncelle
     updateChart(address, value.toDouble(), timestamp);
 }
 
-void DataLogger::updateChart(int address, double value, const QDateTime& timestamp)
+DataLogger::Trace& DataLogger::traceFor(int address)
 {
+    auto it = traces.find(address);
+    if (it != traces.end()) {
+        return *it;
+    }
+
     // Her adres için ayrı seri oluştur
-    if (!dataSeries.contains(address)) {
-        QLineSeries* series = new QLineSeries();
-        series->setName(QString("Address %1").arg(address));
-        dataSeries[address] = series;
-        chart->addSeries(series);
-        series->attachAxis(axisX);
-        series->attachAxis(axisY);
+    Trace trace;
+    trace.series = new QLineSeries();
+    trace.series->setName(QString("Address %1").arg(address));
+    trace.series->setUseOpenGL(useOpenGL);
+    trace.decimator = ChartDecimator(WINDOW_MS, plotColumns());
+    chart->addSeries(trace.series);
+    trace.series->attachAxis(plotAxisX);
+    trace.series->attachAxis(axisY);
+    return *traces.insert(address, trace);
+}
+
+int DataLogger::plotColumns() const
+{
+    // Pencere henüz çizilmediyse makul bir genişlik varsay
+    const int width = static_cast<int>(chart->plotArea().width());
+    return width > 0 ? width : 800;
+}
+
+void DataLogger::updateChart(int address, double value, const QDateTime& timestamp)
+{
+    // Yalnızca decimator güncellenir; seri bir sonraki karede yazılır
+    Trace& trace = traceFor(address);
+    trace.decimator.append(timestamp.toMSecsSinceEpoch(), value);
+    trace.dirty = true;
+    if (!frameTimer->isActive()) {
+        frameTimer->start();
     }
+}
 
-    // Veriyi ekle
-    dataSeries[address]->append(timestamp.toMSecsSinceEpoch(), value);
+void DataLogger::renderFrame()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 cutoff = now - WINDOW_MS;
 
-    // Eksenleri güncelle
-    axisX->setRange(QDateTime::currentDateTime().addSecs(-300), QDateTime::currentDateTime());
-    
-    // Y ekseni otomatik ayarlanır
+    // float 24 bit mantis taşır; x değerleri 2^22 ms'yi geçmeden taban
+    // pencere başına çekilir ve tüm seriler yeni tabana göre yeniden yazılır
+    const bool rebase = (now - timeBase > TIME_BASE_LIMIT_MS);
+    if (rebase) {
+        timeBase = cutoff;
+    }
+
+    for (auto it = traces.begin(); it != traces.end(); ++it) {
+        Trace& trace = *it;
+        if (rebase) {
+            trace.dirty = true;
+        }
+        if (trace.decimator.evict(cutoff) > 0) {
+            trace.dirty = true;
+        }
+        if (!trace.dirty) {
+            continue;
+        }
+
+        // Tek replace() = tek yeniden yerleşim; tampon kapasitesi korunur
+        trace.decimator.fillPoints(framePoints, timeBase);
+        trace.series->replace(framePoints);
+        trace.dirty = false;
+    }
+
+    updateAxes(now);
+}
+
+void DataLogger::updateAxes(qint64 now)
+{
+    const qint64 cutoff = now - WINDOW_MS;
     double minY = std::numeric_limits<double>::max();
     double maxY = std::numeric_limits<double>::lowest();
-    for (const auto& series : dataSeries) {
-        const auto points = series->points();
-        for (const auto& point : points) {
-            minY = qMin(minY, point.y());
-            maxY = qMax(maxY, point.y());
+    for (auto it = traces.constBegin(); it != traces.constEnd(); ++it) {
+        // Y aralığı seri başına O(1)
+        double low;
+        double high;
+        if (it->decimator.range(low, high)) {
+            minY = qMin(minY, low);
+            maxY = qMax(maxY, high);
         }
     }
-    axisY->setRange(minY - 1, maxY + 1);
+
+    axisX->setRange(QDateTime::fromMSecsSinceEpoch(cutoff), QDateTime::fromMSecsSinceEpoch(now));
+    plotAxisX->setRange(cutoff - timeBase, now - timeBase);
+    if (minY <= maxY) {
+        axisY->setRange(minY - 1, maxY + 1);
+    }
 }
 
-void DataLogger::saveToJson()
+bool DataLogger::openGLAvailable()
 {
-    QJsonDocument doc(dataArray);
-    QFile file(logFilePath);
-    
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(doc.toJson());
-        file.close();
-        qDebug() << "Data saved to:" << logFilePath;
-    } else {
-        qDebug() << "Failed to save data to:" << logFilePath;
+    // Başsız (offscreen) çalıştırmalarda ve istenirse yazılım çizimine düş
+    if (qEnvironmentVariableIsSet("QMODBUS_NO_OPENGL")) {
+        return false;
+    }
+    const QString platform = QGuiApplication::platformName();
+    if (platform == "offscreen" || platform == "minimal") {
+        return false;
+    }
+#ifndef QT_NO_OPENGL
+    QOpenGLContext context;
+    return context.create();
+#else
+    return false;
+#endif
+}
+
+void DataLogger::resizeEvent(QResizeEvent* event)
+{
+    QMainWindow::resizeEvent(event);
+
+    // Sütun genişliği yeni açılan sütunlara uygulanır
+    const int columns = plotColumns();
+    for (auto it = traces.begin(); it != traces.end(); ++it) {
+        it->decimator.setColumns(columns);
     }
 }
 
+void DataLogger::flush()
+{
+    recorder->flush();
+}
+
 QString DataLogger::getCurrentDateTime() const
 {
     return QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
@@ -1,19 +1,17 @@
 #ifndef DATA_LOGGER_H
 #define DATA_LOGGER_H
 
+#include "DataRecorder.h"
+#include "ChartDecimator.h"
 #include <QObject>
-#include <QTimer>
 #include <QDateTime>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QFile>
 #include <QChart>
 #include <QChartView>
 #include <QLineSeries>
 #include <QValueAxis>
 #include <QDateTimeAxis>
 #include <QMainWindow>
+#include <QTimer>
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -26,23 +24,53 @@ public:
 
 public slots:
     void logData(int address, const QVariant& value, const QString& unit = "");
-    void saveToJson();
+    void flush();
 
 private:
-    QTimer* saveTimer;
-    QJsonArray dataArray;
-    QString logFilePath;
+    // Kayıt pencereden bağımsızdır; grafik yalnızca görüntüler
+    DataRecorder* recorder;
     
     // Grafik bileşenleri
     QChart* chart;
     QChartView* chartView;
-    QMap<int, QLineSeries*> dataSeries;
-    QDateTimeAxis* axisX;
+    QDateTimeAxis* axisX;       // Görünen zaman etiketleri
+    QValueAxis* plotAxisX;      // Serilerin bağlı olduğu gizli eksen (timeBase'e göre ms)
     QValueAxis* axisY;
 
+    // Adres başına seyreltilmiş seri; QLineSeries yalnızca decimator'ın
+    // noktalarını (sütun başına en fazla 2) taşır
+    struct Trace {
+        QLineSeries* series;
+        ChartDecimator decimator;
+        bool dirty;
+
+        Trace() : series(nullptr), dirty(false) {}
+    };
+    QMap<int, Trace> traces;
+
+    // Örnekler kare başına toplanır; seri başına tek replace() yapılır
+    QTimer* frameTimer;
+    QVector<QPointF> framePoints;   // Kareler arasında yeniden kullanılır
+    bool useOpenGL;
+    // OpenGL köşe verisi float; x değerleri bu zamana göre tutulur
+    qint64 timeBase;
+
+    static const qint64 WINDOW_MS = 300000;
+    static const int FRAME_INTERVAL_MS = 16;
+    static const qint64 TIME_BASE_LIMIT_MS = 1 << 22;    // float'ta ms hassasiyeti sınırı
+
     void setupUI();
     void updateChart(int address, double value, const QDateTime& timestamp);
+    Trace& traceFor(int address);
+    int plotColumns() const;
+    void renderFrame();
+    void updateAxes(qint64 now);
     QString getCurrentDateTime() const;
+
+    static bool openGLAvailable();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
 };
 
 #endif // DATA_LOGGER_H
\ No newline at end of file
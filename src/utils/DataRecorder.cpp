@@ -0,0 +1,166 @@
+#include "DataRecorder.h"
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+
+DataRecorder::DataRecorder(const QString& directory, QObject* parent)
+    : QObject(parent)
+    , saveTimer(new QTimer(this))
+    , nextSeriesId(FIRST_DEVICE_SERIES)
+    , seriesDirty(false)
+{
+    // Seri dosyaları saatlik bölümler halinde bu dizinde tutulur
+    QString saveDir = directory.isEmpty() ? QDir::homePath() + "/modbus_logs" : directory;
+    store = new TimeSeriesStore(saveDir);
+    loadSeries();
+
+    // Timer ayarları
+    saveTimer->setInterval(5000); // 5 saniye; yalnızca yeni veri yazılır
+    connect(saveTimer, &QTimer::timeout, this, &DataRecorder::flush);
+    saveTimer->start();
+}
+
+DataRecorder::~DataRecorder()
+{
+    saveTimer->stop();
+    saveSeries();
+    delete store; // Açık chunk'ları mühürler
+}
+
+void DataRecorder::setSaveInterval(int ms)
+{
+    saveTimer->setInterval(ms);
+}
+
+qint64 DataRecorder::findSeries(const QString& device, int address) const
+{
+    auto it = deviceSeries.constFind(device);
+    if (it == deviceSeries.constEnd() || !it->contains(address)) {
+        return -1;
+    }
+    return it->value(address);
+}
+
+void DataRecorder::logData(int address, const QVariant& value, const QString& unit, qint64 timestamp)
+{
+    record(seriesFor(QString(), address), unit, timestamp, value.toDouble());
+}
+
+void DataRecorder::logDeviceData(const QString& device, int address, double value,
+                                 const QString& unit, qint64 timestamp)
+{
+    record(seriesFor(device, address), unit, timestamp, value);
+}
+
+quint32 DataRecorder::seriesFor(const QString& device, int address)
+{
+    QHash<int, quint32>& ids = deviceSeries[device];
+    auto it = ids.constFind(address);
+    if (it != ids.constEnd()) {
+        return *it;
+    }
+
+    // Cihazsız seriler eski dizinlerle uyum için adresi kimlik olarak kullanır
+    const quint32 id = device.isEmpty() ? static_cast<quint32>(address) : nextSeriesId++;
+    SeriesInfo info;
+    info.device = device;
+    info.address = address;
+    series.insert(id, info);
+    ids.insert(address, id);
+    seriesDirty = true;
+    return id;
+}
+
+void DataRecorder::record(quint32 id, const QString& unit, qint64 timestamp, double value)
+{
+    if (timestamp == 0) {
+        timestamp = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    SeriesInfo& info = series[id];
+    if (!unit.isEmpty() && info.unit != unit) {
+        info.unit = unit;
+        seriesDirty = true;
+    }
+
+    if (!store->append(id, timestamp, value)) {
+        qDebug() << "Failed to record data:" << store->getLastError();
+    }
+}
+
+void DataRecorder::flush()
+{
+    if (!store->flush()) {
+        qDebug() << "Failed to save data to:" << store->directory() << store->getLastError();
+    }
+    saveSeries();
+}
+
+void DataRecorder::loadSeries()
+{
+    QFile file(store->directory() + "/series.json");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QJsonObject object = QJsonDocument::fromJson(file.readAll()).object();
+
+    // Eski biçim: { "adres": "birim" }, yalnızca cihazsız seriler
+    if (!object.contains("series")) {
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            bool ok = false;
+            const int address = it.key().toInt(&ok);
+            if (ok) {
+                seriesFor(QString(), address);
+                series[static_cast<quint32>(address)].unit = it.value().toString();
+            }
+        }
+        return;
+    }
+
+    for (const QJsonValue& value : object.value("series").toArray()) {
+        const QJsonObject entry = value.toObject();
+        const quint32 id = static_cast<quint32>(entry.value("id").toDouble());
+        SeriesInfo info;
+        info.device = entry.value("device").toString();
+        info.address = entry.value("address").toInt();
+        info.unit = entry.value("unit").toString();
+        series.insert(id, info);
+        deviceSeries[info.device].insert(info.address, id);
+        if (id >= nextSeriesId) {
+            nextSeriesId = id + 1;
+        }
+    }
+    seriesDirty = false;
+}
+
+void DataRecorder::saveSeries()
+{
+    // Seri kimlikleri ve birimleri küçük bir yan dosyada; yalnızca değiştiğinde yazılır
+    if (!seriesDirty) {
+        return;
+    }
+
+    QJsonArray list;
+    for (auto it = series.constBegin(); it != series.constEnd(); ++it) {
+        QJsonObject entry;
+        entry["id"] = static_cast<double>(it.key());
+        entry["device"] = it->device;
+        entry["address"] = it->address;
+        entry["unit"] = it->unit;
+        list.append(entry);
+    }
+    QJsonObject object;
+    object["series"] = list;
+
+    QSaveFile file(store->directory() + "/series.json");
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(object).toJson());
+        if (file.commit()) {
+            seriesDirty = false;
+        }
+    }
+}
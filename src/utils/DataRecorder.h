@@ -0,0 +1,67 @@
+#ifndef DATA_RECORDER_H
+#define DATA_RECORDER_H
+
+#include "TimeSeriesStore.h"
+#include <QObject>
+#include <QTimer>
+#include <QDateTime>
+#include <QHash>
+#include <QVariant>
+
+// Pencere gerektirmeyen veri kaydedici; DataLogger ve qmodbusd kullanır.
+// Örnekler (cihaz, adres) başına seri olarak TimeSeriesStore'a eklenir;
+// periyodik flush yalnızca yeni chunk'ları tek segment halinde ekler
+// (group commit), eski veri yeniden yazılmaz.
+//
+// Seri kimlikleri dizindeki series.json'da birimlerle birlikte tutulur.
+// Cihazsız kayıtta (GUI) kimlik adresin kendisidir; adlı cihazlara
+// FIRST_DEVICE_SERIES'ten başlayan kimlikler verilir, böylece aynı adresi
+// kullanan cihazlar çakışmaz.
+class DataRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    static const quint32 FIRST_DEVICE_SERIES = 0x10000;
+
+    // directory boşsa ~/modbus_logs kullanılır
+    explicit DataRecorder(const QString& directory = QString(), QObject* parent = nullptr);
+    ~DataRecorder();
+
+    QString getLogDirectory() const { return store->directory(); }
+    TimeSeriesStore* getStore() const { return store; }
+    // Commit aralığı
+    void setSaveInterval(int ms);
+    // fsync aralığı; 0 her commit'te, <0 işletim sistemine bırakılır
+    void setSyncInterval(int ms) { store->setSyncInterval(ms); }
+
+    // Sorgular için seri kimliği; kayıt yoksa -1
+    qint64 findSeries(const QString& device, int address) const;
+
+public slots:
+    // timestamp 0 ise şimdiki zaman kullanılır
+    void logData(int address, const QVariant& value, const QString& unit = "", qint64 timestamp = 0);
+    void logDeviceData(const QString& device, int address, double value,
+                       const QString& unit = QString(), qint64 timestamp = 0);
+    void flush();
+
+private:
+    struct SeriesInfo {
+        QString device;
+        int address;
+        QString unit;
+    };
+
+    QTimer* saveTimer;
+    TimeSeriesStore* store;
+    QHash<quint32, SeriesInfo> series;
+    QHash<QString, QHash<int, quint32>> deviceSeries;   // Cihaz -> adres -> kimlik
+    quint32 nextSeriesId;
+    bool seriesDirty;
+
+    quint32 seriesFor(const QString& device, int address);
+    void record(quint32 id, const QString& unit, qint64 timestamp, double value);
+    void loadSeries();
+    void saveSeries();
+};
+
+#endif // DATA_RECORDER_H
@@ -0,0 +1,247 @@
+#include "GorillaChunk.h"
+#include <QtAlgorithms>
+#include <cstring>
+
+namespace {
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsToDouble(quint64 bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// n bitlik ikiye tümleyen değeri işaret genişletir
+qint64 signExtend(quint64 value, int bits)
+{
+    const quint64 sign = quint64(1) << (bits - 1);
+    return static_cast<qint64>((value ^ sign) - sign);
+}
+
+quint64 lowMask(int bits)
+{
+    return bits >= 64 ? ~quint64(0) : (quint64(1) << bits) - 1;
+}
+
+// Delta-of-delta kovaları: önek, önek uzunluğu, değer bit sayısı
+struct Bucket {
+    quint64 prefix;
+    int prefixBits;
+    int valueBits;
+};
+
+const Bucket DOD_BUCKETS[] = {
+    {0x2, 2, 7},        // 10
+    {0x6, 3, 9},        // 110
+    {0xE, 4, 12},       // 1110
+    {0xF, 4, 64}        // 1111
+};
+
+} // namespace
+
+GorillaEncoder::GorillaEncoder()
+{
+    reset();
+}
+
+void GorillaEncoder::reset()
+{
+    buffer.clear();
+    pending = 0;
+    pendingBits = 0;
+    samples = 0;
+    firstTs = 0;
+    lastTs = 0;
+    minTs = 0;
+    maxTs = 0;
+    lastDelta = 0;
+    lastValue = 0;
+    lastLeading = -1;
+    lastTrailing = 0;
+}
+
+void GorillaEncoder::writeBits(quint64 value, int bits)
+{
+    // En anlamlı bitten başlayarak bayt bayt yaz
+    while (bits > 0) {
+        int take = qMin(bits, 8 - pendingBits);
+        quint64 chunk = (value >> (bits - take)) & lowMask(take);
+        pending = (pending << take) | chunk;
+        pendingBits += take;
+        bits -= take;
+        if (pendingBits == 8) {
+            buffer.append(static_cast<char>(pending));
+            pending = 0;
+            pendingBits = 0;
+        }
+    }
+}
+
+void GorillaEncoder::append(qint64 timestamp, double value)
+{
+    const quint64 bits = doubleBits(value);
+
+    if (samples == 0) {
+        writeBits(static_cast<quint64>(timestamp), 64);
+        writeBits(bits, 64);
+        firstTs = lastTs = timestamp;
+        minTs = maxTs = timestamp;
+        lastValue = bits;
+        ++samples;
+        return;
+    }
+
+    // Zaman damgası: delta-of-delta
+    const qint64 delta = timestamp - lastTs;
+    const qint64 dod = delta - lastDelta;
+    if (dod == 0) {
+        writeBits(0, 1);
+    } else {
+        for (const Bucket& bucket : DOD_BUCKETS) {
+            const qint64 limit = bucket.valueBits >= 64 ? 0 : (qint64(1) << (bucket.valueBits - 1));
+            if (bucket.valueBits >= 64 || (dod >= -limit && dod < limit)) {
+                writeBits(bucket.prefix, bucket.prefixBits);
+                writeBits(static_cast<quint64>(dod) & lowMask(bucket.valueBits), bucket.valueBits);
+                break;
+            }
+        }
+    }
+    lastDelta = delta;
+    lastTs = timestamp;
+    minTs = qMin(minTs, timestamp);
+    maxTs = qMax(maxTs, timestamp);
+
+    // Değer: önceki değerle XOR
+    const quint64 xorValue = bits ^ lastValue;
+    if (xorValue == 0) {
+        writeBits(0, 1);
+    } else {
+        int leading = qMin(31, static_cast<int>(qCountLeadingZeroBits(xorValue)));
+        int trailing = static_cast<int>(qCountTrailingZeroBits(xorValue));
+        writeBits(1, 1);
+        if (lastLeading >= 0 && leading >= lastLeading && trailing >= lastTrailing) {
+            // Önceki anlamlı bit penceresine sığıyor
+            writeBits(0, 1);
+            int significant = 64 - lastLeading - lastTrailing;
+            writeBits(xorValue >> lastTrailing, significant);
+        } else {
+            int significant = 64 - leading - trailing;
+            writeBits(1, 1);
+            writeBits(static_cast<quint64>(leading), 5);
+            writeBits(static_cast<quint64>(significant & 0x3F), 6);  // 64 -> 0
+            writeBits(xorValue >> trailing, significant);
+            lastLeading = leading;
+            lastTrailing = trailing;
+        }
+    }
+    lastValue = bits;
+    ++samples;
+}
+
+QByteArray GorillaEncoder::data() const
+{
+    QByteArray out = buffer;
+    if (pendingBits > 0) {
+        out.append(static_cast<char>(pending << (8 - pendingBits)));
+    }
+    return out;
+}
+
+GorillaDecoder::GorillaDecoder(const char* data, int size, int count)
+    : data(reinterpret_cast<const quint8*>(data))
+    , size(size)
+    , remaining(count)
+    , position(0)
+    , index(0)
+    , lastTs(0)
+    , lastDelta(0)
+    , lastValue(0)
+    , lastLeading(0)
+    , lastTrailing(0)
+{
+}
+
+bool GorillaDecoder::readBits(int bits, quint64& out)
+{
+    if (position + bits > static_cast<qint64>(size) * 8) {
+        return false;
+    }
+    out = 0;
+    while (bits > 0) {
+        const int bitInByte = static_cast<int>(position & 7);
+        const int take = qMin(bits, 8 - bitInByte);
+        const quint8 byte = data[position >> 3];
+        const quint64 chunk = (byte >> (8 - bitInByte - take)) & lowMask(take);
+        out = (out << take) | chunk;
+        position += take;
+        bits -= take;
+    }
+    return true;
+}
+
+bool GorillaDecoder::next(qint64& timestamp, double& value)
+{
+    if (remaining <= 0) {
+        return false;
+    }
+
+    quint64 bits = 0;
+    if (index == 0) {
+        quint64 ts;
+        if (!readBits(64, ts) || !readBits(64, bits)) {
+            return false;
+        }
+        lastTs = static_cast<qint64>(ts);
+        lastValue = bits;
+    } else {
+        // Delta-of-delta öneki: ardışık 1'ler kovayı seçer
+        quint64 flag;
+        if (!readBits(1, flag)) return false;
+        qint64 dod = 0;
+        if (flag) {
+            int ones = 1;
+            while (ones < 4) {
+                if (!readBits(1, flag)) return false;
+                if (!flag) break;
+                ++ones;
+            }
+            const Bucket& bucket = DOD_BUCKETS[ones - 1];
+            quint64 raw;
+            if (!readBits(bucket.valueBits, raw)) return false;
+            dod = bucket.valueBits >= 64 ? static_cast<qint64>(raw) : signExtend(raw, bucket.valueBits);
+        }
+        lastDelta += dod;
+        lastTs += lastDelta;
+
+        if (!readBits(1, flag)) return false;
+        if (flag) {
+            quint64 control;
+            if (!readBits(1, control)) return false;
+            if (control) {
+                quint64 leading;
+                quint64 length;
+                if (!readBits(5, leading) || !readBits(6, length)) return false;
+                int significant = length == 0 ? 64 : static_cast<int>(length);
+                lastLeading = static_cast<int>(leading);
+                lastTrailing = 64 - lastLeading - significant;
+                if (lastTrailing < 0) return false;
+            }
+            quint64 xorValue;
+            if (!readBits(64 - lastLeading - lastTrailing, xorValue)) return false;
+            lastValue ^= xorValue << lastTrailing;
+        }
+    }
+
+    timestamp = lastTs;
+    value = bitsToDouble(lastValue);
+    ++index;
+    --remaining;
+    return true;
+}
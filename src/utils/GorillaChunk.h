@@ -0,0 +1,71 @@
+#ifndef GORILLA_CHUNK_H
+#define GORILLA_CHUNK_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+// Tek bir serinin zaman/değer çiftlerini sıkıştıran Gorilla kodlayıcı.
+// Zaman damgaları delta-of-delta, değerler önceki değerle XOR olarak
+// yazılır; düzenli örneklenen ve yavaş değişen seriler örnek başına
+// birkaç bite iner.
+class GorillaEncoder {
+public:
+    GorillaEncoder();
+
+    void append(qint64 timestamp, double value);
+    void reset();
+
+    int count() const { return samples; }
+    qint64 firstTimestamp() const { return firstTs; }
+    qint64 lastTimestamp() const { return lastTs; }
+    // Geç gelen örnekler yüzünden ilk/son örnekten farklı olabilir
+    qint64 minTimestamp() const { return minTs; }
+    qint64 maxTimestamp() const { return maxTs; }
+    int sizeInBytes() const { return buffer.size() + (pendingBits + 7) / 8; }
+
+    // Yarım kalan bayt dahil kodlanmış veri; kodlayıcı değişmez
+    QByteArray data() const;
+
+private:
+    QByteArray buffer;
+    quint64 pending;
+    int pendingBits;
+
+    int samples;
+    qint64 firstTs;
+    qint64 lastTs;
+    qint64 minTs;
+    qint64 maxTs;
+    qint64 lastDelta;
+    quint64 lastValue;
+    int lastLeading;
+    int lastTrailing;
+
+    void writeBits(quint64 value, int bits);
+};
+
+// GorillaEncoder çıktısını sırayla çözer
+class GorillaDecoder {
+public:
+    GorillaDecoder(const char* data, int size, int count);
+
+    // Sıradaki örnek; veri bittiyse veya bozuksa false
+    bool next(qint64& timestamp, double& value);
+
+private:
+    const quint8* data;
+    int size;
+    int remaining;
+    qint64 position;     // Bit konumu
+
+    int index;
+    qint64 lastTs;
+    qint64 lastDelta;
+    quint64 lastValue;
+    int lastLeading;
+    int lastTrailing;
+
+    bool readBits(int bits, quint64& out);
+};
+
+#endif // GORILLA_CHUNK_H
@@ -0,0 +1,124 @@
+#include "LatencyHistogram.h"
+#include <QtAlgorithms>
+#include <cmath>
+
+LatencyHistogram::Snapshot::Snapshot()
+    : counts(BUCKET_COUNT, 0)
+    , count(0)
+    , sum(0)
+    , max(0)
+{
+}
+
+quint64 LatencyHistogram::Snapshot::percentile(double p) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    const double bounded = qBound(0.0, p, 100.0);
+    const quint64 target = qMax<quint64>(1, static_cast<quint64>(std::ceil(bounded / 100.0 * count)));
+    quint64 seen = 0;
+    for (int index = 0; index < counts.size(); ++index) {
+        seen += counts[index];
+        if (seen >= target) {
+            return qMin(bucketUpperBound(index), max);
+        }
+    }
+    return max;
+}
+
+double LatencyHistogram::Snapshot::mean() const
+{
+    return count > 0 ? static_cast<double>(sum) / count : 0.0;
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other)
+{
+    for (int index = 0; index < BUCKET_COUNT; ++index) {
+        counts[index] += other.counts[index];
+    }
+    count += other.count;
+    sum += other.sum;
+    max = qMax(max, other.max);
+}
+
+LatencyHistogram::LatencyHistogram()
+    : count(0)
+    , sum(0)
+    , max(0)
+{
+    for (std::atomic<quint64>& bucket : counts) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(quint64 micros)
+{
+    if (micros < static_cast<quint64>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(micros);
+    }
+
+    // En yüksek 7 bit kova içindeki konumu verir
+    const int msb = 63 - static_cast<int>(qCountLeadingZeroBits(micros));
+    const int shift = msb - 6;
+    if (shift > MAX_SHIFT) {
+        return BUCKET_COUNT - 1;
+    }
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF +
+           static_cast<int>((micros >> shift) - SUB_BUCKET_HALF);
+}
+
+quint64 LatencyHistogram::bucketLowerBound(int index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<quint64>(index);
+    }
+    const int offset = index - SUB_BUCKET_COUNT;
+    const int shift = offset / SUB_BUCKET_HALF + 1;
+    return static_cast<quint64>(offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF) << shift;
+}
+
+quint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<quint64>(index);
+    }
+    const int shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    return bucketLowerBound(index) + (Q_UINT64_C(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(quint64 micros)
+{
+    counts[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+
+    quint64 current = max.load(std::memory_order_relaxed);
+    while (micros > current &&
+           !max.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot result;
+    for (int index = 0; index < BUCKET_COUNT; ++index) {
+        const quint64 value = counts[index].load(std::memory_order_relaxed);
+        result.counts[index] = value;
+        result.count += value;
+    }
+    result.sum = sum.load(std::memory_order_relaxed);
+    result.max = max.load(std::memory_order_relaxed);
+    return result;
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::atomic<quint64>& bucket : counts) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
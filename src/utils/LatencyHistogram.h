@@ -0,0 +1,57 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+// HDR tarzı log-lineer gecikme histogramı (mikrosaniye). 0-127 µs birebir,
+// üstündeki her ikinin kuvveti aralığı 64 alt kovaya bölünür: bağıl hata
+// en fazla ~%1.6, üst sınır 2^26 µs (~67 s); daha büyükler son kovaya
+// yazılır. record() kilitsizdir, okuyucular snapshot() ile kopya alır.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_COUNT = 128;
+    static const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static const int MAX_SHIFT = 19;
+    static const int BUCKET_COUNT = SUB_BUCKET_COUNT + MAX_SHIFT * SUB_BUCKET_HALF;
+
+    // Tutarlı kopya; count kova toplamından hesaplanır
+    struct Snapshot {
+        QVector<quint64> counts;    // BUCKET_COUNT eleman
+        quint64 count;
+        quint64 sum;                // µs
+        quint64 max;                // µs
+
+        Snapshot();
+
+        // p: 0-100. Değer, p'inci yüzdeliği içeren kovanın üst sınırıdır.
+        quint64 percentile(double p) const;
+        double mean() const;
+        void merge(const Snapshot& other);
+    };
+
+    LatencyHistogram();
+
+    void record(quint64 micros);
+    Snapshot snapshot() const;
+    void reset();
+
+    quint64 getCount() const { return count.load(std::memory_order_relaxed); }
+    quint64 getSum() const { return sum.load(std::memory_order_relaxed); }
+
+    static int bucketIndex(quint64 micros);
+    static quint64 bucketLowerBound(int index);
+    static quint64 bucketUpperBound(int index);     // Dahil
+
+private:
+    std::atomic<quint64> counts[BUCKET_COUNT];
+    std::atomic<quint64> count;
+    std::atomic<quint64> sum;
+    std::atomic<quint64> max;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,82 @@
+#include "LogRing.h"
+
+QString LogArg::toString() const
+{
+    switch (type) {
+        case INT:     return QString::number(i);
+        case UINT:    return QString::number(u);
+        case DOUBLE:  return QString::number(d);
+        case LITERAL: return QString::fromUtf8(s);
+        case STRING:  return text;
+        default:      return QString();
+    }
+}
+
+QString LogRecord::formattedMessage() const
+{
+    if (!format) {
+        return message;
+    }
+
+    QString result = QString::fromUtf8(format);
+    for (int k = 0; k < argCount; ++k) {
+        result = result.arg(args[k].toString());
+    }
+    return result;
+}
+
+QString LogRecord::contextText() const
+{
+    return literalContext ? QString::fromUtf8(literalContext) : context;
+}
+
+LogRing::LogRing(int capacity)
+    : abandoned(false)
+    , head(0)
+    , tail(0)
+    , dropped(0)
+{
+    // Kapasite ikinin kuvvetine yuvarlanır
+    int size = 16;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    storage.resize(size);
+    buffer = storage.data();
+    mask = static_cast<quint32>(size - 1);
+}
+
+bool LogRing::push(LogRecord& record)
+{
+    const quint32 t = tail.load(std::memory_order_relaxed);
+    const quint32 h = head.load(std::memory_order_acquire);
+    if (t - h > mask) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    buffer[t & mask] = std::move(record);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRing::pop(LogRecord& out)
+{
+    const quint32 h = head.load(std::memory_order_relaxed);
+    const quint32 t = tail.load(std::memory_order_acquire);
+    if (h == t) {
+        return false;
+    }
+
+    LogRecord& slot = buffer[h & mask];
+    out = std::move(slot);
+    // Taşımada slota geçen eski içerik burada, tüketicide serbest bırakılır
+    slot = LogRecord();
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRing::isEmpty() const
+{
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
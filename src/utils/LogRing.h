@@ -0,0 +1,93 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// Ertelenmiş biçimlendirme argümanı. Sayılar ve literal dizgiler bellek
+// ayırmadan saklanır; biçimlendirme yazıcı iş parçacığında yapılır.
+class LogArg {
+public:
+    enum Type : quint8 {
+        NONE,
+        INT,
+        UINT,
+        DOUBLE,
+        LITERAL,    // Ömür boyu geçerli const char* (ör. string literal)
+        STRING
+    };
+
+    LogArg() : type(NONE), i(0) {}
+    LogArg(int v) : type(INT), i(v) {}
+    LogArg(long v) : type(INT), i(v) {}
+    LogArg(qint64 v) : type(INT), i(v) {}
+    LogArg(uint v) : type(UINT), u(v) {}
+    LogArg(unsigned long v) : type(UINT), u(v) {}
+    LogArg(quint64 v) : type(UINT), u(v) {}
+    LogArg(double v) : type(DOUBLE), d(v) {}
+    LogArg(const char* v) : type(LITERAL), s(v) {}
+    LogArg(const QString& v) : type(STRING), i(0), text(v) {}
+
+    bool isNull() const { return type == NONE; }
+    QString toString() const;
+
+    Type type;
+    union {
+        qint64 i;
+        quint64 u;
+        double d;
+        const char* s;
+    };
+    QString text;
+};
+
+// Kuyruktaki tek log kaydı. Ya hazır message/context taşır ya da
+// format + argümanlar (yazıcıda biçimlendirilir).
+struct LogRecord {
+    static const int MAX_ARGS = 4;
+
+    quint8 level;
+    quint8 argCount;
+    qint64 timestamp;           // ms (epoch)
+    const char* format;         // nullptr ise message kullanılır
+    const char* literalContext;
+    QString message;
+    QString context;
+    LogArg args[MAX_ARGS];
+
+    LogRecord() : level(0), argCount(0), timestamp(0), format(nullptr), literalContext(nullptr) {}
+
+    QString formattedMessage() const;
+    QString contextText() const;
+};
+
+// Tek üretici / tek tüketici halka. Her iş parçacığının kendi halkası
+// vardır; üretici kilit almaz, dolu halkada kayıt düşürülür (sıcak döngü
+// asla beklemez).
+class LogRing {
+public:
+    explicit LogRing(int capacity = 1024);
+
+    bool push(LogRecord& record);   // Üretici; kayıt taşınır
+    bool pop(LogRecord& out);       // Tüketici
+
+    bool isEmpty() const;
+    quint64 takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    // Sahip iş parçacığı bitti; boşaltılınca listeden çıkarılır
+    std::atomic<bool> abandoned;
+
+private:
+    QVector<LogRecord> storage;
+    LogRecord* buffer;          // storage.data(); detach kontrolünden kaçınmak için
+    quint32 mask;
+    alignas(64) std::atomic<quint32> head;     // Tüketici
+    alignas(64) std::atomic<quint32> tail;     // Üretici
+    std::atomic<quint64> dropped;
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+};
+
+#endif // LOG_RING_H
@@ -3,6 +3,39 @@
 #include <QDir>
 #include <QDateTime>
 #include <QFileInfo>
+#include <QThread>
+#include <QCoreApplication>
+#include <QMetaMethod>
+#include <algorithm>
+
+class Logger::WriterThread : public QThread {
+public:
+    explicit WriterThread(Logger* logger) : logger(logger) {}
+
+protected:
+    void run() override { logger->writerLoop(); }
+
+private:
+    Logger* logger;
+};
+
+namespace {
+
+// İş parçacığı bittiğinde halkası yazıcıya bırakılır
+struct LocalRing {
+    std::shared_ptr<LogRing> ring;
+
+    ~LocalRing()
+    {
+        if (ring) {
+            ring->abandoned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local LocalRing localRingHolder;
+
+} // namespace
 
 // Singleton instance
 Logger* Logger::instance_ = nullptr;
@@ -11,33 +44,69 @@ Logger& Logger::instance()
 {
     if (!instance_) {
         instance_ = new Logger();
+        // Uygulama kapanırken kuyruktakiler yazılır
+        qAddPostRoutine(&Logger::shutdownInstance);
     }
     return *instance_;
 }
 
+void Logger::shutdownInstance()
+{
+    if (instance_) {
+        instance_->shutdown();
+    }
+}
+
 Logger::Logger(QObject* parent)
     : QObject(parent)
+    , fileFormat(FileFormat::TEXT)
     , maxLogSize(10 * 1024 * 1024)  // 10MB varsayılan
     , maxLogFiles(5)
-    , minimumLevel(Level::INFO)
+    , minimumLevel(static_cast<int>(Level::INFO))
     , consoleOutput(true)
     , fileOutput(false)
     , includeTimestamp(true)
     , includeLevel(true)
     , includeContext(true)
+    , droppedCount(0)
+    , writer(new WriterThread(this))
+    , flushRequested(0)
+    , flushCompleted(0)
+    , running(true)
 {
+    // Yazıcıdan yayılan sinyaller kuyruklu bağlantıda bu tipi taşır
+    qRegisterMetaType<Logger::Level>("Logger::Level");
+
     // Log buffer'ını temizle
     logBuffer.clear();
+    writer->start(QThread::LowPriority);
 }
 
 Logger::~Logger()
 {
-    flush();
+    shutdown();
+    delete writer;
     if (logFile.isOpen()) {
         logFile.close();
     }
 }
 
+void Logger::shutdown()
+{
+    {
+        QMutexLocker locker(&wakeMutex);
+        if (!running) {
+            return;
+        }
+        running = false;
+        wakeCondition.wakeAll();
+    }
+    writer->wait();
+
+    // Yazıcı durduktan sonra kalanlar bu iş parçacığında yazılır
+    drain();
+}
+
 bool Logger::setLogFile(const QString& filename)
 {
     QMutexLocker locker(&mutex);
@@ -48,15 +117,13 @@ bool Logger::setLogFile(const QString& filename)
     }
 
     currentLogFile = filename;
-    logFile.setFileName(filename);
 
     // Dosyayı aç
-    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+    if (!openLogFile()) {
         emit logFileError(tr("Failed to open log file: %1").arg(filename));
         return false;
     }
 
-    logStream.setDevice(&logFile);
     fileOutput = true;
     emit logFileChanged(filename);
     return true;
@@ -77,6 +144,49 @@ void Logger::closeLogFile()
     fileOutput = false;
 }
 
+void Logger::setFileFormat(FileFormat format)
+{
+    QMutexLocker locker(&mutex);
+    fileFormat = format;
+}
+
+Logger::FileFormat Logger::getFileFormat() const
+{
+    QMutexLocker locker(&mutex);
+    return fileFormat;
+}
+
+bool Logger::openLogFile()
+{
+    logFile.setFileName(currentLogFile);
+    if (fileFormat == FileFormat::TEXT) {
+        return logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    }
+
+    // Önceki süreç kayıt ortasında kesildiyse yarım kayıt atılır; aksi halde
+    // eklenen kayıtlar onun devamı gibi çözülürdü
+    if (QFile::exists(currentLogFile) && QFileInfo(currentLogFile).size() > 0) {
+        const qint64 complete = BinaryLog::Encoder::completeLength(currentLogFile);
+        if (complete < 0) {
+            return false;   // İkili log değil; üzerine yazılmaz
+        }
+        if (complete < QFileInfo(currentLogFile).size() &&
+            !QFile::resize(currentLogFile, complete)) {
+            return false;
+        }
+    }
+
+    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    // Format tanımları ve zaman tabanı oturum başınadır; eklenen dosyada yeniden yazılır
+    binaryEncoder.reset();
+    if (logFile.size() == 0) {
+        logFile.write(BinaryLog::Encoder::header());
+    }
+    return true;
+}
+
 void Logger::setMaxLogSize(qint64 bytes)
 {
     QMutexLocker locker(&mutex);
@@ -91,8 +201,7 @@ void Logger::setMaxLogFiles(int count)
 
 void Logger::setLogLevel(Level level)
 {
-    QMutexLocker locker(&mutex);
-    minimumLevel = level;
+    minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void Logger::setConsoleOutput(bool enabled)
@@ -152,11 +261,15 @@ void Logger::critical(const QString& message, const QString& context)
 
 void Logger::flush()
 {
-    QMutexLocker locker(&mutex);
-    
-    if (fileOutput && logFile.isOpen()) {
-        logStream.flush();
-        logFile.flush();
+    // Yazıcıdan bir boşaltma turu iste ve bitmesini bekle
+    QMutexLocker locker(&wakeMutex);
+    if (!running) {
+        return;
+    }
+    const quint64 ticket = ++flushRequested;
+    wakeCondition.wakeAll();
+    while (running && flushCompleted < ticket) {
+        drainedCondition.wait(&wakeMutex);
     }
 }
 
@@ -197,62 +310,208 @@ QString Logger::getLastLogMessage() const
     return lastLogMessage;
 }
 
+quint64 Logger::getDroppedCount() const
+{
+    QMutexLocker locker(&mutex);
+    return droppedCount;
+}
+
 void Logger::writeLog(Level level, const QString& message, const QString& context)
 {
-    if (level < minimumLevel) {
+    if (!isEnabled(level)) {
         return;
     }
 
-    QMutexLocker locker(&mutex);
+    LogRecord record;
+    record.level = static_cast<quint8>(level);
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.message = message;
+    record.context = context;
+    enqueue(record);
+}
 
-    // Log girişini oluştur
-    LogEntry entry;
-    entry.level = level;
-    entry.message = message;
-    entry.context = context;
-    entry.timestamp = QDateTime::currentDateTime();
+void Logger::log(Level level, const char* context, const char* format,
+                 const LogArg& a1, const LogArg& a2, const LogArg& a3, const LogArg& a4)
+{
+    if (!isEnabled(level)) {
+        return;
+    }
 
-    // Buffer'a ekle
-    logBuffer.enqueue(entry);
-    if (logBuffer.size() > MAX_BUFFER_SIZE) {
-        logBuffer.dequeue();
+    LogRecord record;
+    record.level = static_cast<quint8>(level);
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.format = format;
+    record.literalContext = context;
+    const LogArg* args[LogRecord::MAX_ARGS] = {&a1, &a2, &a3, &a4};
+    for (const LogArg* arg : args) {
+        if (arg->isNull()) {
+            break;
+        }
+        record.args[record.argCount++] = *arg;
     }
+    enqueue(record);
+}
 
-    // İstatistikleri güncelle
-    logCounts[level]++;
-    lastLogTime = entry.timestamp;
-    lastLogMessage = message;
+LogRing* Logger::localRing()
+{
+    LocalRing& local = localRingHolder;
+    if (!local.ring) {
+        // İş parçacığı başına bir kez: halkayı yazıcıya tanıt
+        local.ring = std::make_shared<LogRing>();
+        QMutexLocker locker(&ringsMutex);
+        rings.append(local.ring);
+    }
+    return local.ring.get();
+}
 
-    // Log mesajını formatla
-    QString formattedMessage = formatLogMessage(entry);
+void Logger::enqueue(LogRecord& record)
+{
+    // Kilit yok, sistem çağrısı yok; halka doluysa kayıt sayılıp düşürülür
+    localRing()->push(record);
+}
 
-    // Konsola yaz
-    if (consoleOutput) {
-        writeToConsole(entry);
-    }
+void Logger::writerLoop()
+{
+    QMutexLocker locker(&wakeMutex);
+    while (running) {
+        wakeCondition.wait(&wakeMutex, WRITER_INTERVAL_MS);
+        const quint64 ticket = flushRequested;
 
-    // Dosyaya yaz
-    if (fileOutput) {
-        writeToFile(entry);
-    }
+        locker.unlock();
+        drain();
+        locker.relock();
 
-    // Sinyali gönder
-    emit messageLogged(level, message, context, entry.timestamp);
+        flushCompleted = ticket;
+        drainedCondition.wakeAll();
+    }
+    drainedCondition.wakeAll();
 }
 
-void Logger::writeToFile(const LogEntry& entry)
+void Logger::drain()
 {
-    if (!logFile.isOpen()) {
+    // Tüm halkaları topla; sahibi bitmiş boş halkaları bırak
+    QVector<std::shared_ptr<LogRing>> current;
+    {
+        QMutexLocker locker(&ringsMutex);
+        current = rings;
+    }
+
+    QVector<LogRecord> batch;
+    quint64 dropped = 0;
+    QVector<std::shared_ptr<LogRing>> finished;
+    for (const auto& ring : current) {
+        const bool abandoned = ring->abandoned.load(std::memory_order_acquire);
+        LogRecord record;
+        while (ring->pop(record)) {
+            batch.append(std::move(record));
+            record = LogRecord();
+        }
+        dropped += ring->takeDropped();
+        if (abandoned) {
+            finished.append(ring);
+        }
+    }
+    if (!finished.isEmpty()) {
+        QMutexLocker locker(&ringsMutex);
+        for (const auto& ring : finished) {
+            rings.removeOne(ring);
+        }
+    }
+
+    if (batch.isEmpty() && dropped == 0) {
+        QMutexLocker locker(&mutex);
+        if (fileOutput && logFile.isOpen()) {
+            logFile.flush();
+        }
         return;
     }
 
-    // Dosya boyutunu kontrol et
-    if (checkLogFileSize()) {
-        rotateLogFiles();
+    // İş parçacıkları arası sıra zaman damgasına göre
+    std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    if (dropped > 0) {
+        LogRecord record;
+        record.level = static_cast<quint8>(Level::WARNING);
+        record.timestamp = QDateTime::currentMSecsSinceEpoch();
+        record.message = QString("%1 log records dropped (ring full)").arg(dropped);
+        record.literalContext = "Logger";
+        batch.append(std::move(record));
     }
 
-    logStream << formatLogMessage(entry) << Qt::endl;
-    logStream.flush();
+    // Metin yalnızca okuyan varsa oluşturulur; ikili dosya tek başına
+    // biçimlendirme gerektirmez
+    const bool observed = isSignalConnected(QMetaMethod::fromSignal(&Logger::messageLogged));
+    QVector<LogEntry> entries;
+
+    {
+        QMutexLocker locker(&mutex);
+        droppedCount += dropped;
+
+        const bool writeFile = fileOutput && logFile.isOpen();
+        const bool binary = fileFormat == FileFormat::BINARY;
+        const bool needText = consoleOutput || observed || (writeFile && !binary);
+
+        // Rotasyon parti sınırında ve kodlamadan önce: ikili dosyada format
+        // tanımları yeni dosyaya yazılmalı
+        if (writeFile && checkLogFileSize()) {
+            rotateLogFiles();
+        }
+
+        // Dosyaya tek yazma
+        QByteArray fileBatch;
+        if (needText) {
+            entries.reserve(batch.size());
+        }
+        for (const LogRecord& record : batch) {
+            logCounts[static_cast<Level>(record.level)]++;
+
+            if (writeFile && binary) {
+                binaryEncoder.encode(record, fileBatch);
+            }
+            if (!needText) {
+                continue;
+            }
+
+            LogEntry entry = toEntry(record);
+            logBuffer.enqueue(entry);
+            if (logBuffer.size() > MAX_BUFFER_SIZE) {
+                logBuffer.dequeue();
+            }
+            if (consoleOutput) {
+                writeToConsole(entry);
+            }
+            if (writeFile && !binary) {
+                fileBatch += formatLogMessage(entry).toUtf8();
+                fileBatch += '\n';
+            }
+            entries.append(entry);
+        }
+
+        const LogRecord& last = batch.last();
+        lastLogTime = QDateTime::fromMSecsSinceEpoch(last.timestamp);
+        lastLogMessage = last.formattedMessage();
+
+        if (writeFile && logFile.isOpen() && !fileBatch.isEmpty()) {
+            logFile.write(fileBatch);
+            logFile.flush();
+        }
+    }
+
+    for (const LogEntry& entry : entries) {
+        emit messageLogged(entry.level, entry.message, entry.context, entry.timestamp);
+    }
+}
+
+Logger::LogEntry Logger::toEntry(const LogRecord& record) const
+{
+    LogEntry entry;
+    entry.level = static_cast<Level>(record.level);
+    entry.message = record.formattedMessage();
+    entry.context = record.contextText();
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp);
+    return entry;
 }
 
 void Logger::writeToConsole(const LogEntry& entry)
@@ -342,9 +601,9 @@ void Logger::rotateLogFiles()
     QFile::rename(currentLogFile, QString("%1.1.%2").arg(baseName).arg(suffix));
 
     // Yeni log dosyası aç
-    logFile.setFileName(currentLogFile);
-    logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
-    logStream.setDevice(&logFile);
+    if (!openLogFile()) {
+        emit logFileError(tr("Failed to open log file: %1").arg(currentLogFile));
+    }
 }
 
 bool Logger::checkLogFileSize()
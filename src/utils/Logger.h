@@ -1,15 +1,25 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "LogRing.h"
+#include "BinaryLog.h"
 #include <QObject>
 #include <QString>
 #include <QDateTime>
 #include <QFile>
-#include <QTextStream>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QQueue>
+#include <QMap>
+#include <atomic>
 #include <memory>
 
+// Çağıran iş parçacığı kaydı yalnızca kendi halkasına (LogRing) ekler;
+// biçimlendirme, konsol/dosya yazımı ve rotasyon arka plandaki yazıcı
+// iş parçacığında toplu yapılır. messageLogged yazıcıdan yayılır
+// (bkz. signals).
+// BINARY dosya biçiminde kayıtlar metne çevrilmeden yazılır (BinaryLog);
+// okumak için qmodbuslog aracı kullanılır.
 class Logger : public QObject {
     Q_OBJECT
 
@@ -23,6 +33,12 @@ public:
         CRITICAL    // Kritik hatalar
     };
 
+    // Log dosyası biçimi
+    enum class FileFormat {
+        TEXT,       // Satır başına biçimlendirilmiş metin
+        BINARY      // Format kimliği + paketlenmiş argümanlar
+    };
+
     // Singleton erişimi
     static Logger& instance();
 
@@ -30,6 +46,8 @@ public:
     bool setLogFile(const QString& filename);
     QString getLogFile() const;
     void closeLogFile();
+    void setFileFormat(FileFormat format);      // Sonraki setLogFile'dan itibaren geçerli
+    FileFormat getFileFormat() const;
     
     // Log ayarları
     void setMaxLogSize(qint64 bytes);
@@ -41,8 +59,19 @@ public:
     void setIncludeLevel(bool include);
     void setIncludeContext(bool include);
     
+    // Seviye açık mı? Sıcak yolda kilitsiz
+    bool isEnabled(Level level) const {
+        return static_cast<int>(level) >= minimumLevel.load(std::memory_order_relaxed);
+    }
+
+    // Ertelenmiş biçimlendirme: format'taki %1..%4 yazıcıda doldurulur.
+    // format ve context ömür boyu geçerli olmalıdır (string literal).
+    void log(Level level, const char* context, const char* format,
+             const LogArg& a1 = LogArg(), const LogArg& a2 = LogArg(),
+             const LogArg& a3 = LogArg(), const LogArg& a4 = LogArg());
+
     // Log buffer yönetimi
-    void flush();
+    void flush();       // Kuyruktakiler yazılana kadar bekler
     void clear();
     
     // Log istatistikleri
@@ -50,6 +79,7 @@ public:
     int getLogCount(Level level) const;
     QDateTime getLastLogTime() const;
     QString getLastLogMessage() const;
+    quint64 getDroppedCount() const;
 
 public slots:
     // Log yazma slot'ları
@@ -60,8 +90,11 @@ public slots:
     void critical(const QString& message, const QString& context = QString());
 
 signals:
-    // Log bildirimleri
-    void messageLogged(Level level, const QString& message, 
+    // Log bildirimleri. messageLogged ve drain sırasındaki logFileError
+    // yazıcı iş parçacığından yayılır; alıcılar kuyruklu (queued)
+    // bağlantıyla kendi iş parçacıklarında alır. Level bu yüzden meta-tip
+    // olarak kayıtlıdır ve imzada tam adıyla geçer.
+    void messageLogged(Logger::Level level, const QString& message, 
                       const QString& context, const QDateTime& timestamp);
     void logFileChanged(const QString& filename);
     void logFileError(const QString& error);
@@ -80,15 +113,18 @@ private:
         QDateTime timestamp;
     };
 
-    // Dosya yönetimi
+    class WriterThread;
+
+    // Dosya yönetimi (yazıcı iş parçacığı, mutex altında)
     QFile logFile;
-    QTextStream logStream;
     QString currentLogFile;
+    FileFormat fileFormat;
+    BinaryLog::Encoder binaryEncoder;
     qint64 maxLogSize;
     int maxLogFiles;
     
     // Log ayarları
-    Level minimumLevel;
+    std::atomic<int> minimumLevel;
     bool consoleOutput;
     bool fileOutput;
     bool includeTimestamp;
@@ -103,33 +139,85 @@ private:
     QMap<Level, int> logCounts;
     QDateTime lastLogTime;
     QString lastLogMessage;
+    quint64 droppedCount;
     
-    // Thread safety
+    // Thread safety: ayarlar, dosya ve istatistikler
     mutable QMutex mutex;
+
+    // İş parçacığı başına halkalar; liste yalnızca kayıt/temizlikte kilitlenir
+    QMutex ringsMutex;
+    QVector<std::shared_ptr<LogRing>> rings;
+
+    // Yazıcı iş parçacığı
+    WriterThread* writer;
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    QWaitCondition drainedCondition;
+    quint64 flushRequested;
+    quint64 flushCompleted;
+    bool running;
+    static const int WRITER_INTERVAL_MS = 20;
     
     // Singleton instance
     static Logger* instance_;
     
     // Yardımcı fonksiyonlar
     void writeLog(Level level, const QString& message, const QString& context);
-    void writeToFile(const LogEntry& entry);
+    void enqueue(LogRecord& record);
+    LogRing* localRing();
+    void writerLoop();
+    void drain();
+    void shutdown();
+    bool openLogFile();
+    LogEntry toEntry(const LogRecord& record) const;
     void writeToConsole(const LogEntry& entry);
     QString formatLogMessage(const LogEntry& entry) const;
     QString getLevelString(Level level) const;
     void rotateLogFiles();
     bool checkLogFileSize();
     void updateStatistics(const LogEntry& entry);
+    static void shutdownInstance();
     
     // Singleton yapısı için private copy constructor ve assignment operator
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 };
 
+Q_DECLARE_METATYPE(Logger::Level)
+
+// Derleme zamanı eşiği (0 DEBUG ... 4 CRITICAL). Altındaki seviyeler
+// sabit koşul nedeniyle koddan tümüyle atılır. Release derlemelerinde
+// varsayılan INFO'dur; DEFINES += QMODBUS_LOG_MIN_LEVEL=0 ile değişir.
+#ifndef QMODBUS_LOG_MIN_LEVEL
+#  ifdef QT_NO_DEBUG
+#    define QMODBUS_LOG_MIN_LEVEL 1
+#  else
+#    define QMODBUS_LOG_MIN_LEVEL 0
+#  endif
+#endif
+
+// Seviye kapalıysa call içindeki argümanlar hiç değerlendirilmez
+#define QMODBUS_LOG_IF(level, call) \
+    do { \
+        if (static_cast<int>(level) >= QMODBUS_LOG_MIN_LEVEL && \
+            Logger::instance().isEnabled(level)) { \
+            call; \
+        } \
+    } while (false)
+
 // Global log fonksiyonları
-#define LOG_DEBUG(msg, ctx) Logger::instance().debug(msg, ctx)
-#define LOG_INFO(msg, ctx) Logger::instance().info(msg, ctx)
-#define LOG_WARNING(msg, ctx) Logger::instance().warning(msg, ctx)
-#define LOG_ERROR(msg, ctx) Logger::instance().error(msg, ctx)
-#define LOG_CRITICAL(msg, ctx) Logger::instance().critical(msg, ctx)
+#define LOG_DEBUG(msg, ctx) QMODBUS_LOG_IF(Logger::Level::DEBUG, Logger::instance().debug(msg, ctx))
+#define LOG_INFO(msg, ctx) QMODBUS_LOG_IF(Logger::Level::INFO, Logger::instance().info(msg, ctx))
+#define LOG_WARNING(msg, ctx) QMODBUS_LOG_IF(Logger::Level::WARNING, Logger::instance().warning(msg, ctx))
+#define LOG_ERROR(msg, ctx) QMODBUS_LOG_IF(Logger::Level::ERROR, Logger::instance().error(msg, ctx))
+#define LOG_CRITICAL(msg, ctx) QMODBUS_LOG_IF(Logger::Level::CRITICAL, Logger::instance().critical(msg, ctx))
+
+// Ertelenmiş biçimlendirme: LOG_DEBUGF("ModbusDevice", "read %1 at %2", count, address)
+// Argümanlar LogArg olarak kuyruğa girer, metin yazıcıda oluşturulur.
+#define LOG_DEBUGF(ctx, ...) QMODBUS_LOG_IF(Logger::Level::DEBUG, Logger::instance().log(Logger::Level::DEBUG, ctx, __VA_ARGS__))
+#define LOG_INFOF(ctx, ...) QMODBUS_LOG_IF(Logger::Level::INFO, Logger::instance().log(Logger::Level::INFO, ctx, __VA_ARGS__))
+#define LOG_WARNINGF(ctx, ...) QMODBUS_LOG_IF(Logger::Level::WARNING, Logger::instance().log(Logger::Level::WARNING, ctx, __VA_ARGS__))
+#define LOG_ERRORF(ctx, ...) QMODBUS_LOG_IF(Logger::Level::ERROR, Logger::instance().log(Logger::Level::ERROR, ctx, __VA_ARGS__))
+#define LOG_CRITICALF(ctx, ...) QMODBUS_LOG_IF(Logger::Level::CRITICAL, Logger::instance().log(Logger::Level::CRITICAL, ctx, __VA_ARGS__))
 
 #endif // LOGGER_H
\ No newline at end of file
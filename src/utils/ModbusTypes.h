@@ -25,7 +25,9 @@ enum class DataType {
     REAL,
     LREAL,
     STRING,
-    WSTRING
+    WSTRING,
+    LINT,       // 64-bit işaretli
+    ULINT       // 64-bit işaretsiz
 };
 
 enum class RegisterType {
@@ -86,6 +88,11 @@ struct ConnectionParams {
     {}
 };
 
+// Metin tag'lerinin uzunluk sınırları (word). Üst sınır tek okuma
+// isteğine sığan register sayısıdır (MODBUS_MAX_READ_REGISTERS).
+const int DEFAULT_STRING_WORDS = 4;
+const int MAX_STRING_WORDS = 125;
+
 struct RegisterConfig {
     int address;           // Register adresi
     QString name;          // Register adı
@@ -101,6 +108,8 @@ struct RegisterConfig {
     double alarmHighLimit; // Yüksek alarm limiti
     double alarmLowLimit;  // Düşük alarm limiti
     ByteOrder byteOrder;   // Byte sırası
+    double deadband;       // Ölü bant (ölçeklenmiş birimde, 0 = kapalı)
+    int stringLength;      // STRING/WSTRING için word sayısı
     
     RegisterConfig() :
         address(0),
@@ -113,10 +122,42 @@ struct RegisterConfig {
         isAlarmEnabled(false),
         alarmHighLimit(0),
         alarmLowLimit(0),
-        byteOrder(ByteOrder::AB_CD)
+        byteOrder(ByteOrder::AB_CD),
+        deadband(0),
+        stringLength(DEFAULT_STRING_WORDS)
     {}
 };
 
+// Veri tipinin Modbus üzerinde kapladığı word sayısı
+inline int registerWordCount(DataType type)
+{
+    switch (type) {
+        case DataType::DWORD:
+        case DataType::DINT:
+        case DataType::REAL:
+            return 2;
+        case DataType::LREAL:
+        case DataType::LINT:
+        case DataType::ULINT:
+            return 4;
+        case DataType::STRING:
+        case DataType::WSTRING:
+            return DEFAULT_STRING_WORDS;
+        default:
+            return 1;
+    }
+}
+
+// Tag'in kapladığı word sayısı; metinlerde yapılandırılan uzunluk
+inline int registerWordCount(const RegisterConfig& config)
+{
+    if (config.dataType == DataType::STRING || config.dataType == DataType::WSTRING) {
+        if (config.stringLength < 1) return 1;
+        return config.stringLength > MAX_STRING_WORDS ? MAX_STRING_WORDS : config.stringLength;
+    }
+    return registerWordCount(config.dataType);
+}
+
 // Hata kodları
 enum class ModbusError {
     NO_ERROR,
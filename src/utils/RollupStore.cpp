@@ -0,0 +1,256 @@
+#include "RollupStore.h"
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include <climits>
+
+static_assert(sizeof(RollupStore::Record) == 40, "Record düzeni değişti");
+
+namespace {
+
+const char* const LEVEL_DIRS[RollupStore::LEVEL_COUNT] = {"1m", "1h"};
+
+RollupStore::Record emptyRecord()
+{
+    RollupStore::Record record;
+    record.start = 0;
+    record.min = 0.0;
+    record.max = 0.0;
+    record.sum = 0.0;
+    record.count = 0;
+    record.reserved = 0;
+    return record;
+}
+
+} // namespace
+
+RollupStore::SeriesRollup::SeriesRollup()
+{
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        open[level] = emptyRecord();
+        written[level] = LLONG_MIN;
+    }
+}
+
+RollupStore::RollupStore(const QString& directory)
+    : dir(directory)
+    , lateDropped(0)
+{
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        QDir().mkpath(dir + "/" + LEVEL_DIRS[level]);
+    }
+}
+
+RollupStore::~RollupStore()
+{
+    flush(true);
+}
+
+qint64 RollupStore::levelLength(Level level)
+{
+    return level == HOUR ? 3600000 : 60000;
+}
+
+QString RollupStore::filePath(Level level, quint32 seriesId) const
+{
+    return QString("%1/%2/%3.tsr").arg(dir, LEVEL_DIRS[level]).arg(seriesId);
+}
+
+void RollupStore::merge(Record& into, const Record& from)
+{
+    if (from.count == 0) {
+        return;
+    }
+    if (into.count == 0) {
+        into = from;
+        return;
+    }
+    into.min = qMin(into.min, from.min);
+    into.max = qMax(into.max, from.max);
+    into.sum += from.sum;
+    into.count += from.count;
+}
+
+// Dosyanın son kaydı; yoksa LLONG_MIN. Yeniden başlatmadan sonra geç
+// örneklerin daha önce yazılmış kovaların arkasına eklenmesini önler.
+qint64 RollupStore::lastWrittenStart(Level level, quint32 seriesId) const
+{
+    QFile file(filePath(level, seriesId));
+    const qint64 size = file.size();
+    const qint64 recordSize = static_cast<qint64>(sizeof(Record));
+    if (size < recordSize || !file.open(QIODevice::ReadOnly)) {
+        return LLONG_MIN;
+    }
+
+    Record last;
+    if (!file.seek((size / recordSize - 1) * recordSize) ||
+        file.read(reinterpret_cast<char*>(&last), recordSize) != recordSize) {
+        return LLONG_MIN;
+    }
+    return last.start;
+}
+
+RollupStore::SeriesRollup& RollupStore::rollupFor(quint32 seriesId)
+{
+    auto it = series.find(seriesId);
+    if (it == series.end()) {
+        it = series.insert(seriesId, SeriesRollup());
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            it->written[level] = lastWrittenStart(static_cast<Level>(level), seriesId);
+        }
+    }
+    return *it;
+}
+
+void RollupStore::add(quint32 seriesId, qint64 timestamp, double value)
+{
+    if (value != value) {
+        return; // NaN özetlere girmez
+    }
+
+    Record sample = emptyRecord();
+    sample.min = value;
+    sample.max = value;
+    sample.sum = value;
+    sample.count = 1;
+
+    SeriesRollup& rollup = rollupFor(seriesId);
+    bool dropped = false;
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        const qint64 length = levelLength(static_cast<Level>(level));
+        const qint64 start = timestamp - ((timestamp % length) + length) % length;
+        sample.start = start;
+        Record& open = rollup.open[level];
+
+        // Kova kapandı
+        if (open.count > 0 && start > open.start) {
+            rollup.pending[level].append(open);
+            open = emptyRecord();
+        }
+
+        // Kovası yazılmış geç örnek dosya sırasını bozacağından atlanır
+        if (start < rollup.written[level]) {
+            dropped = true;
+            continue;
+        }
+        QVector<Record>& pending = rollup.pending[level];
+        if ((open.count > 0 && start == open.start) ||
+            (open.count == 0 && (pending.isEmpty() || start > pending.last().start))) {
+            merge(open, sample);
+            continue;
+        }
+
+        // Geç örnek kendi (bekleyen) kovasına katılır
+        auto it = std::lower_bound(pending.begin(), pending.end(), start, [](const Record& record, qint64 value) {
+            return record.start < value;
+        });
+        if (it != pending.end() && it->start == start) {
+            merge(*it, sample);
+        } else {
+            pending.insert(it, sample);
+        }
+    }
+    if (dropped) {
+        ++lateDropped;
+    }
+}
+
+bool RollupStore::writeRecords(Level level, quint32 seriesId, const QVector<Record>& records)
+{
+    QFile file(filePath(level, seriesId));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        lastError = QString("Cannot open rollup %1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+
+    // Yarım kalmış son kayıt varsa üzerine yazılır
+    const qint64 size = file.size();
+    const qint64 aligned = size - size % static_cast<qint64>(sizeof(Record));
+    if (aligned != size) {
+        file.resize(aligned);
+        file.seek(aligned);
+    }
+
+    const qint64 bytes = static_cast<qint64>(records.size()) * static_cast<qint64>(sizeof(Record));
+    if (file.write(reinterpret_cast<const char*>(records.constData()), bytes) != bytes) {
+        lastError = QString("Failed to write rollup %1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool RollupStore::flush(bool force)
+{
+    bool ok = true;
+    for (auto it = series.begin(); it != series.end(); ++it) {
+        SeriesRollup& rollup = *it;
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            QVector<Record>& pending = rollup.pending[level];
+            if (force && rollup.open[level].count > 0) {
+                pending.append(rollup.open[level]);
+                rollup.open[level] = emptyRecord();
+            }
+            if (pending.isEmpty()) {
+                continue;
+            }
+            if (writeRecords(static_cast<Level>(level), it.key(), pending)) {
+                rollup.written[level] = pending.last().start;
+                pending.clear();
+            } else {
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+QVector<RollupStore::Record> RollupStore::read(Level level, quint32 seriesId, qint64 from, qint64 to) const
+{
+    QVector<Record> records;
+    const qint64 first = from - levelLength(level) + 1;    // from'u içeren kova
+
+    QFile file(filePath(level, seriesId));
+    if (file.open(QIODevice::ReadOnly) && file.size() >= static_cast<qint64>(sizeof(Record))) {
+        const qint64 count = file.size() / static_cast<qint64>(sizeof(Record));
+        const uchar* data = file.map(0, count * static_cast<qint64>(sizeof(Record)));
+        if (data) {
+            const Record* begin = reinterpret_cast<const Record*>(data);
+            const Record* end = begin + count;
+            const Record* it = std::lower_bound(begin, end, first, [](const Record& record, qint64 value) {
+                return record.start < value;
+            });
+            for (; it != end && it->start <= to; ++it) {
+                records.append(*it);
+            }
+        }
+    }
+
+    // Henüz yazılmamış kovalar
+    auto it = series.constFind(seriesId);
+    if (it != series.constEnd()) {
+        QVector<Record> memory = it->pending[level];
+        if (it->open[level].count > 0) {
+            memory.append(it->open[level]);
+        }
+        for (const Record& record : memory) {
+            if (record.start >= first && record.start <= to) {
+                records.append(record);
+            }
+        }
+    }
+
+    // Kapanış/yeniden başlatma aynı kovayı iki kez yazmış olabilir
+    std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.start < b.start;
+    });
+    QVector<Record> merged;
+    merged.reserve(records.size());
+    for (const Record& record : records) {
+        if (!merged.isEmpty() && merged.last().start == record.start) {
+            merge(merged.last(), record);
+        } else {
+            merged.append(record);
+        }
+    }
+    return merged;
+}
@@ -0,0 +1,74 @@
+#ifndef ROLLUP_STORE_H
+#define ROLLUP_STORE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Seri başına dakikalık ve saatlik min/max/toplam/adet özetleri.
+// Örnek geldikçe açık kovalar güncellenir; kapanan kovalar bellekte
+// biriktirilip toplu olarak seri başına sabit kayıtlı dosyalara eklenir:
+//   <dizin>/1m/<seriesId>.tsr, <dizin>/1h/<seriesId>.tsr
+// Kayıtlar zamana göre sıralı olduğundan okuma ikili aramayla yapılır.
+// Geç gelen örnek, kovası henüz bellekteyse kendi kovasına katılır; kovası
+// diske yazılmış olanlar sıralamayı bozmamak için özetlere girmez.
+class RollupStore {
+public:
+    enum Level {
+        MINUTE,
+        HOUR,
+        LEVEL_COUNT
+    };
+
+    struct Record {
+        qint64 start;           // Kova başlangıcı, ms (epoch)
+        double min;
+        double max;
+        double sum;
+        quint32 count;
+        quint32 reserved;
+    };
+
+    explicit RollupStore(const QString& directory);
+    ~RollupStore();
+
+    static qint64 levelLength(Level level);
+
+    void add(quint32 seriesId, qint64 timestamp, double value);
+
+    // Kapanmış kovaları diske ekler; force ise açık kovalar da yazılır
+    // (kapanışta). Aynı başlangıçlı kayıtlar okumada birleştirilir.
+    bool flush(bool force);
+
+    // [from, to] ile kesişen kovalar, zaman sırasıyla (yazılmamışlar dahil)
+    QVector<Record> read(Level level, quint32 seriesId, qint64 from, qint64 to) const;
+
+    QString getLastError() const { return lastError; }
+    // Kovası diske yazılmış olduğu için en az bir seviyeye girmeyen örnekler
+    quint64 droppedLateSamples() const { return lateDropped; }
+
+private:
+    struct SeriesRollup {
+        Record open[LEVEL_COUNT];
+        QVector<Record> pending[LEVEL_COUNT];   // start'a göre sıralı
+        qint64 written[LEVEL_COUNT];            // Dosyadaki son kayıt başlangıcı
+
+        SeriesRollup();
+    };
+
+    QString dir;
+    QHash<quint32, SeriesRollup> series;
+    QString lastError;
+    quint64 lateDropped;
+
+    SeriesRollup& rollupFor(quint32 seriesId);
+    qint64 lastWrittenStart(Level level, quint32 seriesId) const;
+    QString filePath(Level level, quint32 seriesId) const;
+    bool writeRecords(Level level, quint32 seriesId, const QVector<Record>& records);
+    static void merge(Record& into, const Record& from);
+
+    RollupStore(const RollupStore&) = delete;
+    RollupStore& operator=(const RollupStore&) = delete;
+};
+
+#endif // ROLLUP_STORE_H
@@ -0,0 +1,495 @@
+#include "TimeSeriesStore.h"
+#include <QDateTime>
+#include <QDir>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(TimeSeriesStore::PartitionHeader) == 32, "PartitionHeader düzeni değişti");
+static_assert(sizeof(TimeSeriesStore::SegmentHeader) == 32, "SegmentHeader düzeni değişti");
+static_assert(sizeof(TimeSeriesStore::ChunkHeader) == 32, "ChunkHeader düzeni değişti");
+
+namespace {
+
+// Tek segment sınırı; aşılırsa commit beklemeden yazılır
+const int MAX_SEGMENT_BYTES = 1024 * 1024;
+
+// CRC-32 (IEEE 802.3, yansıtılmış)
+quint32 crc32(const char* data, qint64 size)
+{
+    static quint32 table[256];
+    static bool initialized = false;
+    if (!initialized) {
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        initialized = true;
+    }
+
+    quint32 crc = 0xFFFFFFFFu;
+    const quint8* p = reinterpret_cast<const quint8*>(data);
+    for (qint64 i = 0; i < size; ++i) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(const QString& directory, qint64 partitionLength, int chunkSamples)
+    : dir(directory)
+    , partitionLength(qMax<qint64>(partitionLength, 1000))
+    , chunkSamples(qMax(chunkSamples, 2))
+    , maxChunkAge(5 * 60 * 1000)
+    , currentPartition(std::numeric_limits<qint64>::min())
+    , latestTimestamp(std::numeric_limits<qint64>::min())
+    , lateDropped(0)
+    , rollups(directory + "/rollup")
+    , syncInterval(0)
+{
+    QDir().mkpath(dir);
+    resetPendingSegment();
+    lastSync.start();
+    lastRollupFlush.start();
+}
+
+TimeSeriesStore::~TimeSeriesStore()
+{
+    sealAll();
+}
+
+QString TimeSeriesStore::partitionFileName(qint64 partitionStart)
+{
+    return QDateTime::fromMSecsSinceEpoch(partitionStart, Qt::UTC).toString("yyyyMMdd_HHmmss") + ".tsc";
+}
+
+qint64 TimeSeriesStore::partitionOf(qint64 timestamp) const
+{
+    qint64 index = timestamp / partitionLength;
+    if (timestamp < 0 && timestamp % partitionLength != 0) {
+        --index;
+    }
+    return index * partitionLength;
+}
+
+bool TimeSeriesStore::append(quint32 seriesId, qint64 timestamp, double value)
+{
+    // Geç gelen örnekler açık bölüme yazılır; kapanmış dosyalara dokunulmaz.
+    // Okuma yalnızca bir sonraki bölüme baktığı için daha eskileri atılır.
+    const qint64 partition = partitionOf(timestamp);
+    if (partition > currentPartition) {
+        if (!switchPartition(partition)) {
+            return false;
+        }
+    } else if (partition + partitionLength < currentPartition) {
+        ++lateDropped;
+        return true;
+    }
+    latestTimestamp = qMax(latestTimestamp, timestamp);
+
+    rollups.add(seriesId, timestamp, value);
+
+    OpenChunk& chunk = openChunks[seriesId];
+    if (chunk.encoder.count() == 0) {
+        chunk.openedAt = timestamp;
+    }
+    chunk.encoder.append(timestamp, value);
+
+    if (chunk.encoder.count() >= chunkSamples) {
+        return sealChunk(seriesId, chunk);
+    }
+    return true;
+}
+
+bool TimeSeriesStore::sealChunk(quint32 seriesId, OpenChunk& chunk)
+{
+    if (chunk.encoder.count() == 0) {
+        return true;
+    }
+
+    const QByteArray payload = chunk.encoder.data();
+    ChunkHeader header;
+    header.magic = CHUNK_MAGIC;
+    header.seriesId = seriesId;
+    header.minTimestamp = chunk.encoder.minTimestamp();
+    header.maxTimestamp = chunk.encoder.maxTimestamp();
+    header.sampleCount = static_cast<quint32>(chunk.encoder.count());
+    header.payloadSize = static_cast<quint32>(payload.size());
+    chunk.encoder.reset();
+
+    // Diske değil bekleyen segmente eklenir
+    pendingSegment.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    pendingSegment.append(payload);
+    pendingHeader.chunkCount++;
+    pendingHeader.minTimestamp = qMin(pendingHeader.minTimestamp, header.minTimestamp);
+    pendingHeader.maxTimestamp = qMax(pendingHeader.maxTimestamp, header.maxTimestamp);
+
+    if (pendingSegment.size() >= MAX_SEGMENT_BYTES) {
+        return commit(false);
+    }
+    return true;
+}
+
+void TimeSeriesStore::resetPendingSegment()
+{
+    pendingSegment.resize(0);
+    pendingHeader.magic = SEGMENT_MAGIC;
+    pendingHeader.chunkCount = 0;
+    pendingHeader.payloadSize = 0;
+    pendingHeader.crc = 0;
+    pendingHeader.minTimestamp = std::numeric_limits<qint64>::max();
+    pendingHeader.maxTimestamp = std::numeric_limits<qint64>::min();
+}
+
+bool TimeSeriesStore::commit(bool forceSync)
+{
+    if (pendingHeader.chunkCount > 0) {
+        if (!partitionFile.isOpen()) {
+            // Bölüm açılamadı (lastError'da); segment bellekte büyümesin
+            lastError = "No open partition";
+            resetPendingSegment();
+            return false;
+        }
+
+        pendingHeader.payloadSize = static_cast<quint32>(pendingSegment.size());
+        pendingHeader.crc = crc32(pendingSegment.constData(), pendingSegment.size());
+
+        // Başlık ve yük tek yazmada; yarım kalırsa CRC tutmaz ve açılışta atılır
+        QByteArray segment;
+        segment.reserve(static_cast<int>(sizeof(SegmentHeader)) + pendingSegment.size());
+        segment.append(reinterpret_cast<const char*>(&pendingHeader), sizeof(SegmentHeader));
+        segment.append(pendingSegment);
+
+        const qint64 start = partitionFile.pos();
+        if (partitionFile.write(segment) != segment.size()) {
+            lastError = QString("Failed to write segment: %1").arg(partitionFile.errorString());
+            // Sonraki segment bozuk kuyruğun arkasına yazılmasın
+            partitionFile.resize(start);
+            partitionFile.seek(start);
+            return false;
+        }
+        resetPendingSegment();
+    }
+
+    if (forceSync || (syncInterval >= 0 && lastSync.elapsed() >= syncInterval)) {
+        return syncFile();
+    }
+    return true;
+}
+
+bool TimeSeriesStore::syncFile()
+{
+    lastSync.restart();
+    if (!partitionFile.isOpen()) {
+        return true;
+    }
+#ifdef Q_OS_WIN
+    const bool ok = _commit(partitionFile.handle()) == 0;
+#else
+    const bool ok = ::fsync(partitionFile.handle()) == 0;
+#endif
+    if (!ok) {
+        lastError = QString("Failed to sync partition %1").arg(partitionFile.fileName());
+    }
+    return ok;
+}
+
+bool TimeSeriesStore::switchPartition(qint64 partition)
+{
+    // Eski bölümün açık chunk'ları kendi dosyasına mühürlenip sync edilir
+    bool ok = sealAll();
+    partitionFile.close();
+    currentPartition = partition;
+    return openPartition(partition) && ok;
+}
+
+bool TimeSeriesStore::openPartition(qint64 partition)
+{
+    partitionFile.setFileName(dir + "/" + partitionFileName(partition));
+    // Segmentler zaten bellekte toplanıyor; QFile tamponu gereksiz
+    if (!partitionFile.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        lastError = QString("Cannot open partition %1: %2")
+                        .arg(partitionFile.fileName(), partitionFile.errorString());
+        return false;
+    }
+
+    if (partitionFile.size() == 0) {
+        PartitionHeader header;
+        header.magic = PARTITION_MAGIC;
+        header.version = VERSION;
+        header.headerSize = sizeof(PartitionHeader);
+        header.partitionStart = partition;
+        header.partitionLength = partitionLength;
+        header.reserved = 0;
+        if (partitionFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+            lastError = QString("Failed to write partition header: %1").arg(partitionFile.errorString());
+            partitionFile.close();
+            return false;
+        }
+        return true;
+    }
+
+    // Yeniden başlatmada aynı bölüme devam edilir; yarım kalan segment atılır.
+    // Başka biçimdeki ya da başka ayarlı bir deponun dosyasının üzerine yazılmaz.
+    const qint64 length = validLength(partition);
+    if (length < 0) {
+        lastError = QString("%1 is not a partition of this store; not overwritten")
+                        .arg(partitionFile.fileName());
+        partitionFile.close();
+        return false;
+    }
+    if (length < partitionFile.size()) {
+        partitionFile.resize(length);
+    }
+    return partitionFile.seek(length);
+}
+
+// Sağlam segmentlerin bittiği konum; dosya bu bölümün başlığıyla
+// başlamıyorsa -1
+qint64 TimeSeriesStore::validLength(qint64 partition)
+{
+    PartitionHeader header;
+    if (!partitionFile.seek(0) ||
+        partitionFile.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+        header.magic != PARTITION_MAGIC || header.version != VERSION ||
+        header.headerSize < sizeof(PartitionHeader) ||
+        header.partitionStart != partition || header.partitionLength != partitionLength) {
+        return -1;
+    }
+
+    const qint64 size = partitionFile.size();
+    qint64 pos = header.headerSize;
+    SegmentHeader segment;
+    while (pos + static_cast<qint64>(sizeof(segment)) <= size) {
+        partitionFile.seek(pos);
+        if (partitionFile.read(reinterpret_cast<char*>(&segment), sizeof(segment)) != sizeof(segment) ||
+            segment.magic != SEGMENT_MAGIC) {
+            break;
+        }
+        qint64 end = pos + static_cast<qint64>(sizeof(segment)) + segment.payloadSize;
+        if (end > size) {
+            break;
+        }
+        const QByteArray payload = partitionFile.read(segment.payloadSize);
+        if (payload.size() != static_cast<int>(segment.payloadSize) ||
+            crc32(payload.constData(), payload.size()) != segment.crc) {
+            break;
+        }
+        pos = end;
+    }
+    return pos;
+}
+
+bool TimeSeriesStore::flush()
+{
+    bool ok = true;
+    for (auto it = openChunks.begin(); it != openChunks.end(); ++it) {
+        if (it->encoder.count() > 0 && latestTimestamp - it->openedAt >= maxChunkAge) {
+            ok = sealChunk(it.key(), *it) && ok;
+        }
+    }
+
+    // Özet dosyaları seri başına ayrı; sık açıp kapatmamak için seyrek yazılır
+    if (lastRollupFlush.elapsed() >= maxChunkAge) {
+        lastRollupFlush.restart();
+        if (!rollups.flush(false)) {
+            lastError = rollups.getLastError();
+            ok = false;
+        }
+    }
+    return commit(false) && ok;
+}
+
+bool TimeSeriesStore::sealAll()
+{
+    bool ok = true;
+    for (auto it = openChunks.begin(); it != openChunks.end(); ++it) {
+        ok = sealChunk(it.key(), *it) && ok;
+    }
+    if (!rollups.flush(true)) {
+        lastError = rollups.getLastError();
+        ok = false;
+    }
+    return commit(true) && ok;
+}
+
+void TimeSeriesStore::readPartition(const QString& path, quint32 seriesId,
+                                    qint64 from, qint64 to, QVector<Sample>& out)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const qint64 size = file.size();
+    const uchar* data = size > 0 ? file.map(0, size) : nullptr;
+    if (!data || size < static_cast<qint64>(sizeof(PartitionHeader))) {
+        return;
+    }
+
+    const PartitionHeader* header = reinterpret_cast<const PartitionHeader*>(data);
+    if (header->magic != PARTITION_MAGIC || header->version != VERSION) {
+        return;
+    }
+
+    // Yalnızca segment ve chunk başlıkları gezilir; aralık dışı segmentler
+    // ve başka serilerin verisi çözülmeden atlanır
+    qint64 pos = header->headerSize;
+    while (pos + static_cast<qint64>(sizeof(SegmentHeader)) <= size) {
+        SegmentHeader segment;
+        memcpy(&segment, data + pos, sizeof(segment));
+        const qint64 segmentStart = pos + static_cast<qint64>(sizeof(segment));
+        const qint64 segmentEnd = segmentStart + segment.payloadSize;
+        if (segment.magic != SEGMENT_MAGIC || segmentEnd > size) {
+            break;
+        }
+        pos = segmentEnd;
+
+        if (segment.maxTimestamp < from || segment.minTimestamp > to) {
+            continue;
+        }
+
+        qint64 chunkPos = segmentStart;
+        while (chunkPos + static_cast<qint64>(sizeof(ChunkHeader)) <= segmentEnd) {
+            ChunkHeader chunk;
+            memcpy(&chunk, data + chunkPos, sizeof(chunk));
+            const qint64 payload = chunkPos + static_cast<qint64>(sizeof(chunk));
+            if (chunk.magic != CHUNK_MAGIC || payload + chunk.payloadSize > segmentEnd) {
+                break;
+            }
+            chunkPos = payload + chunk.payloadSize;
+
+            if (chunk.seriesId != seriesId || chunk.maxTimestamp < from || chunk.minTimestamp > to) {
+                continue;
+            }
+
+            GorillaDecoder decoder(reinterpret_cast<const char*>(data + payload),
+                                   static_cast<int>(chunk.payloadSize),
+                                   static_cast<int>(chunk.sampleCount));
+            Sample sample;
+            while (decoder.next(sample.timestamp, sample.value)) {
+                if (sample.timestamp >= from && sample.timestamp <= to) {
+                    out.append(sample);
+                }
+            }
+        }
+    }
+}
+
+QVector<TimeSeriesStore::Sample> TimeSeriesStore::read(quint32 seriesId, qint64 from, qint64 to)
+{
+    QVector<Sample> samples;
+    commit(false);
+
+    const QStringList files = QDir(dir).entryList(QStringList() << "*.tsc", QDir::Files, QDir::Name);
+    for (const QString& name : files) {
+        const QString path = dir + "/" + name;
+        PartitionHeader header;
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) ||
+            file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+            header.magic != PARTITION_MAGIC || header.version != VERSION) {
+            continue;
+        }
+        file.close();
+
+        // Bölüm bir önceki bölüme ait geç örnekler de içerebilir; fazladan
+        // okunan dosyada aralık dışı segmentler başlıklarından elenir
+        if (header.partitionStart - header.partitionLength > to ||
+            header.partitionStart + header.partitionLength <= from) {
+            continue;
+        }
+        readPartition(path, seriesId, from, to, samples);
+    }
+
+    // Henüz mühürlenmemiş örnekler
+    auto it = openChunks.constFind(seriesId);
+    if (it != openChunks.constEnd() && it->encoder.count() > 0) {
+        const QByteArray payload = it->encoder.data();
+        GorillaDecoder decoder(payload.constData(), payload.size(), it->encoder.count());
+        Sample sample;
+        while (decoder.next(sample.timestamp, sample.value)) {
+            if (sample.timestamp >= from && sample.timestamp <= to) {
+                samples.append(sample);
+            }
+        }
+    }
+
+    std::stable_sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+        return a.timestamp < b.timestamp;
+    });
+    return samples;
+}
+
+QVector<TimeSeriesStore::TrendPoint> TimeSeriesStore::trend(quint32 seriesId, qint64 from, qint64 to,
+                                                            int targetPoints)
+{
+    QVector<TrendPoint> points;
+    if (to < from || targetPoints <= 0) {
+        return points;
+    }
+
+    const qint64 span = to - from + 1;
+    const qint64 bucket = qMax<qint64>(1, (span + targetPoints - 1) / targetPoints);
+
+    // Sıralı girdiyi hedef kovalara katlar; avg önce toplam olarak tutulur
+    auto accumulate = [&](qint64 timestamp, double min, double max, double sum, quint32 count) {
+        const qint64 start = from + qMax<qint64>(0, (timestamp - from) / bucket) * bucket;
+        if (points.isEmpty() || points.last().timestamp != start) {
+            TrendPoint point;
+            point.timestamp = start;
+            point.min = min;
+            point.max = max;
+            point.avg = sum;
+            point.count = count;
+            points.append(point);
+            return;
+        }
+        TrendPoint& point = points.last();
+        point.min = qMin(point.min, min);
+        point.max = qMax(point.max, max);
+        point.avg += sum;
+        point.count += count;
+    };
+
+    if (bucket >= RollupStore::levelLength(RollupStore::MINUTE)) {
+        const RollupStore::Level level = bucket >= RollupStore::levelLength(RollupStore::HOUR)
+                                             ? RollupStore::HOUR : RollupStore::MINUTE;
+        const QVector<RollupStore::Record> records = rollups.read(level, seriesId, from, to);
+        for (const RollupStore::Record& record : records) {
+            accumulate(record.start, record.min, record.max, record.sum, record.count);
+        }
+    } else {
+        // Yakın zum: ham örnekler
+        const QVector<Sample> samples = read(seriesId, from, to);
+        for (const Sample& sample : samples) {
+            if (sample.value == sample.value) {
+                accumulate(sample.timestamp, sample.value, sample.value, sample.value, 1);
+            }
+        }
+    }
+
+    for (TrendPoint& point : points) {
+        point.avg /= point.count;
+    }
+    return points;
+}
+
+QHash<quint32, QVector<TimeSeriesStore::TrendPoint>> TimeSeriesStore::trend(
+    const QVector<quint32>& seriesIds, qint64 from, qint64 to, int targetPoints)
+{
+    QHash<quint32, QVector<TrendPoint>> result;
+    for (quint32 seriesId : seriesIds) {
+        result.insert(seriesId, trend(seriesId, from, to, targetPoints));
+    }
+    return result;
+}
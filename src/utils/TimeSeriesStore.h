@@ -0,0 +1,160 @@
+#ifndef TIME_SERIES_STORE_H
+#define TIME_SERIES_STORE_H
+
+#include "GorillaChunk.h"
+#include "RollupStore.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Yalnızca sona eklenen, sütunsal zaman serisi deposu.
+// Her seri için açık bir Gorilla chunk'ı bellekte tutulur; dolan chunk
+// mühürlenip o anki bölüm (partition) dosyasının sonuna yazılır. Bölüm
+// dosyaları zamana göre ayrılır (varsayılan 1 saat) ve kapandıktan sonra
+// bir daha yazılmaz. Ekleme O(1)'dir, eski veri asla yeniden yazılmaz.
+//
+// Mühürlenen chunk'lar bellekte bir segmentte toplanır ve commit'te tek
+// yazmayla eklenir (group commit); fsync syncInterval'de bir yapılır.
+// Segment başlığındaki CRC sayesinde yarım yazılmış segment açılışta
+// tümüyle atılır: diskte ya segmentin tamamı vardır ya hiçbiri.
+//
+// Geç gelen örnek açık bölüme yazılır; yalnızca bir önceki bölüme ait
+// olabilir, daha eskiler atılıp sayılır. Böylece bir aralığın örnekleri
+// en fazla bir sonraki bölüm dosyasında da bulunabilir; okuma bu dosyanın
+// segment ve chunk başlıklarındaki en küçük/en büyük zamanla sınırlanır.
+//
+// Dakikalık/saatlik özetler (RollupStore) ekleme sırasında güncellenir;
+// trend() geniş aralıkları özetlerden, dar aralıkları ham chunk'lardan yanıtlar.
+//
+// Dosya düzeni (host byte sırası):
+//   PartitionHeader | (SegmentHeader | (ChunkHeader | Gorilla verisi)*)*
+class TimeSeriesStore {
+public:
+    static const quint32 PARTITION_MAGIC = 0x46505354;  // "TSPF"
+    static const quint32 SEGMENT_MAGIC = 0x47535354;    // "TSSG"
+    static const quint32 CHUNK_MAGIC = 0x4B435354;      // "TSCK"
+    static const quint16 VERSION = 2;
+
+    struct PartitionHeader {
+        quint32 magic;
+        quint16 version;
+        quint16 headerSize;
+        qint64 partitionStart;      // ms (epoch, UTC)
+        qint64 partitionLength;     // ms
+        quint64 reserved;
+    };
+
+    struct SegmentHeader {
+        quint32 magic;
+        quint32 chunkCount;
+        quint32 payloadSize;        // Başlık hariç
+        quint32 crc;                // Yükün CRC-32'si
+        qint64 minTimestamp;        // Segmentteki en eski örnek
+        qint64 maxTimestamp;        // Segmentteki en yeni örnek
+    };
+
+    struct ChunkHeader {
+        quint32 magic;
+        quint32 seriesId;
+        qint64 minTimestamp;        // Ekleme sırasından bağımsız
+        qint64 maxTimestamp;
+        quint32 sampleCount;
+        quint32 payloadSize;
+    };
+
+    struct Sample {
+        qint64 timestamp;       // ms (epoch)
+        double value;
+    };
+
+    // Trend sorgusunun tek kovası
+    struct TrendPoint {
+        qint64 timestamp;       // Kova başlangıcı, ms (epoch)
+        double min;
+        double max;
+        double avg;
+        quint32 count;
+    };
+
+    explicit TimeSeriesStore(const QString& directory,
+                             qint64 partitionLength = 3600000,
+                             int chunkSamples = 240);
+    ~TimeSeriesStore();
+
+    bool append(quint32 seriesId, qint64 timestamp, double value);
+
+    // Bekleyen segmenti commit eder; maxChunkAge'den eski açık chunk'lar
+    // önce mühürlenir (seyrek güncellenen seriler bellekte kalmasın)
+    bool flush();
+    // Tüm açık chunk'ları mühürler ve fsync ile commit eder (kapanışta)
+    bool sealAll();
+
+    // [from, to] aralığındaki örnekler, zaman sırasıyla. Bekleyen segment
+    // önce commit edilir.
+    QVector<Sample> read(quint32 seriesId, qint64 from, qint64 to);
+
+    // [from, to] aralığını yaklaşık targetPoints kovaya indirger. Kova
+    // saatten genişse saatlik, dakikadan genişse dakikalık özetler okunur;
+    // daha dar aralıklarda ham chunk'lar çözülür.
+    QVector<TrendPoint> trend(quint32 seriesId, qint64 from, qint64 to, int targetPoints);
+    QHash<quint32, QVector<TrendPoint>> trend(const QVector<quint32>& seriesIds,
+                                               qint64 from, qint64 to, int targetPoints);
+
+    QString directory() const { return dir; }
+    QString getLastError() const { return lastError; }
+    // Bir önceki bölümden de eski olduğu için yazılmayan örnekler
+    quint64 droppedLateSamples() const { return lateDropped; }
+    void setMaxChunkAge(qint64 ms) { maxChunkAge = ms; }
+    // 0: her commit'te fsync, <0: fsync işletim sistemine bırakılır
+    void setSyncInterval(int ms) { syncInterval = ms; }
+    int getSyncInterval() const { return syncInterval; }
+
+    static QString partitionFileName(qint64 partitionStart);
+
+private:
+    struct OpenChunk {
+        GorillaEncoder encoder;
+        qint64 openedAt;        // İlk örneğin zamanı
+
+        OpenChunk() : openedAt(0) {}
+    };
+
+    QString dir;
+    qint64 partitionLength;
+    int chunkSamples;
+    qint64 maxChunkAge;
+    QHash<quint32, OpenChunk> openChunks;
+    QFile partitionFile;
+    qint64 currentPartition;
+    qint64 latestTimestamp;
+    quint64 lateDropped;
+    QString lastError;
+
+    // Özetler; diske maxChunkAge aralıklarıyla toplu yazılır
+    RollupStore rollups;
+    QElapsedTimer lastRollupFlush;
+
+    // Group commit
+    QByteArray pendingSegment;
+    SegmentHeader pendingHeader;
+    int syncInterval;
+    QElapsedTimer lastSync;
+
+    qint64 partitionOf(qint64 timestamp) const;
+    bool switchPartition(qint64 partition);
+    bool openPartition(qint64 partition);
+    qint64 validLength(qint64 partition);
+    bool sealChunk(quint32 seriesId, OpenChunk& chunk);
+    bool commit(bool forceSync);
+    bool syncFile();
+    void resetPendingSegment();
+    static void readPartition(const QString& path, quint32 seriesId,
+                              qint64 from, qint64 to, QVector<Sample>& out);
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+};
+
+#endif // TIME_SERIES_STORE_H
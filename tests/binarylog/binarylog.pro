@@ -0,0 +1,7 @@
+TARGET = tst_binarylog
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_binarylog.cpp
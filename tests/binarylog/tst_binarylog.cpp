@@ -0,0 +1,168 @@
+#include "BinaryLog.h"
+#include "Logger.h"
+#include <QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           file.write(content) == content.size();
+}
+
+} // namespace
+
+// İkili log: kodlanan kayıtlar çözücüyle aynı metne döner; yarım kalan
+// son kayıt ve ikili olmayan dosya tanınır
+class TestBinaryLog : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void tornTail();
+    void loggerAppendsAfterTornTail();
+};
+
+void TestBinaryLog::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("qmodbus.qmbl");
+    static const char* const FORMAT = "read %1 words at %2";
+    static const char* const CONTEXT = "ModbusDevice";
+    const qint64 start = Q_INT64_C(1700000000000);
+
+    QByteArray out = BinaryLog::Encoder::header();
+    BinaryLog::Encoder encoder;
+    for (int i = 0; i < 3; ++i) {
+        LogRecord record;
+        record.level = 1;
+        record.timestamp = start + i * 250;
+        record.format = FORMAT;
+        record.literalContext = CONTEXT;
+        record.argCount = 2;
+        record.args[0] = LogArg(i + 1);
+        record.args[1] = LogArg(QString("0x%1").arg(i));
+        encoder.encode(record, out);
+    }
+    LogRecord text;
+    text.level = 3;
+    text.timestamp = start - 1000;     // Geriye giden saat
+    text.message = "Connection lost";
+    text.context = "ModbusConnection";
+    encoder.encode(text, out);
+
+    // Yeni oturum (ör. yeniden açılış) aynı dosyaya eklenir
+    encoder.reset();
+    LogRecord later;
+    later.level = 0;
+    later.timestamp = start + 86400000;
+    later.format = FORMAT;
+    later.literalContext = CONTEXT;
+    later.argCount = 2;
+    later.args[0] = LogArg(9);
+    later.args[1] = LogArg("end");
+    encoder.encode(later, out);
+    QVERIFY(writeFile(path, out));
+
+    BinaryLog::Decoder decoder;
+    QVERIFY2(decoder.open(path), qPrintable(decoder.getLastError()));
+    BinaryLog::Entry entry;
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(decoder.next(entry));
+        QCOMPARE(entry.timestamp, start + i * 250);
+        QCOMPARE(entry.level, quint8(1));
+        QCOMPARE(entry.context, QString(CONTEXT));
+        QCOMPARE(entry.format, QString(FORMAT));
+        QCOMPARE(entry.message, QString("read %1 words at 0x%2").arg(i + 1).arg(i));
+    }
+    QVERIFY(decoder.next(entry));
+    QCOMPARE(entry.timestamp, start - 1000);
+    QCOMPARE(entry.message, QString("Connection lost"));
+    QCOMPARE(entry.context, QString("ModbusConnection"));
+    QVERIFY(decoder.next(entry));
+    QCOMPARE(entry.timestamp, start + 86400000);
+    QCOMPARE(entry.message, QString("read 9 words at end"));
+    QVERIFY(!decoder.next(entry));
+}
+
+void TestBinaryLog::tornTail()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("torn.qmbl");
+
+    QByteArray out = BinaryLog::Encoder::header();
+    BinaryLog::Encoder encoder;
+    LogRecord record;
+    record.level = 2;
+    record.timestamp = Q_INT64_C(1700000000000);
+    record.message = "complete";
+    encoder.encode(record, out);
+    const int complete = out.size();
+
+    record.message = "torn record";
+    encoder.encode(record, out);
+    out.truncate(complete + (out.size() - complete) / 2);
+    QVERIFY(writeFile(path, out));
+
+    QCOMPARE(BinaryLog::Encoder::completeLength(path), qint64(complete));
+
+    const QString text = dir.filePath("plain.log");
+    QVERIFY(writeFile(text, "2024-01-01 [INFO] not binary\n"));
+    QCOMPARE(BinaryLog::Encoder::completeLength(text), qint64(-1));
+}
+
+// Logger ikili dosyayı yarım kaydı atarak sürdürür; metin dosyasına yazmaz
+void TestBinaryLog::loggerAppendsAfterTornTail()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    Logger& logger = Logger::instance();
+    logger.setConsoleOutput(false);
+    logger.setFileFormat(Logger::FileFormat::BINARY);
+
+    const QString text = dir.filePath("plain.log");
+    const QByteArray plain("2024-01-01 [INFO] not binary\n");
+    QVERIFY(writeFile(text, plain));
+    QVERIFY(!logger.setLogFile(text));
+    QFile textFile(text);
+    QVERIFY(textFile.open(QIODevice::ReadOnly));
+    QCOMPARE(textFile.readAll(), plain);
+
+    const QString path = dir.filePath("torn.qmbl");
+    QByteArray out = BinaryLog::Encoder::header();
+    BinaryLog::Encoder encoder;
+    LogRecord record;
+    record.level = 2;
+    record.timestamp = Q_INT64_C(1700000000000);
+    record.message = "before restart";
+    encoder.encode(record, out);
+    const int complete = out.size();
+    record.message = "torn record";
+    encoder.encode(record, out);
+    out.truncate(complete + 3);
+    QVERIFY(writeFile(path, out));
+
+    QVERIFY(logger.setLogFile(path));
+    logger.log(Logger::Level::WARNING, "tst_binarylog", "after restart %1", 7);
+    logger.flush();
+    logger.closeLogFile();
+    logger.setFileFormat(Logger::FileFormat::TEXT);
+
+    BinaryLog::Decoder decoder;
+    QVERIFY2(decoder.open(path), qPrintable(decoder.getLastError()));
+    BinaryLog::Entry entry;
+    QVERIFY(decoder.next(entry));
+    QCOMPARE(entry.message, QString("before restart"));
+    QVERIFY(decoder.next(entry));
+    QCOMPARE(entry.message, QString("after restart 7"));
+    QCOMPARE(entry.context, QString("tst_binarylog"));
+    QVERIFY(!decoder.next(entry));
+}
+
+QTEST_GUILESS_MAIN(TestBinaryLog)
+#include "tst_binarylog.moc"
@@ -0,0 +1,12 @@
+TARGET = tst_chartdecimator
+TEMPLATE = app
+
+include(../tests.pri)
+
+# Grafik seyreltici GUI hedefinde derlenir; çekirdekte yok
+SOURCES += \
+    tst_chartdecimator.cpp \
+    ../../src/utils/ChartDecimator.cpp
+
+HEADERS += \
+    ../../src/utils/ChartDecimator.h
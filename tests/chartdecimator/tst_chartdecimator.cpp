@@ -0,0 +1,135 @@
+#include "ChartDecimator.h"
+#include <QtTest>
+#include <QRandomGenerator>
+
+namespace {
+
+// Noktaların y aralığı; her sütunun uç değerleri noktalarda bulunduğu
+// için seyreltilmiş serinin gerçek aralığıdır
+void pointRange(const QVector<QPointF>& points, double& minY, double& maxY)
+{
+    minY = points.first().y();
+    maxY = minY;
+    for (const QPointF& point : points) {
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+}
+
+} // namespace
+
+// Sütun başına en fazla iki nokta, pencere kayarken baştan atılan nokta
+// sayısı ve monoton kuyruklardan okunan Y aralığı
+class TestChartDecimator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void columnsKeepMinAndMax();
+    void evictionKeepsRangeExact();
+};
+
+void TestChartDecimator::columnsKeepMinAndMax()
+{
+    // 100 ms'lik 10 sütun
+    ChartDecimator decimator(1000, 10);
+    QVector<double> values;
+    int opened = 0;
+    for (int t = 0; t < 1000; ++t) {
+        // Son sütun sabit: tek noktaya iner
+        const double value = t >= 900 ? 5.0 : (t * 37) % 101;
+        values.append(value);
+        if (decimator.append(t, value)) {
+            ++opened;
+        }
+    }
+    QCOMPARE(opened, 10);
+
+    const QVector<QPointF> points = decimator.points();
+    QCOMPARE(points.size(), 19);
+    for (int i = 1; i < points.size(); ++i) {
+        QVERIFY(points[i - 1].x() <= points[i].x());
+    }
+
+    for (int column = 0; column < 10; ++column) {
+        double expectedMin = values[column * 100];
+        double expectedMax = expectedMin;
+        for (int t = column * 100; t < (column + 1) * 100; ++t) {
+            expectedMin = qMin(expectedMin, values[t]);
+            expectedMax = qMax(expectedMax, values[t]);
+        }
+        QVector<QPointF> inColumn;
+        for (const QPointF& point : points) {
+            if (point.x() >= column * 100 && point.x() < (column + 1) * 100) {
+                inColumn.append(point);
+            }
+        }
+        QVERIFY(!inColumn.isEmpty() && inColumn.size() <= 2);
+        double minY;
+        double maxY;
+        pointRange(inColumn, minY, maxY);
+        QCOMPARE(minY, expectedMin);
+        QCOMPARE(maxY, expectedMax);
+        // Noktalar gerçek örneklerdir
+        for (const QPointF& point : inColumn) {
+            QCOMPARE(values[static_cast<int>(point.x())], point.y());
+        }
+    }
+
+    // fillPoints aynı noktaları kaydırarak yazar
+    QVector<QPointF> shifted;
+    decimator.fillPoints(shifted, 500);
+    QCOMPARE(shifted.size(), points.size());
+    QCOMPARE(shifted.first().x(), points.first().x() - 500);
+}
+
+void TestChartDecimator::evictionKeepsRangeExact()
+{
+    // 20 ms'lik sütunlar, 1 s pencere
+    const qint64 window = 1000;
+    ChartDecimator decimator(window, 50);
+    QRandomGenerator random(11);
+
+    int expectedSize = 0;
+    double value = 0.0;
+    for (qint64 t = 0; t < 20000; t += 7) {
+        // Uzun inen ve çıkan rampalar kuyrukların iki ucunu da zorlar;
+        // araya rastgele sıçramalar karışır
+        const qint64 phase = (t / 3000) % 3;
+        if (phase == 0) {
+            value -= 0.5;
+        } else if (phase == 1) {
+            value += 0.75;
+        } else {
+            value = random.generateDouble() * 200.0 - 100.0;
+        }
+
+        const int before = decimator.points().size();
+        decimator.append(t, value);
+        expectedSize += decimator.points().size() - before;
+
+        const int removed = decimator.evict(t - window);
+        expectedSize -= removed;
+        const QVector<QPointF> points = decimator.points();
+        QCOMPARE(points.size(), expectedSize);
+        QVERIFY(points.first().x() > t - window - 20);
+
+        double minY;
+        double maxY;
+        QVERIFY(decimator.range(minY, maxY));
+        double expectedMin;
+        double expectedMax;
+        pointRange(points, expectedMin, expectedMax);
+        QCOMPARE(minY, expectedMin);
+        QCOMPARE(maxY, expectedMax);
+    }
+
+    // Pencerenin tamamı dışarıda kalınca boşalır
+    QCOMPARE(decimator.evict(20000 + window), expectedSize);
+    QVERIFY(decimator.isEmpty());
+    double minY;
+    double maxY;
+    QVERIFY(!decimator.range(minY, maxY));
+}
+
+QTEST_GUILESS_MAIN(TestChartDecimator)
+#include "tst_chartdecimator.moc"
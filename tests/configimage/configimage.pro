@@ -0,0 +1,7 @@
+TARGET = tst_configimage
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_configimage.cpp
@@ -0,0 +1,150 @@
+#include "ConfigImage.h"
+#include "ModbusDevice.h"
+#include <QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+
+using ModbusTypes::DataType;
+using ModbusTypes::RegisterType;
+
+namespace {
+
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           file.write(content) == content.size();
+}
+
+} // namespace
+
+class TestConfigImage : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void rejectsInvalid();
+    void loadsDeviceByName();
+};
+
+void TestConfigImage::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("config.qmbc");
+
+    ModbusTypes::ConnectionParams params;
+    params.ip = "192.168.1.10";
+    params.slaveId = 7;
+
+    ModbusTypes::RegisterConfig level;
+    level.address = 100;
+    level.name = "Level";
+    level.unit = "m";
+    level.scaleFactor = 0.01;
+    level.deadband = 0.5;
+
+    ModbusTypes::RegisterConfig label;
+    label.address = 101;
+    label.name = "Label";
+    label.dataType = DataType::STRING;
+    label.stringLength = 8;
+
+    ConfigImage::Writer writer;
+    writer.addDevice("plc1", 500, 5000, params);
+    writer.addTag(level);
+    writer.addTag(label);
+    writer.addPlan(RegisterType::HOLDING_REGISTER, 100, 9, 2);
+    QVERIFY2(writer.save(path), qPrintable(writer.getLastError()));
+
+    QVERIFY(ConfigImage::isImageFile(path));
+    ConfigImage image;
+    QVERIFY2(image.open(path), qPrintable(image.getLastError()));
+    QCOMPARE(image.deviceCount(), 1);
+    QCOMPARE(image.findDevice("plc2"), -1);
+    const int index = image.findDevice("plc1");
+    QCOMPARE(index, 0);
+
+    const ConfigImage::DeviceRecord& dev = image.device(index);
+    QCOMPARE(dev.pollingInterval, 500);
+    QCOMPARE(image.connectionParams(dev).ip, params.ip);
+    QCOMPARE(image.connectionParams(dev).slaveId, 7);
+    QCOMPARE(dev.tagCount, 2u);
+    QCOMPARE(dev.planCount, 1u);
+
+    const ModbusTypes::RegisterConfig first = image.registerConfig(image.deviceTags(dev)[0]);
+    QCOMPARE(first.name, level.name);
+    QCOMPARE(first.unit, level.unit);
+    QCOMPARE(first.scaleFactor, level.scaleFactor);
+    QCOMPARE(first.deadband, level.deadband);
+
+    const ModbusTypes::RegisterConfig second = image.registerConfig(image.deviceTags(dev)[1]);
+    QCOMPARE(second.dataType, DataType::STRING);
+    QCOMPARE(second.stringLength, 8);
+    QCOMPARE(image.devicePlans(dev)[0].wordCount, quint16(9));
+}
+
+void TestConfigImage::rejectsInvalid()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    ModbusTypes::RegisterConfig config;
+    config.address = 0;
+    config.name = "Wide";
+
+    // Protokol sınırını aşan okuma bloğu
+    const QString oversized = dir.filePath("oversized.qmbc");
+    ConfigImage::Writer writer;
+    writer.addDevice("plc1", 1000, 5000, ModbusTypes::ConnectionParams());
+    writer.addTag(config);
+    writer.addPlan(RegisterType::HOLDING_REGISTER, 0, 200, 1);
+    QVERIFY(writer.save(oversized));
+
+    ConfigImage image;
+    QVERIFY(!image.open(oversized));
+    QVERIFY(!image.getLastError().isEmpty());
+    QVERIFY(!image.isOpen());
+
+    // Kesilmiş dosya
+    QFile source(oversized);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    const QString truncated = dir.filePath("truncated.qmbc");
+    QVERIFY(writeFile(truncated, source.read(source.size() / 2)));
+    QVERIFY(!image.open(truncated));
+
+    QVERIFY(writeFile(dir.filePath("garbage.qmbc"), QByteArray(256, 'x')));
+    QVERIFY(!ConfigImage::isImageFile(dir.filePath("garbage.qmbc")));
+    QVERIFY(!image.open(dir.filePath("garbage.qmbc")));
+    QVERIFY(!image.open(dir.filePath("missing.qmbc")));
+}
+
+void TestConfigImage::loadsDeviceByName()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("devices.qmbc");
+
+    ModbusTypes::RegisterConfig config;
+    config.address = 10;
+    config.name = "Flow";
+
+    ConfigImage::Writer writer;
+    writer.addDevice("plc1", 1000, 5000, ModbusTypes::ConnectionParams());
+    writer.addTag(config);
+    writer.addPlan(RegisterType::HOLDING_REGISTER, 10, 1, 1);
+    QVERIFY2(writer.save(path), qPrintable(writer.getLastError()));
+
+    ModbusDevice found("plc1");
+    QVERIFY2(found.loadConfiguration(path), qPrintable(found.getLastError()));
+    QCOMPARE(found.getRegisterAddresses(), QList<int>() << 10);
+
+    // İmajda olmayan cihaz ilk cihazın yapılandırmasını almaz
+    ModbusDevice missing("plc2");
+    QVERIFY(!missing.loadConfiguration(path));
+    QVERIFY(missing.getLastError().contains("plc2"));
+    QVERIFY(missing.getRegisterAddresses().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestConfigImage)
+#include "tst_configimage.moc"
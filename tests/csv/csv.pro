@@ -0,0 +1,7 @@
+TARGET = tst_csv
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_csv.cpp
@@ -0,0 +1,87 @@
+#include "Csv.h"
+#include <QtTest>
+#include <QBuffer>
+
+namespace {
+
+// Tırnak, virgül, gömülü satır sonu ve UTF-8 içeren kayıtlar
+QList<QStringList> sampleRecords()
+{
+    return {
+        QStringList() << "Address" << "Name" << "Description",
+        QStringList() << "100" << "Sıcaklık" << "",
+        QStringList() << "101" << "a,b" << "\"quoted\"",
+        QStringList() << "102" << "multi\nline" << "crlf\r\nend"
+    };
+}
+
+// Tampon kayıt ortasında dolsun diye küçük tutulur
+QByteArray writeRecords(const QList<QStringList>& records)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    Csv::Writer writer(&buffer, 16);
+    for (const QStringList& record : records) {
+        writer.writeRecord(record);
+    }
+    if (!writer.flush() || writer.hasError()) {
+        return QByteArray();
+    }
+    return buffer.data();
+}
+
+} // namespace
+
+class TestCsv : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void splitMatchesSequential();
+};
+
+void TestCsv::roundTrip()
+{
+    const QList<QStringList> records = sampleRecords();
+    const QByteArray data = writeRecords(records);
+    QVERIFY(!data.isEmpty());
+
+    const char* pos = data.constData();
+    const char* end = pos + data.size();
+    QStringList fields;
+    for (const QStringList& record : records) {
+        QVERIFY(Csv::readRecord(pos, end, fields));
+        QCOMPARE(fields, record);
+    }
+    QVERIFY(!Csv::readRecord(pos, end, fields));
+}
+
+void TestCsv::splitMatchesSequential()
+{
+    // Parçalar kayıt sınırına hizalı: tırnak içindeki satır sonu bölünmez
+    QList<QStringList> records;
+    for (int i = 0; i < 50; ++i) {
+        records.append(sampleRecords());
+    }
+    const QByteArray data = writeRecords(records);
+    const char* end = data.constData() + data.size();
+
+    for (int maxChunks : {1, 3, 7}) {
+        const QVector<Csv::Chunk> chunks = Csv::splitRecords(data.constData(), end, maxChunks);
+        QVERIFY(!chunks.isEmpty());
+        QVERIFY(chunks.size() <= maxChunks);
+
+        QList<QStringList> chunked;
+        QStringList fields;
+        for (const Csv::Chunk& chunk : chunks) {
+            const char* p = chunk.begin;
+            while (Csv::readRecord(p, chunk.end, fields)) {
+                chunked.append(fields);
+            }
+        }
+        QCOMPARE(chunked, records);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestCsv)
+#include "tst_csv.moc"
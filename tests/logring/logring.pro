@@ -0,0 +1,7 @@
+TARGET = tst_logring
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_logring.cpp
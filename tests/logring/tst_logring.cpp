@@ -0,0 +1,175 @@
+#include "LogRing.h"
+#include "Logger.h"
+#include <QtTest>
+#include <QMutex>
+#include <QThread>
+
+namespace {
+
+LogRecord sequenceRecord(int producer, int sequence)
+{
+    LogRecord record;
+    record.format = "%1 %2";
+    record.args[0] = LogArg(producer);
+    record.args[1] = LogArg(sequence);
+    record.argCount = 2;
+    return record;
+}
+
+// Halkaya sırayla kayıt ekler; dolu halkada tüketiciyi bekler
+class RingProducer : public QThread {
+public:
+    RingProducer(LogRing& ring, int count) : ring(ring), count(count) {}
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < count; ++i) {
+            LogRecord record = sequenceRecord(0, i);
+            while (!ring.push(record)) {
+                QThread::yieldCurrentThread();
+            }
+        }
+    }
+
+private:
+    LogRing& ring;
+    int count;
+};
+
+// Logger'a kendi iş parçacığından (yani kendi halkasından) yazar
+class LogProducer : public QThread {
+public:
+    LogProducer(int producer, int count) : producer(producer), count(count) {}
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < count; ++i) {
+            Logger::instance().log(Logger::Level::INFO, "tst_logring", "%1 %2", producer, i);
+        }
+    }
+
+private:
+    int producer;
+    int count;
+};
+
+} // namespace
+
+// Halka FIFO'dur, dolunca düşürür ve sayar; yazıcı her iş parçacığının
+// kayıtlarını kayıpsız ve ekleme sırasıyla boşaltır
+class TestLogRing : public QObject {
+    Q_OBJECT
+
+private slots:
+    void ringOrderAndOverflow();
+    void ringConcurrentProducer();
+    void loggerDrainOrdering();
+};
+
+void TestLogRing::ringOrderAndOverflow()
+{
+    // Kapasite ikinin kuvvetine, en az 16'ya yuvarlanır
+    LogRing ring(10);
+    for (int i = 0; i < 20; ++i) {
+        LogRecord record = sequenceRecord(0, i);
+        QCOMPARE(ring.push(record), i < 16);
+    }
+    QCOMPARE(ring.takeDropped(), quint64(4));
+    QCOMPARE(ring.takeDropped(), quint64(0));
+
+    // Sarmalanan indekslerde de sıra korunur
+    LogRecord out;
+    int next = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            QVERIFY(ring.pop(out));
+            QCOMPARE(out.formattedMessage(), QString("0 %1").arg(next++));
+        }
+        for (int i = 0; i < 10; ++i) {
+            LogRecord record = sequenceRecord(0, 16 + round * 10 + i);
+            QVERIFY(ring.push(record));
+        }
+    }
+    while (ring.pop(out)) {
+        QCOMPARE(out.formattedMessage(), QString("0 %1").arg(next++));
+    }
+    QCOMPARE(next, 46);
+    QVERIFY(ring.isEmpty());
+}
+
+void TestLogRing::ringConcurrentProducer()
+{
+    const int count = 100000;
+    LogRing ring(64);
+    RingProducer producer(ring, count);
+    producer.start();
+
+    LogRecord out;
+    int next = 0;
+    while (next < count) {
+        if (!ring.pop(out)) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+        QCOMPARE(out.args[1].i, qint64(next));
+        ++next;
+    }
+    producer.wait();
+    QVERIFY(!ring.pop(out));
+}
+
+void TestLogRing::loggerDrainOrdering()
+{
+    Logger& logger = Logger::instance();
+    logger.setConsoleOutput(false);
+    logger.flush();
+    logger.clear();
+
+    // messageLogged yazıcı iş parçacığından yayılır
+    QMutex mutex;
+    QStringList messages;
+    QList<QDateTime> timestamps;
+    connect(&logger, &Logger::messageLogged, this,
+            [&](Logger::Level, const QString& message, const QString& context, const QDateTime& timestamp) {
+                if (context != "tst_logring") {
+                    return;
+                }
+                QMutexLocker locker(&mutex);
+                messages.append(message);
+                timestamps.append(timestamp);
+            }, Qt::DirectConnection);
+
+    // Halka kapasitesinin altında: hiçbir kayıt düşmemeli
+    const int perThread = 500;
+    LogProducer first(1, perThread);
+    LogProducer second(2, perThread);
+    first.start();
+    second.start();
+    first.wait();
+    second.wait();
+    logger.flush();
+    disconnect(&logger, &Logger::messageLogged, this, nullptr);
+
+    QMutexLocker locker(&mutex);
+    QCOMPARE(messages.size(), 2 * perThread);
+    QCOMPARE(logger.getTotalLogCount(), 2 * perThread);
+    QCOMPARE(logger.getDroppedCount(), quint64(0));
+
+    // Her iş parçacığının kayıtları kendi ekleme sırasıyla gelir
+    int next[3] = {0, 0, 0};
+    for (const QString& message : messages) {
+        const QStringList parts = message.split(' ');
+        QCOMPARE(parts.size(), 2);
+        const int producer = parts[0].toInt();
+        QVERIFY(producer == 1 || producer == 2);
+        QCOMPARE(parts[1].toInt(), next[producer]);
+        ++next[producer];
+    }
+    QCOMPARE(next[1], perThread);
+    QCOMPARE(next[2], perThread);
+}
+
+QTEST_GUILESS_MAIN(TestLogRing)
+#include "tst_logring.moc"
@@ -0,0 +1,79 @@
+#ifndef LOOPBACK_SLAVE_H
+#define LOOPBACK_SLAVE_H
+
+#include <QMutex>
+#include <QThread>
+#include <modbus.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+// 127.0.0.1 üzerinde tek istemcili Modbus TCP slave; holding register'lar
+// test thread'inden setRegister ile değiştirilir. Port 0 boş bir port seçer.
+class LoopbackSlave : public QThread {
+public:
+    explicit LoopbackSlave(int listenPort = 0)
+        : ctx(modbus_new_tcp("127.0.0.1", listenPort))
+        , mapping(modbus_mapping_new(0, 0, 64, 0))
+        , listenSocket(-1)
+        , port(0)
+    {
+        listenSocket = modbus_tcp_listen(ctx, 1);
+        sockaddr_in address;
+        socklen_t length = sizeof(address);
+        if (listenSocket >= 0 &&
+            getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+            port = ntohs(address.sin_port);
+        }
+    }
+
+    ~LoopbackSlave()
+    {
+        wait();
+        if (listenSocket >= 0) {
+            close(listenSocket);
+        }
+        modbus_close(ctx);
+        modbus_free(ctx);
+        modbus_mapping_free(mapping);
+    }
+
+    int getPort() const { return port; }
+
+    void setRegister(int address, quint16 value)
+    {
+        QMutexLocker locker(&mutex);
+        mapping->tab_registers[address] = value;
+    }
+
+protected:
+    // İstemci bağlantıyı kapatınca modbus_receive -1 döner ve thread biter
+    void run() override
+    {
+        int socket = listenSocket;
+        if (modbus_tcp_accept(ctx, &socket) < 0) {
+            return;
+        }
+        uint8_t query[MODBUS_TCP_MAX_ADU_LENGTH];
+        for (;;) {
+            const int length = modbus_receive(ctx, query);
+            if (length < 0) {
+                break;
+            }
+            if (length == 0) {
+                continue;
+            }
+            QMutexLocker locker(&mutex);
+            modbus_reply(ctx, query, length, mapping);
+        }
+    }
+
+private:
+    modbus_t* ctx;
+    modbus_mapping_t* mapping;
+    int listenSocket;
+    int port;
+    QMutex mutex;
+};
+
+#endif // LOOPBACK_SLAVE_H
@@ -0,0 +1,15 @@
+TARGET = tst_metricsexporter
+TEMPLATE = app
+
+include(../tests.pri)
+
+# Exporter yalnızca servis hedefinde derlenir; çekirdekte yok
+SOURCES += \
+    tst_metricsexporter.cpp \
+    ../../src/daemon/MetricsExporter.cpp
+
+HEADERS += \
+    ../../src/daemon/MetricsExporter.h
+
+INCLUDEPATH += \
+    ../../src/daemon
@@ -0,0 +1,140 @@
+#include "MetricsExporter.h"
+#include "TransactionStats.h"
+#include <QtTest>
+#include <QMap>
+#include <modbus.h>
+#include <errno.h>
+
+namespace {
+
+// "ad{etiketler}" -> değer; yorum satırları atlanır
+QMap<QByteArray, QByteArray> parseSamples(const QByteArray& text)
+{
+    QMap<QByteArray, QByteArray> samples;
+    for (const QByteArray& line : text.split('\n')) {
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        const int space = line.lastIndexOf(' ');
+        samples.insert(line.left(space), line.mid(space + 1));
+    }
+    return samples;
+}
+
+} // namespace
+
+// Prometheus metin biçimi: aile başlıkları, etiket kaçışı, yalnızca sıfır
+// olmayan istisna kodları ve birikimli histogram kovaları
+class TestMetricsExporter : public QObject {
+    Q_OBJECT
+
+private slots:
+    void rendersCountersAndHistograms();
+    void samplesFollowTheirFamilyHeader();
+};
+
+void TestMetricsExporter::rendersCountersAndHistograms()
+{
+    TransactionStats plc;
+    plc.setConnected(true);
+    plc.setQueueDepth(3);
+    plc.recordReconnect();
+    plc.recordReconnect();
+    plc.recordResult(0x03, 1, true, 0);
+    plc.recordResult(0x03, 1, false, EMBXILADD);
+    plc.recordResult(0x03, 1, false, ETIMEDOUT);
+    plc.record(0x03, 1, TransactionStats::WIRE, 100);
+    plc.record(0x03, 1, TransactionStats::WIRE, 3000);
+    plc.record(0x03, 1, TransactionStats::WIRE, 20000000);
+
+    TransactionStats idle;
+
+    MetricsExporter exporter;
+    exporter.addDevice("plc1", &plc);
+    exporter.addDevice("pl\"c\\1", &idle);
+    const QMap<QByteArray, QByteArray> samples = parseSamples(exporter.render());
+
+    QCOMPARE(samples.value("qmodbus_up{device=\"plc1\"}"), QByteArray("1"));
+    QCOMPARE(samples.value("qmodbus_up{device=\"pl\\\"c\\\\1\"}"), QByteArray("0"));
+    QCOMPARE(samples.value("qmodbus_queue_depth{device=\"plc1\"}"), QByteArray("3"));
+    QCOMPARE(samples.value("qmodbus_reconnects_total{device=\"plc1\"}"), QByteArray("2"));
+
+    const QByteArray series = "device=\"plc1\",function=\"3\",slave=\"1\"";
+    QCOMPARE(samples.value("qmodbus_requests_total{" + series + "}"), QByteArray("3"));
+    QCOMPARE(samples.value("qmodbus_request_failures_total{" + series + "}"), QByteArray("2"));
+    QCOMPARE(samples.value("qmodbus_request_timeouts_total{" + series + "}"), QByteArray("1"));
+
+    // İstisna yalnızca görülen kod için yazılır
+    const int code = EMBXILADD - MODBUS_ENOBASE;
+    QCOMPARE(samples.value("qmodbus_exceptions_total{" + series + ",code=\"" +
+                           QByteArray::number(code) + "\"}"), QByteArray("1"));
+    int exceptionSamples = 0;
+    for (auto it = samples.constBegin(); it != samples.constEnd(); ++it) {
+        if (it.key().startsWith("qmodbus_exceptions_total{")) {
+            ++exceptionSamples;
+        }
+    }
+    QCOMPARE(exceptionSamples, 1);
+
+    // Kovalar birikimli; 3 ms 2.5 ms sınırını aşar, 20 s yalnızca +Inf'te
+    const QByteArray wire = "qmodbus_transaction_duration_seconds_bucket{" + series + ",phase=\"wire\",le=\"";
+    QCOMPARE(samples.value(wire + "0.0001\"}"), QByteArray("1"));
+    QCOMPARE(samples.value(wire + "0.0025\"}"), QByteArray("1"));
+    QCOMPARE(samples.value(wire + "0.005\"}"), QByteArray("2"));
+    QCOMPARE(samples.value(wire + "10\"}"), QByteArray("2"));
+    QCOMPARE(samples.value(wire + "+Inf\"}"), QByteArray("3"));
+    QCOMPARE(samples.value("qmodbus_transaction_duration_seconds_sum{" + series + ",phase=\"wire\"}"),
+             QByteArray("20.0031"));
+    QCOMPARE(samples.value("qmodbus_transaction_duration_seconds_count{" + series + ",phase=\"wire\"}"),
+             QByteArray("3"));
+
+    // Kaydı olmayan evre hiç yazılmaz
+    QVERIFY(!samples.contains("qmodbus_transaction_duration_seconds_count{" + series + ",phase=\"decode\"}"));
+}
+
+void TestMetricsExporter::samplesFollowTheirFamilyHeader()
+{
+    TransactionStats stats;
+    stats.recordResult(0x03, 1, false, EMBXSFAIL);
+    stats.recordResult(0x10, 2, true, 0);
+    stats.record(0x03, 1, TransactionStats::QUEUE_WAIT, 50);
+    stats.record(0x10, 2, TransactionStats::DECODE, 7);
+
+    MetricsExporter exporter;
+    exporter.addDevice("a", &stats);
+    exporter.addDevice("b", &stats);
+    const QByteArray text = exporter.render();
+    QVERIFY(text.endsWith('\n'));
+
+    // Her aile bir kez tanımlanır ve örnekleri başlığının hemen ardından gelir
+    QList<QByteArray> families;
+    QByteArray current;
+    for (const QByteArray& line : text.split('\n')) {
+        if (line.isEmpty()) {
+            continue;
+        }
+        if (line.startsWith("# TYPE ")) {
+            current = line.split(' ').value(2);
+            QVERIFY2(!families.contains(current), current.constData());
+            families.append(current);
+            continue;
+        }
+        if (line.startsWith('#')) {
+            continue;
+        }
+        QByteArray name = line.left(line.indexOf('{'));
+        if (current == "qmodbus_transaction_duration_seconds") {
+            for (const char* suffix : {"_bucket", "_sum", "_count"}) {
+                if (name.endsWith(suffix)) {
+                    name.chop(static_cast<int>(qstrlen(suffix)));
+                    break;
+                }
+            }
+        }
+        QVERIFY2(name == current, line.constData());
+    }
+    QCOMPARE(families.size(), 8);
+}
+
+QTEST_GUILESS_MAIN(TestMetricsExporter)
+#include "tst_metricsexporter.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_modbusdevice
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_modbusdevice.cpp
@@ -0,0 +1,183 @@
+#include "ModbusDevice.h"
+#include "loopbackslave.h"
+#include <QtTest>
+#include <QBitArray>
+
+using ModbusTypes::DataType;
+using ModbusTypes::RegisterType;
+
+namespace {
+
+ModbusTypes::RegisterConfig makeConfig(int address, DataType type, double deadband)
+{
+    ModbusTypes::RegisterConfig config;
+    config.address = address;
+    config.name = QString("R%1").arg(address);
+    config.dataType = type;
+    config.regType = RegisterType::HOLDING_REGISTER;
+    config.maxValue = 4294967295.0;
+    config.deadband = deadband;
+    return config;
+}
+
+} // namespace
+
+// Poll döngüsü: değişmeyen blok bildirilmez, yalnızca word'leri değişen
+// tag'ler bildirilir, ölü bant içindeki değişimler bastırılır
+class TestModbusDevice : public QObject {
+    Q_OBJECT
+
+private slots:
+    void changedTagsOnly();
+    void resumesPollingAfterReconnect();
+};
+
+void TestModbusDevice::changedTagsOnly()
+{
+    LoopbackSlave slave;
+    QVERIFY(slave.getPort() > 0);
+    slave.setRegister(0, 10);
+    slave.setRegister(1, 100);
+    slave.setRegister(2, 0x0001);
+    slave.setRegister(3, 0x0002);
+    slave.start();
+
+    ModbusDevice device("loopback");
+    ModbusTypes::ConnectionParams params;
+    params.ip = "127.0.0.1";
+    params.port = slave.getPort();
+    device.setConnectionParams(params);
+
+    // Tek blok: WORD, ölü bantlı WORD ve iki word'lük DWORD
+    QVector<ModbusTypes::RegisterConfig> configs;
+    configs << makeConfig(0, DataType::WORD, 0.0)
+            << makeConfig(1, DataType::WORD, 5.0)
+            << makeConfig(2, DataType::DWORD, 0.0);
+    QCOMPARE(device.addRegisters(configs), 3);
+    QVERIFY2(device.connectToDevice(), qPrintable(device.getLastError()));
+
+    const std::shared_ptr<const TagTable> table = device.getTagTable();
+    const int plainId = table->idForAddress(0);
+    const int deadbandId = table->idForAddress(1);
+    const int dwordId = table->idForAddress(2);
+
+    int updates = 0;
+    QBitArray lastChanged;
+    connect(&device, &ModbusDevice::blockUpdated,
+            [&updates, &lastChanged](const QString&, const QBitArray& changed) {
+                ++updates;
+                lastChanged = changed;
+            });
+    // Poll zamanlayıcısını beklemeden tek döngü
+    auto pollOnce = [&device]() {
+        QMetaObject::invokeMethod(&device, "handlePollingTimeout", Qt::DirectConnection);
+    };
+
+    // İlk okuma her tag'i bildirir
+    pollOnce();
+    QCOMPARE(updates, 1);
+    QCOMPARE(lastChanged.count(true), 3);
+    QCOMPARE(device.getRegisterValue(2).toUInt(), 0x00010002u);
+
+    // Aynı blok: bildirim yok
+    pollOnce();
+    QCOMPARE(updates, 1);
+
+    // Yalnızca ilk tag'in word'ü değişti
+    slave.setRegister(0, 11);
+    pollOnce();
+    QCOMPARE(updates, 2);
+    QCOMPARE(lastChanged.count(true), 1);
+    QVERIFY(lastChanged.testBit(plainId));
+    QCOMPARE(device.getRegisterValue(0).toInt(), 11);
+
+    // Çok word'lü tag'in yalnızca ikinci word'ü değişti
+    slave.setRegister(3, 0x0003);
+    pollOnce();
+    QCOMPARE(updates, 3);
+    QCOMPARE(lastChanged.count(true), 1);
+    QVERIFY(lastChanged.testBit(dwordId));
+    QCOMPARE(device.getRegisterValue(2).toUInt(), 0x00010003u);
+
+    // Ölü bant içinde: word değişse de bildirilmez, değer eski kalır
+    slave.setRegister(1, 104);
+    pollOnce();
+    QCOMPARE(updates, 3);
+    QCOMPARE(device.getRegisterValue(1).toInt(), 100);
+
+    // Ölü bant son bildirilen değere göre ölçülür (104 değil 100)
+    slave.setRegister(1, 106);
+    pollOnce();
+    QCOMPARE(updates, 4);
+    QCOMPARE(lastChanged.count(true), 1);
+    QVERIFY(lastChanged.testBit(deadbandId));
+    QCOMPARE(device.getRegisterValue(1).toInt(), 106);
+
+    device.disconnectDevice();
+}
+
+// Polling isteği bağlantı kopmasından etkilenmez; stopPolling ile kalkar
+void TestModbusDevice::resumesPollingAfterReconnect()
+{
+    // Açılıp kapatılan slave'in portunda artık kimse dinlemez
+    int port = 0;
+    {
+        LoopbackSlave probe;
+        port = probe.getPort();
+    }
+    QVERIFY(port > 0);
+
+    ModbusDevice device("loopback");
+    ModbusTypes::ConnectionParams params;
+    params.ip = "127.0.0.1";
+    params.port = port;
+    device.setConnectionParams(params);
+    QCOMPARE(device.addRegisters(QVector<ModbusTypes::RegisterConfig>()
+                                 << makeConfig(0, DataType::WORD, 0.0)), 1);
+
+    int started = 0;
+    int stopped = 0;
+    connect(&device, &ModbusDevice::pollingStarted, [&started]() { ++started; });
+    connect(&device, &ModbusDevice::pollingStopped, [&stopped]() { ++stopped; });
+    auto retryNow = [&device]() {
+        QMetaObject::invokeMethod(&device, "handleReconnectTimeout", Qt::DirectConnection);
+    };
+
+    // Bağlantı yokken istenen polling başlamaz ama unutulmaz
+    QVERIFY(!device.connectToDevice());
+    device.startPolling();
+    QVERIFY(!device.isPolling());
+    retryNow();
+    QVERIFY(!device.isConnected());
+    QCOMPARE(started, 0);
+
+    // Slave gelince yeniden deneme bağlanır ve polling kendiliğinden başlar
+    LoopbackSlave slave(port);
+    QCOMPARE(slave.getPort(), port);
+    slave.setRegister(0, 42);
+    slave.start();
+    retryNow();
+    QVERIFY2(device.isConnected(), qPrintable(device.getLastError()));
+    QVERIFY(device.isPolling());
+    QCOMPARE(started, 1);
+    QMetaObject::invokeMethod(&device, "handlePollingTimeout", Qt::DirectConnection);
+    QCOMPARE(device.getRegisterValue(0).toInt(), 42);
+
+    // Watchdog'un yaptığı gibi bağlantı yenilenince polling sürer
+    QVERIFY(device.reconnect());
+    QVERIFY(device.isPolling());
+    QCOMPARE(stopped, 1);
+    QCOMPARE(started, 2);
+
+    // stopPolling isteği kaldırır; yeni bağlantı polling başlatmaz
+    device.stopPolling();
+    QCOMPARE(stopped, 2);
+    QVERIFY(device.reconnect());
+    QVERIFY(!device.isPolling());
+    QCOMPARE(started, 2);
+
+    device.disconnectDevice();
+}
+
+QTEST_GUILESS_MAIN(TestModbusDevice)
+#include "tst_modbusdevice.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_registercodec
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_registercodec.cpp
@@ -0,0 +1,102 @@
+#include "RegisterCodec.h"
+#include <QtTest>
+
+using ModbusTypes::DataType;
+using ModbusTypes::ByteOrder;
+
+namespace {
+
+const ByteOrder ALL_ORDERS[] = {ByteOrder::AB_CD, ByteOrder::CD_AB, ByteOrder::BA_DC, ByteOrder::DC_BA};
+
+} // namespace
+
+class TestRegisterCodec : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void wordOrder();
+    void text();
+};
+
+void TestRegisterCodec::roundTrip()
+{
+    struct Case {
+        DataType type;
+        QVariant value;
+    };
+    const Case cases[] = {
+        {DataType::BIT, true},
+        {DataType::BYTE, 0xAB},
+        {DataType::WORD, 0xBEEF},
+        {DataType::INT, -1234},
+        {DataType::DWORD, 0xDEADBEEFu},
+        {DataType::DINT, -123456789},
+        {DataType::REAL, 3.5f},
+        {DataType::LREAL, -2.25e100},
+        {DataType::LINT, Q_INT64_C(-1234567890123)},
+        {DataType::ULINT, Q_UINT64_C(0xFEDCBA9876543210)}
+    };
+
+    for (const Case& c : cases) {
+        for (ByteOrder order : ALL_ORDERS) {
+            const RegisterCodec::Codec& codec = RegisterCodec::codecFor(c.type, order);
+            QCOMPARE(codec.wordCount, ModbusTypes::registerWordCount(c.type));
+            QVERIFY(!codec.text);
+
+            quint64 bits = 0;
+            QVERIFY(codec.encode(c.value, bits));
+            quint16 words[4] = {0, 0, 0, 0};
+            codec.store(bits, words);
+            QCOMPARE(codec.load(words), bits);
+            QCOMPARE(codec.toNumber(bits), c.value.toDouble());
+        }
+    }
+}
+
+void TestRegisterCodec::wordOrder()
+{
+    const quint16 expected[][2] = {
+        {0x1122, 0x3344},   // AB CD
+        {0x3344, 0x1122},   // CD AB
+        {0x2211, 0x4433},   // BA DC
+        {0x4433, 0x2211}    // DC BA
+    };
+    for (int i = 0; i < 4; ++i) {
+        const RegisterCodec::Codec& codec = RegisterCodec::codecFor(DataType::DWORD, ALL_ORDERS[i]);
+        quint16 words[2] = {0, 0};
+        codec.store(0x11223344u, words);
+        QCOMPARE(words[0], expected[i][0]);
+        QCOMPARE(words[1], expected[i][1]);
+    }
+}
+
+void TestRegisterCodec::text()
+{
+    QVERIFY(RegisterCodec::isText(DataType::STRING));
+    QVERIFY(RegisterCodec::codecFor(DataType::WSTRING, ByteOrder::AB_CD).text);
+    QCOMPARE(RegisterCodec::textCapacity(DataType::STRING, 4), 8);
+    QCOMPARE(RegisterCodec::textCapacity(DataType::WSTRING, 4), 4);
+
+    for (ByteOrder order : ALL_ORDERS) {
+        quint16 words[8];
+        QVERIFY(RegisterCodec::encodeText(DataType::STRING, order, "PUMP-01", words, 4));
+        QCOMPARE(RegisterCodec::decodeText(DataType::STRING, order, words, 4), QString("PUMP-01"));
+
+        const QString text = QString::fromUtf8("Ölçüm");
+        QVERIFY(RegisterCodec::encodeText(DataType::WSTRING, order, text, words, 8));
+        QCOMPARE(RegisterCodec::decodeText(DataType::WSTRING, order, words, 8), text);
+    }
+
+    // İlk karakter yüksek baytta; word sırası byte sırasından etkilenmez
+    quint16 words[2];
+    QVERIFY(RegisterCodec::encodeText(DataType::STRING, ByteOrder::CD_AB, "ABCD", words, 2));
+    QCOMPARE(words[0], quint16(0x4142));
+    QCOMPARE(words[1], quint16(0x4344));
+
+    QVERIFY(!RegisterCodec::encodeText(DataType::STRING, ByteOrder::AB_CD, "ABCDE", words, 2));
+    QVERIFY(!RegisterCodec::encodeText(DataType::STRING, ByteOrder::AB_CD, QString::fromUtf8("Ω"), words, 2));
+}
+
+QTEST_GUILESS_MAIN(TestRegisterCodec)
+#include "tst_registercodec.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_registerdecoder
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_registerdecoder.cpp
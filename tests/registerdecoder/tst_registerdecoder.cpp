@@ -0,0 +1,115 @@
+#include "RegisterDecoder.h"
+#include "RegisterCodec.h"
+#include <QtTest>
+#include <QRandomGenerator>
+#include <cmath>
+
+using ModbusTypes::DataType;
+using ModbusTypes::ByteOrder;
+
+namespace {
+
+const ByteOrder ALL_ORDERS[] = {ByteOrder::AB_CD, ByteOrder::CD_AB, ByteOrder::BA_DC, ByteOrder::DC_BA};
+
+// NaN'lar da eşit sayılır
+bool sameNumber(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+RegisterDecoder::TagLayout makeLayout(int offset, DataType type, ByteOrder order, double scale)
+{
+    RegisterDecoder::TagLayout layout;
+    layout.wordOffset = static_cast<quint16>(offset);
+    layout.wordCount = static_cast<quint8>(ModbusTypes::registerWordCount(type));
+    layout.dataType = type;
+    layout.byteOrder = order;
+    layout.scale = scale;
+    return layout;
+}
+
+} // namespace
+
+class TestRegisterDecoder : public QObject {
+    Q_OBJECT
+
+private slots:
+    void swapBytes();
+    void batchMatchesScalar();
+    void shortBlockPadsWithZero();
+};
+
+void TestRegisterDecoder::swapBytes()
+{
+    // Vektör gövdesi ve kuyruk birlikte denensin diye tek sayıda word
+    QVector<quint16> source(37);
+    for (int i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<quint16>(0x0102 * (i + 1));
+    }
+    QVector<quint16> swapped(source.size());
+    RegisterDecoder::swapBytes(source.constData(), swapped.data(), source.size());
+    for (int i = 0; i < source.size(); ++i) {
+        QCOMPARE(swapped[i], quint16((source[i] << 8) | (source[i] >> 8)));
+    }
+}
+
+void TestRegisterDecoder::batchMatchesScalar()
+{
+    // Her tip/sıra için vektör yoluna girecek uzunlukta ardışık diziler
+    const DataType types[] = {DataType::WORD, DataType::INT, DataType::DWORD,
+                              DataType::DINT, DataType::REAL};
+    QVector<RegisterDecoder::TagLayout> layouts;
+    int offset = 0;
+    for (DataType type : types) {
+        for (ByteOrder order : ALL_ORDERS) {
+            for (int k = 0; k < 9; ++k) {
+                layouts.append(makeLayout(offset, type, order, 0.1));
+                offset += layouts.last().wordCount;
+            }
+        }
+    }
+    // Dizileri bölen farklı tipte tek bir tag
+    layouts.append(makeLayout(offset, DataType::LREAL, ByteOrder::CD_AB, 1.0));
+    offset += 4;
+
+    QRandomGenerator random(42);
+    QVector<quint16> block(offset);
+    for (quint16& word : block) {
+        word = static_cast<quint16>(random.bounded(0x10000));
+    }
+
+    QVector<quint64> raw(layouts.size());
+    QVector<double> scaled(layouts.size());
+    RegisterDecoder::decodeBlock(block.constData(), block.size(), layouts.constData(), layouts.size(),
+                                 raw.data(), scaled.data());
+
+    for (int i = 0; i < layouts.size(); ++i) {
+        // Tek tag'lik çağrı her zaman skaler yoldan geçer
+        quint64 oneRaw = 0;
+        double oneScaled = 0.0;
+        RegisterDecoder::decodeBlock(block.constData(), block.size(), &layouts[i], 1, &oneRaw, &oneScaled);
+        QCOMPARE(raw[i], oneRaw);
+        QVERIFY2(sameNumber(scaled[i], oneScaled), qPrintable(QString("tag %1").arg(i)));
+    }
+}
+
+void TestRegisterDecoder::shortBlockPadsWithZero()
+{
+    // Blok sonuna taşan tag eksik word'leri sıfır sayar
+    const quint16 block[] = {0x1234, 0x5678, 0x9ABC};
+    RegisterDecoder::TagLayout layouts[] = {
+        makeLayout(0, DataType::WORD, ByteOrder::AB_CD, 1.0),
+        makeLayout(1, DataType::WORD, ByteOrder::AB_CD, 1.0),
+        makeLayout(2, DataType::DWORD, ByteOrder::AB_CD, 1.0)
+    };
+    quint64 raw[3];
+    double scaled[3];
+    RegisterDecoder::decodeBlock(block, 3, layouts, 3, raw, scaled);
+    QCOMPARE(raw[0], quint64(0x1234));
+    QCOMPARE(raw[1], quint64(0x5678));
+    QCOMPARE(raw[2], quint64(0x9ABC0000));
+    QCOMPARE(scaled[2], double(0x9ABC0000));
+}
+
+QTEST_GUILESS_MAIN(TestRegisterDecoder)
+#include "tst_registerdecoder.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_rollupstore
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_rollupstore.cpp
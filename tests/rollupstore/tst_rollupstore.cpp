@@ -0,0 +1,131 @@
+#include "RollupStore.h"
+#include <QtTest>
+#include <QTemporaryDir>
+#include <limits>
+
+namespace {
+
+const qint64 MINUTE = 60000;
+const qint64 HOUR = 3600000;
+// Saat başına hizalı sabit bir başlangıç
+const qint64 BASE = Q_INT64_C(472222) * HOUR;
+
+} // namespace
+
+// Geç gelen örnekler: bekleyen kovaya katılır, diske yazılmış kovaya
+// girmez ve sayılır; yeniden başlatmada aynı kova okumada birleşir
+class TestRollupStore : public QObject {
+    Q_OBJECT
+
+private slots:
+    void lateSampleJoinsPendingBucket();
+    void writtenBucketDropsLateSample();
+    void restartMergesSameBucket();
+};
+
+void TestRollupStore::lateSampleJoinsPendingBucket()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    RollupStore store(dir.path());
+
+    store.add(1, BASE + 1000, 10.0);
+    store.add(1, BASE + MINUTE + 1000, 20.0);   // 0. dakika bekleyene geçer
+    store.add(1, BASE + 30000, 4.0);            // Geç: bekleyen kovaya
+    store.add(1, BASE + 3 * MINUTE, 40.0);      // 1. dakika da bekleyene geçer
+    store.add(1, BASE + 2 * MINUTE, 30.0);      // Geç: bekleyenlerin arasına
+    store.add(1, BASE + 2000, std::numeric_limits<double>::quiet_NaN());
+    QCOMPARE(store.droppedLateSamples(), quint64(0));
+
+    const QVector<RollupStore::Record> minutes =
+        store.read(RollupStore::MINUTE, 1, BASE, BASE + HOUR - 1);
+    QCOMPARE(minutes.size(), 4);
+    for (int i = 0; i < minutes.size(); ++i) {
+        QCOMPARE(minutes[i].start, BASE + i * MINUTE);
+    }
+    QCOMPARE(minutes[0].count, quint32(2));
+    QCOMPARE(minutes[0].min, 4.0);
+    QCOMPARE(minutes[0].max, 10.0);
+    QCOMPARE(minutes[0].sum, 14.0);
+    QCOMPARE(minutes[2].count, quint32(1));
+    QCOMPARE(minutes[2].sum, 30.0);
+
+    const QVector<RollupStore::Record> hours =
+        store.read(RollupStore::HOUR, 1, BASE, BASE + HOUR - 1);
+    QCOMPARE(hours.size(), 1);
+    QCOMPARE(hours[0].count, quint32(5));
+    QCOMPARE(hours[0].min, 4.0);
+    QCOMPARE(hours[0].max, 40.0);
+}
+
+void TestRollupStore::writtenBucketDropsLateSample()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    RollupStore store(dir.path());
+
+    store.add(1, BASE + 1000, 10.0);
+    store.add(1, BASE + MINUTE + 1000, 20.0);
+    store.add(1, BASE + 2 * MINUTE + 1000, 30.0);
+    QVERIFY(store.flush(false));                // 0. ve 1. dakika diske yazıldı
+
+    // Son yazılan kovadan eski: dakika özetine girmez, açık saat kovasına girer
+    store.add(1, BASE + 2000, 1.0);
+    QCOMPARE(store.droppedLateSamples(), quint64(1));
+    // Son yazılan kovaya düşen örnek ikinci kayıt olur, okumada birleşir
+    store.add(1, BASE + MINUTE + 2000, 5.0);
+    QCOMPARE(store.droppedLateSamples(), quint64(1));
+
+    const QVector<RollupStore::Record> minutes =
+        store.read(RollupStore::MINUTE, 1, BASE, BASE + 2 * MINUTE - 1);
+    QCOMPARE(minutes.size(), 2);
+    QCOMPARE(minutes[0].count, quint32(1));
+    QCOMPARE(minutes[0].min, 10.0);
+    QCOMPARE(minutes[1].count, quint32(2));
+    QCOMPARE(minutes[1].min, 5.0);
+
+    const QVector<RollupStore::Record> hours =
+        store.read(RollupStore::HOUR, 1, BASE, BASE + HOUR - 1);
+    QCOMPARE(hours.size(), 1);
+    QCOMPARE(hours[0].count, quint32(5));
+    QCOMPARE(hours[0].min, 1.0);
+}
+
+void TestRollupStore::restartMergesSameBucket()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    {
+        RollupStore store(dir.path());
+        store.add(1, BASE + 1000, 10.0);
+        store.add(1, BASE + MINUTE + 1000, 20.0);
+        QVERIFY(store.flush(true));             // Açık kovalar da yazılır
+    }
+
+    RollupStore store(dir.path());
+    // Yazılmış kovadan eski: dosyanın son kaydına göre atılır
+    store.add(1, BASE + 2000, 1.0);
+    QCOMPARE(store.droppedLateSamples(), quint64(1));
+    // Son yazılan kovaya düşen örnek ikinci kayıt olur, okumada birleşir
+    store.add(1, BASE + MINUTE + 2000, 30.0);
+    QVERIFY(store.flush(true));
+    QCOMPARE(store.droppedLateSamples(), quint64(1));
+
+    const QVector<RollupStore::Record> minutes =
+        store.read(RollupStore::MINUTE, 1, BASE, BASE + HOUR - 1);
+    QCOMPARE(minutes.size(), 2);
+    QCOMPARE(minutes[0].count, quint32(1));
+    QCOMPARE(minutes[1].start, BASE + MINUTE);
+    QCOMPARE(minutes[1].count, quint32(2));
+    QCOMPARE(minutes[1].sum, 50.0);
+
+    // Saat kovası son yazılan kova olduğundan ilk geç örnek de ona girer
+    const QVector<RollupStore::Record> hours =
+        store.read(RollupStore::HOUR, 1, BASE, BASE + HOUR - 1);
+    QCOMPARE(hours.size(), 1);
+    QCOMPARE(hours[0].count, quint32(4));
+    QCOMPARE(hours[0].min, 1.0);
+}
+
+QTEST_GUILESS_MAIN(TestRollupStore)
+#include "tst_rollupstore.moc"
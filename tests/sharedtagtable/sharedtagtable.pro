@@ -0,0 +1,9 @@
+TARGET = tst_sharedtagtable
+TEMPLATE = app
+
+include(../tests.pri)
+
+# C okuyucu kütüphanesi uygulamaya bağlanmaz; test doğrudan derler
+SOURCES += \
+    tst_sharedtagtable.cpp \
+    ../../src/shm/qmodbus_shm.c
@@ -0,0 +1,95 @@
+#include "TagTable.h"
+#include "SharedTagTable.h"
+#include "qmodbus_shm.h"
+#include <QtTest>
+#include <QBitArray>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           file.write(content) == content.size();
+}
+
+} // namespace
+
+// Paylaşımlı bellek segmenti: yazıcı TagTable'ı yayınlar, C okuyucu
+// adresle okur ve segment büyüyünce yeniden eşler
+class TestSharedTagTable : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sharedMemoryReader();
+};
+
+void TestSharedTagTable::sharedMemoryReader()
+{
+    const QString device = QString("tst-%1").arg(QCoreApplication::applicationPid());
+    const QByteArray deviceName = device.toUtf8();
+
+    TagTable table;
+    const int level = table.addTag(100, 1);
+    const int flow = table.addTag(200, 2);
+    const quint16 levelWords[] = {1234};
+    const quint16 flowWords[] = {0x4148, 0x0000};
+    table.store(level, levelWords, 12.34, Q_INT64_C(1700000000000), TagTable::ALARM_NONE);
+    table.store(flow, flowWords, 12.5, Q_INT64_C(1700000000000), TagTable::ALARM_HIGH);
+    table.publish();
+
+    SharedTagTable shared(device);
+    QVERIFY2(shared.open(2), qPrintable(shared.getLastError()));
+    QVERIFY(shared.setLayout(table));
+    QBitArray changed(table.size(), true);
+    shared.update(table, changed);
+
+    int error = QMODBUS_SHM_OK;
+    qmodbus_shm* reader = qmodbus_shm_open(deviceName.constData(), &error);
+    QVERIFY(reader);
+    QCOMPARE(error, QMODBUS_SHM_OK);
+    QCOMPARE(QString::fromUtf8(qmodbus_shm_device(reader)), device);
+    QCOMPARE(qmodbus_shm_tag_count(reader), 2);
+    QVERIFY(qmodbus_shm_heartbeat(reader) > 0);
+
+    qmodbus_shm_sample sample;
+    QCOMPARE(qmodbus_shm_read_address(reader, 200, &sample), QMODBUS_SHM_OK);
+    QCOMPARE(sample.value, 12.5);
+    QCOMPARE(sample.word_count, uint8_t(2));
+    QCOMPARE(sample.words[0], uint16_t(0x4148));
+    QCOMPARE(sample.quality, uint8_t(QMODBUS_SHM_GOOD));
+    QCOMPARE(sample.alarm_flags, uint8_t(TagTable::ALARM_HIGH));
+    QCOMPARE(qmodbus_shm_read_address(reader, 300, &sample), QMODBUS_SHM_ENOENT);
+
+    // Kapasiteyi aşan tag listesi segmenti büyütür; okuyucu yeniden eşler
+    const quint32 layout = qmodbus_shm_layout(reader);
+    for (int address = 1000; address < 1010; ++address) {
+        table.addTag(address, 1);
+    }
+    const int last = table.idForAddress(1009);
+    const quint16 lastWords[] = {77};
+    table.store(last, lastWords, 7.7, Q_INT64_C(1700000001000), TagTable::ALARM_NONE);
+    table.publish();
+    QVERIFY(shared.setLayout(table));
+    QVERIFY(qmodbus_shm_layout(reader) != layout);
+    QCOMPARE(qmodbus_shm_tag_count(reader), 12);
+    QCOMPARE(qmodbus_shm_read_address(reader, 1009, &sample), QMODBUS_SHM_OK);
+    QCOMPARE(sample.value, 7.7);
+    QCOMPARE(qmodbus_shm_read_address(reader, 100, &sample), QMODBUS_SHM_OK);
+    QCOMPARE(sample.words[0], uint16_t(1234));
+    qmodbus_shm_close(reader);
+
+    // Tanınmayan dosya
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray garbage = dir.filePath("garbage.shm").toUtf8();
+    QVERIFY(writeFile(QString::fromUtf8(garbage), QByteArray(4096, '\0')));
+    QVERIFY(!qmodbus_shm_open_path(garbage.constData(), &error));
+    QCOMPARE(error, QMODBUS_SHM_EFORMAT);
+}
+
+QTEST_GUILESS_MAIN(TestSharedTagTable)
+#include "tst_sharedtagtable.moc"
@@ -0,0 +1,17 @@
+TARGET = tst_sparkplugpublisher
+TEMPLATE = app
+
+include(../tests.pri)
+
+# Yayıncı yalnızca servis hedefinde derlenir; çekirdekte yok
+SOURCES += \
+    tst_sparkplugpublisher.cpp \
+    ../../src/daemon/MqttClient.cpp \
+    ../../src/daemon/SparkplugPublisher.cpp
+
+HEADERS += \
+    ../../src/daemon/MqttClient.h \
+    ../../src/daemon/SparkplugPublisher.h
+
+INCLUDEPATH += \
+    ../../src/daemon
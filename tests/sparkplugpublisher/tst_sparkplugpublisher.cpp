@@ -0,0 +1,433 @@
+#include "SparkplugPublisher.h"
+#include "loopbackslave.h"
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+
+using ModbusTypes::DataType;
+using ModbusTypes::RegisterType;
+
+namespace {
+
+// Yalnızca yayıncının kullandığı paketleri anlayan MQTT 3.1.1 broker'ı:
+// CONNECT'e CONNACK, QoS 1 PUBLISH'e (ackPublishes açıksa) PUBACK döner
+class FakeBroker : public QObject {
+public:
+    struct Message {
+        QString topic;
+        QByteArray payload;
+        int qos;
+    };
+
+    QList<Message> messages;
+    bool ackPublishes;
+
+    FakeBroker() : ackPublishes(true), client(nullptr) {}
+
+    bool listen(quint16 port = 0)
+    {
+        if (!server.listen(QHostAddress::LocalHost, port)) {
+            return false;
+        }
+        connect(&server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket* socket = server.nextPendingConnection()) {
+                client = socket;
+                buffer.clear();
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+            }
+        });
+        return true;
+    }
+
+    quint16 port() const { return server.serverPort(); }
+    void close() { server.close(); }
+
+    // Bağlantıyı DISCONNECT olmadan koparır (ağ kesintisi)
+    void dropClient()
+    {
+        if (client) {
+            client->abort();
+            client = nullptr;
+        }
+    }
+
+private:
+    QTcpServer server;
+    QTcpSocket* client;
+    QByteArray buffer;
+
+    void onReadyRead(QTcpSocket* socket)
+    {
+        buffer.append(socket->readAll());
+        for (;;) {
+            int length = 0;
+            int multiplier = 1;
+            int pos = 1;
+            bool complete = false;
+            while (pos < buffer.size() && pos <= 4) {
+                const quint8 byte = static_cast<quint8>(buffer[pos++]);
+                length += (byte & 0x7F) * multiplier;
+                multiplier *= 128;
+                if (!(byte & 0x80)) {
+                    complete = true;
+                    break;
+                }
+            }
+            if (!complete || buffer.size() < pos + length) {
+                return;
+            }
+            const quint8 header = static_cast<quint8>(buffer[0]);
+            const QByteArray body = buffer.mid(pos, length);
+            buffer.remove(0, pos + length);
+            handlePacket(socket, header, body);
+        }
+    }
+
+    void handlePacket(QTcpSocket* socket, quint8 header, const QByteArray& body)
+    {
+        switch (header & 0xF0) {
+            case 0x10:      // CONNECT
+                socket->write(QByteArray("\x20\x02\x00\x00", 4));
+                break;
+            case 0x30: {    // PUBLISH
+                const int qos = (header >> 1) & 0x03;
+                const int topicLength = (static_cast<quint8>(body[0]) << 8) | static_cast<quint8>(body[1]);
+                int pos = 2 + topicLength;
+                Message message;
+                message.topic = QString::fromUtf8(body.mid(2, topicLength));
+                message.qos = qos;
+                QByteArray packetId;
+                if (qos > 0) {
+                    packetId = body.mid(pos, 2);
+                    pos += 2;
+                }
+                message.payload = body.mid(pos);
+                messages.append(message);
+                if (qos > 0 && ackPublishes) {
+                    socket->write(QByteArray("\x40\x02", 2) + packetId);
+                }
+                break;
+            }
+            case 0xC0:      // PINGREQ
+                socket->write(QByteArray("\xD0\x00", 2));
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+// Sparkplug B protobuf yükünün testte gereken kısmı
+struct DecodedMetric {
+    QByteArray name;
+    quint64 alias;
+    bool historical;
+    bool isNull;
+    double doubleValue;
+    quint64 longValue;
+
+    DecodedMetric() : alias(0), historical(false), isNull(false), doubleValue(0.0), longValue(0) {}
+};
+
+struct DecodedPayload {
+    quint64 timestamp;
+    quint64 seq;
+    QVector<DecodedMetric> metrics;
+
+    DecodedPayload() : timestamp(0), seq(0) {}
+};
+
+quint64 readVarint(const QByteArray& data, int& pos)
+{
+    quint64 value = 0;
+    int shift = 0;
+    while (pos < data.size()) {
+        const quint8 byte = static_cast<quint8>(data[pos++]);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+// Alan numarası -> değer; tanınmayan alanlar atlanır
+template<typename Handler>
+void readFields(const QByteArray& data, Handler handle)
+{
+    int pos = 0;
+    while (pos < data.size()) {
+        const quint64 key = readVarint(data, pos);
+        const int field = static_cast<int>(key >> 3);
+        switch (key & 0x07) {
+            case 0:
+                handle(field, readVarint(data, pos), QByteArray());
+                break;
+            case 1:
+                handle(field, 0, data.mid(pos, 8));
+                pos += 8;
+                break;
+            case 2: {
+                const int length = static_cast<int>(readVarint(data, pos));
+                handle(field, 0, data.mid(pos, length));
+                pos += length;
+                break;
+            }
+            default:
+                return;
+        }
+    }
+}
+
+DecodedPayload decodePayload(const QByteArray& payload)
+{
+    DecodedPayload result;
+    readFields(payload, [&result](int field, quint64 value, const QByteArray& bytes) {
+        if (field == 1) {
+            result.timestamp = value;
+        } else if (field == 3) {
+            result.seq = value;
+        } else if (field == 2) {
+            DecodedMetric metric;
+            readFields(bytes, [&metric](int f, quint64 v, const QByteArray& b) {
+                switch (f) {
+                    case 1:  metric.name = b; break;
+                    case 2:  metric.alias = v; break;
+                    case 5:  metric.historical = v != 0; break;
+                    case 7:  metric.isNull = v != 0; break;
+                    case 11: metric.longValue = v; break;
+                    case 13: metric.doubleValue = qFromLittleEndian<double>(b.constData()); break;
+                    default: break;
+                }
+            });
+            result.metrics.append(metric);
+        }
+    });
+    return result;
+}
+
+ModbusTypes::RegisterConfig makeConfig(int address)
+{
+    ModbusTypes::RegisterConfig config;
+    config.address = address;
+    config.name = QString("R%1").arg(address);
+    config.dataType = DataType::WORD;
+    config.regType = RegisterType::HOLDING_REGISTER;
+    return config;
+}
+
+// Açılıp kapatılan sunucunun portunda artık kimse dinlemez
+quint16 unusedPort()
+{
+    QTcpServer probe;
+    probe.listen(QHostAddress::LocalHost, 0);
+    return probe.serverPort();
+}
+
+const quint64 ALIAS_BASE = Q_UINT64_C(1) << 16;     // İlk cihaz
+
+} // namespace
+
+// Sparkplug B yayıncısı: birth sırası ve yük kodlaması, yalnızca değişen
+// tag'leri taşıyan DDATA, bağlantı yokken biriken ve onaylanmayan
+// mesajların yeniden bağlanınca sırayla "historical" gönderimi
+class TestSparkplugPublisher : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void birthThenReportByException();
+    void replaysQueuedBatchesInOrder();
+    void resendsUnackedAfterReconnect();
+
+private:
+    LoopbackSlave* slave;
+    ModbusDevice* device;
+
+    SparkplugPublisher::Options options(quint16 port) const;
+    void pollOnce();
+};
+
+void TestSparkplugPublisher::init()
+{
+    slave = new LoopbackSlave;
+    slave->setRegister(0, 10);
+    slave->setRegister(1, 20);
+    slave->start();
+
+    device = new ModbusDevice("loopback");
+    ModbusTypes::ConnectionParams params;
+    params.ip = "127.0.0.1";
+    params.port = slave->getPort();
+    device->setConnectionParams(params);
+    device->addRegisters(QVector<ModbusTypes::RegisterConfig>() << makeConfig(0) << makeConfig(1));
+    QVERIFY2(device->connectToDevice(), qPrintable(device->getLastError()));
+    pollOnce();
+}
+
+void TestSparkplugPublisher::cleanup()
+{
+    delete device;
+    delete slave;
+}
+
+SparkplugPublisher::Options TestSparkplugPublisher::options(quint16 port) const
+{
+    SparkplugPublisher::Options result;
+    result.host = "127.0.0.1";
+    result.port = port;
+    result.groupId = "plant";
+    result.edgeNodeId = "edge 1";
+    return result;
+}
+
+// Poll zamanlayıcısını beklemeden tek döngü
+void TestSparkplugPublisher::pollOnce()
+{
+    QMetaObject::invokeMethod(device, "handlePollingTimeout", Qt::DirectConnection);
+}
+
+void TestSparkplugPublisher::birthThenReportByException()
+{
+    FakeBroker broker;
+    QVERIFY(broker.listen());
+    SparkplugPublisher publisher(options(broker.port()));
+    publisher.addDevice(device);
+    QVERIFY(publisher.start());
+
+    // NBIRTH bdSeq taşır, DBIRTH tüm tag'leri ad ve alias ile
+    QTRY_COMPARE(broker.messages.size(), 2);
+    QCOMPARE(broker.messages[0].topic, QString("spBv1.0/plant/NBIRTH/edge_1"));
+    const DecodedPayload nbirth = decodePayload(broker.messages[0].payload);
+    QCOMPARE(nbirth.seq, quint64(0));
+    QCOMPARE(nbirth.metrics.size(), 1);
+    QCOMPARE(nbirth.metrics[0].name, QByteArray("bdSeq"));
+    QCOMPARE(nbirth.metrics[0].longValue, quint64(0));
+
+    QCOMPARE(broker.messages[1].topic, QString("spBv1.0/plant/DBIRTH/edge_1/loopback"));
+    QCOMPARE(broker.messages[1].qos, 0);
+    const DecodedPayload dbirth = decodePayload(broker.messages[1].payload);
+    QCOMPARE(dbirth.seq, quint64(1));
+    QCOMPARE(dbirth.metrics.size(), 2);
+    QCOMPARE(dbirth.metrics[0].name, QByteArray("R0"));
+    QCOMPARE(dbirth.metrics[0].alias, ALIAS_BASE + 0);
+    QCOMPARE(dbirth.metrics[0].doubleValue, 10.0);
+    QCOMPARE(dbirth.metrics[1].name, QByteArray("R1"));
+    QCOMPARE(dbirth.metrics[1].alias, ALIAS_BASE + 1);
+    QCOMPARE(dbirth.metrics[1].doubleValue, 20.0);
+
+    // Yalnızca değişen tag, adsız ve alias ile; QoS 1
+    slave->setRegister(1, 25);
+    pollOnce();
+    QTRY_COMPARE(broker.messages.size(), 3);
+    QCOMPARE(broker.messages[2].topic, QString("spBv1.0/plant/DDATA/edge_1/loopback"));
+    QCOMPARE(broker.messages[2].qos, 1);
+    const DecodedPayload ddata = decodePayload(broker.messages[2].payload);
+    QCOMPARE(ddata.seq, quint64(2));
+    QCOMPARE(ddata.metrics.size(), 1);
+    QVERIFY(ddata.metrics[0].name.isEmpty());
+    QCOMPARE(ddata.metrics[0].alias, ALIAS_BASE + 1);
+    QCOMPARE(ddata.metrics[0].doubleValue, 25.0);
+    QVERIFY(!ddata.metrics[0].historical);
+    QTRY_COMPARE(publisher.publishedMessages(), quint64(1));
+    QCOMPARE(publisher.queuedMetrics(), 0);
+
+    // Değişiklik yoksa mesaj da yok
+    pollOnce();
+    QTest::qWait(100);
+    QCOMPARE(broker.messages.size(), 3);
+
+    publisher.stop();
+}
+
+void TestSparkplugPublisher::replaysQueuedBatchesInOrder()
+{
+    const quint16 port = unusedPort();
+    QVERIFY(port > 0);
+    SparkplugPublisher publisher(options(port));
+    publisher.addDevice(device);
+    QVERIFY(publisher.start());
+    QVERIFY(!publisher.isConnected());
+
+    // Broker yokken her döngü kuyrukta bekler
+    slave->setRegister(0, 11);
+    pollOnce();
+    slave->setRegister(0, 12);
+    pollOnce();
+    QCOMPARE(publisher.queuedMetrics(), 2);
+
+    // Broker gelince yeniden deneme bağlanır; birth'lerden sonra sırayla
+    FakeBroker broker;
+    QVERIFY(broker.listen(port));
+    QTRY_COMPARE(broker.messages.size(), 4);
+    QVERIFY(broker.messages[0].topic.endsWith("/NBIRTH/edge_1"));
+    QVERIFY(broker.messages[1].topic.endsWith("/DBIRTH/edge_1/loopback"));
+    QCOMPARE(decodePayload(broker.messages[1].payload).metrics[0].doubleValue, 12.0);
+
+    const DecodedPayload first = decodePayload(broker.messages[2].payload);
+    const DecodedPayload second = decodePayload(broker.messages[3].payload);
+    QCOMPARE(first.seq, quint64(2));
+    QCOMPARE(second.seq, quint64(3));
+    QCOMPARE(first.metrics.size(), 1);
+    QCOMPARE(first.metrics[0].alias, ALIAS_BASE + 0);
+    QCOMPARE(first.metrics[0].doubleValue, 11.0);
+    QVERIFY(first.metrics[0].historical);
+    QCOMPARE(second.metrics[0].doubleValue, 12.0);
+    QVERIFY(second.metrics[0].historical);
+    QVERIFY(first.timestamp <= second.timestamp);
+
+    QTRY_COMPARE(publisher.publishedMessages(), quint64(2));
+    QCOMPARE(publisher.queuedMetrics(), 0);
+    QCOMPARE(publisher.droppedMetrics(), quint64(0));
+
+    publisher.stop();
+}
+
+void TestSparkplugPublisher::resendsUnackedAfterReconnect()
+{
+    FakeBroker broker;
+    QVERIFY(broker.listen());
+    broker.ackPublishes = false;
+    SparkplugPublisher publisher(options(broker.port()));
+    publisher.addDevice(device);
+    QVERIFY(publisher.start());
+    QTRY_COMPARE(broker.messages.size(), 2);
+
+    // Onay gelmeyen DDATA kuyruktan düşmez
+    slave->setRegister(1, 21);
+    pollOnce();
+    QTRY_COMPARE(broker.messages.size(), 3);
+    QTest::qWait(100);
+    QCOMPARE(publisher.publishedMessages(), quint64(0));
+    QCOMPARE(publisher.queuedMetrics(), 1);
+
+    // Bağlantı koparsa yeni oturumda (bdSeq + 1) historical olarak yeniden gider
+    broker.ackPublishes = true;
+    broker.dropClient();
+    QTRY_VERIFY(!publisher.isConnected());
+    QTRY_COMPARE(broker.messages.size(), 6);
+    QVERIFY(broker.messages[3].topic.endsWith("/NBIRTH/edge_1"));
+    QCOMPARE(decodePayload(broker.messages[3].payload).metrics[0].longValue, quint64(1));
+    QVERIFY(broker.messages[4].topic.endsWith("/DBIRTH/edge_1/loopback"));
+
+    const DecodedPayload original = decodePayload(broker.messages[2].payload);
+    const DecodedPayload resent = decodePayload(broker.messages[5].payload);
+    QVERIFY(broker.messages[5].topic.endsWith("/DDATA/edge_1/loopback"));
+    QVERIFY(!original.metrics[0].historical);
+    QCOMPARE(resent.metrics.size(), 1);
+    QCOMPARE(resent.metrics[0].alias, ALIAS_BASE + 1);
+    QCOMPARE(resent.metrics[0].doubleValue, 21.0);
+    QVERIFY(resent.metrics[0].historical);
+    QCOMPARE(resent.timestamp, original.timestamp);
+
+    QTRY_COMPARE(publisher.publishedMessages(), quint64(1));
+    QCOMPARE(publisher.queuedMetrics(), 0);
+
+    publisher.stop();
+}
+
+QTEST_GUILESS_MAIN(TestSparkplugPublisher)
+#include "tst_sparkplugpublisher.moc"
@@ -0,0 +1,10 @@
+# Testlerin ortak ayarları: çekirdek kaynaklara bağlanan konsol uygulaması
+
+QT = core testlib
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include($$PWD/../qmodbus_core.pri)
+
+# Testler arasında paylaşılan yardımcılar (loopbackslave.h)
+INCLUDEPATH += $$PWD
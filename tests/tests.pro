@@ -0,0 +1,18 @@
+TEMPLATE = subdirs
+
+# Her alt dizin ayrı bir QtTest uygulaması (qmake && make check)
+SUBDIRS += \
+    registerdecoder \
+    registercodec \
+    modbusdevice \
+    csv \
+    configimage \
+    timeseriesstore \
+    chartdecimator \
+    rollupstore \
+    logring \
+    binarylog \
+    transactionstats \
+    metricsexporter \
+    sharedtagtable \
+    sparkplugpublisher
@@ -0,0 +1,7 @@
+TARGET = tst_timeseriesstore
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_timeseriesstore.cpp
@@ -0,0 +1,202 @@
+#include "GorillaChunk.h"
+#include "TimeSeriesStore.h"
+#include <QtTest>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <cstring>
+
+namespace {
+
+const qint64 HOUR = 3600000;
+// Saat başına hizalı sabit bir bölüm başlangıcı
+const qint64 PARTITION = Q_INT64_C(472222) * HOUR;
+
+bool writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           file.write(content) == content.size();
+}
+
+QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+} // namespace
+
+// Gorilla kodlayıcı ve bölüm dosyaları: yazılan örnekler aynı sırayla ve
+// bit düzeyinde aynı değerlerle geri okunur
+class TestTimeSeriesStore : public QObject {
+    Q_OBJECT
+
+private slots:
+    void gorillaRoundTrip();
+    void lateSamples();
+    void dropsTornSegment();
+    void refusesForeignPartition();
+};
+
+void TestTimeSeriesStore::gorillaRoundTrip()
+{
+    QVector<qint64> timestamps;
+    QVector<double> values;
+    QRandomGenerator random(7);
+    qint64 ts = Q_INT64_C(1700000000000);
+    double value = 20.0;
+    for (int i = 0; i < 1000; ++i) {
+        // Düzenli aralık, ara sıra sapma; sabit, yavaş değişen ve sıçrayan değerler
+        ts += (i % 97 == 0) ? 1000 + random.bounded(500) : 1000;
+        if (i % 50 == 0) {
+            value = random.generateDouble() * 1e6 - 5e5;
+        } else if (i % 3 == 0) {
+            value += 0.125;
+        }
+        timestamps.append(ts);
+        values.append(i == 500 ? -0.0 : value);
+    }
+
+    GorillaEncoder encoder;
+    for (int i = 0; i < timestamps.size(); ++i) {
+        encoder.append(timestamps[i], values[i]);
+    }
+    QCOMPARE(encoder.count(), timestamps.size());
+    QCOMPARE(encoder.firstTimestamp(), timestamps.first());
+    QCOMPARE(encoder.lastTimestamp(), timestamps.last());
+
+    const QByteArray data = encoder.data();
+    QCOMPARE(data.size(), encoder.sizeInBytes());
+    GorillaDecoder decoder(data.constData(), data.size(), encoder.count());
+    qint64 decodedTs;
+    double decodedValue;
+    for (int i = 0; i < timestamps.size(); ++i) {
+        QVERIFY(decoder.next(decodedTs, decodedValue));
+        QCOMPARE(decodedTs, timestamps[i]);
+        // Bit düzeyinde aynı olmalı (-0.0 dahil)
+        QVERIFY(memcmp(&decodedValue, &values[i], sizeof(double)) == 0);
+    }
+    QVERIFY(!decoder.next(decodedTs, decodedValue));
+}
+
+// Bölüm sınırından sonra gelen geç örnek açık bölüme yazılır ve kendi
+// saatinin sorgusunda görünür; bir önceki bölümden eskisi atılır
+void TestTimeSeriesStore::lateSamples()
+{
+    // Ekleme sırası dışındaki örnekler chunk sınırlarını genişletir
+    GorillaEncoder encoder;
+    encoder.append(PARTITION + 1000, 1.0);
+    encoder.append(PARTITION - 500, 2.0);
+    encoder.append(PARTITION + 2000, 3.0);
+    QCOMPARE(encoder.firstTimestamp(), PARTITION + 1000);
+    QCOMPARE(encoder.minTimestamp(), PARTITION - 500);
+    QCOMPARE(encoder.maxTimestamp(), PARTITION + 2000);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    {
+        TimeSeriesStore store(dir.path(), HOUR, 4);
+        QVERIFY(store.append(1, PARTITION - HOUR + 1000, 1.0));
+        QVERIFY(store.append(1, PARTITION - HOUR + 2000, 2.0));
+        // Yeni bölüme geçiş; ardından önceki saate ait geç örnek
+        QVERIFY(store.append(1, PARTITION + 1000, 3.0));
+        QVERIFY(store.append(1, PARTITION - 500, 4.0));
+        // İki bölüm geriden gelen örnek yazılmaz ama hata sayılmaz
+        QVERIFY(store.append(1, PARTITION - 2 * HOUR + 5, 5.0));
+        QCOMPARE(store.droppedLateSamples(), quint64(1));
+
+        // Mühürlenmemiş chunk'tan okuma
+        QCOMPARE(store.read(1, PARTITION - HOUR, PARTITION - 1).size(), 3);
+        QVERIFY(store.sealAll());
+    }
+
+    // Yeniden açılışta yalnızca bölüm dosyalarından okunur
+    TimeSeriesStore store(dir.path(), HOUR, 4);
+    QVector<TimeSeriesStore::Sample> samples = store.read(1, PARTITION - HOUR, PARTITION - 1);
+    QCOMPARE(samples.size(), 3);
+    QCOMPARE(samples.last().timestamp, PARTITION - 500);
+    QCOMPARE(samples.last().value, 4.0);
+
+    samples = store.read(1, PARTITION, PARTITION + HOUR - 1);
+    QCOMPARE(samples.size(), 1);
+    QCOMPARE(samples.first().timestamp, PARTITION + 1000);
+
+    QVERIFY(store.read(1, PARTITION - 2 * HOUR, PARTITION - HOUR - 1).isEmpty());
+}
+
+void TestTimeSeriesStore::dropsTornSegment()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + "/" + TimeSeriesStore::partitionFileName(PARTITION);
+
+    // İki segment: her sealAll bir commit
+    {
+        TimeSeriesStore store(dir.path(), HOUR, 4);
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(store.append(1, PARTITION + i * 1000, i));
+        }
+        QVERIFY(store.sealAll());
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(store.append(1, PARTITION + 10000 + i * 1000, 10 + i));
+        }
+        QVERIFY(store.sealAll());
+    }
+
+    // İkinci segmentin sonu diske ulaşmamış gibi kes
+    QFile file(path);
+    const qint64 fullSize = file.size();
+    QVERIFY(fullSize > 0);
+    QVERIFY(file.resize(fullSize - 5));
+
+    TimeSeriesStore store(dir.path(), HOUR, 4);
+    QVector<TimeSeriesStore::Sample> samples = store.read(1, PARTITION, PARTITION + HOUR);
+    QCOMPARE(samples.size(), 4);
+    QCOMPARE(samples.last().timestamp, PARTITION + 3000);
+
+    // Aynı bölüme devam: yarım segment atılır, yeni veri arkasına yazılır
+    QVERIFY(store.append(1, PARTITION + 20000, 42.0));
+    QVERIFY(store.sealAll());
+    samples = store.read(1, PARTITION, PARTITION + HOUR);
+    QCOMPARE(samples.size(), 5);
+    QCOMPARE(samples.last().timestamp, PARTITION + 20000);
+    QCOMPARE(samples.last().value, 42.0);
+}
+
+// Bölüm adındaki yabancı dosya ya da başka bölüm uzunluğuyla yazılmış
+// dosya silinmez; ekleme hatayla reddedilir
+void TestTimeSeriesStore::refusesForeignPartition()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + "/" + TimeSeriesStore::partitionFileName(PARTITION);
+
+    const QByteArray foreign("not a partition file, but someone's data");
+    QVERIFY(writeFile(path, foreign));
+    {
+        TimeSeriesStore store(dir.path(), HOUR, 4);
+        QVERIFY(!store.append(1, PARTITION + 1000, 1.0));
+        QVERIFY(store.getLastError().contains("not overwritten"));
+        QVERIFY(store.read(1, PARTITION, PARTITION + HOUR).isEmpty());
+    }
+    QCOMPARE(readFile(path), foreign);
+
+    // Aynı ada düşen ama yarım saatlik bölümlerle yazılmış dosya
+    QVERIFY(QFile::remove(path));
+    {
+        TimeSeriesStore store(dir.path(), HOUR / 2, 4);
+        QVERIFY(store.append(1, PARTITION + 1000, 1.0));
+        QVERIFY(store.sealAll());
+    }
+    const QByteArray halfHour = readFile(path);
+    QVERIFY(!halfHour.isEmpty());
+    {
+        TimeSeriesStore store(dir.path(), HOUR, 4);
+        QVERIFY(!store.append(1, PARTITION + 2000, 2.0));
+    }
+    QCOMPARE(readFile(path), halfHour);
+}
+
+QTEST_GUILESS_MAIN(TestTimeSeriesStore)
+#include "tst_timeseriesstore.moc"
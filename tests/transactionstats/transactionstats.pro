@@ -0,0 +1,7 @@
+TARGET = tst_transactionstats
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_transactionstats.cpp
@@ -0,0 +1,101 @@
+#include "TransactionStats.h"
+#include "LatencyHistogram.h"
+#include <QtTest>
+#include <modbus.h>
+#include <errno.h>
+
+// Gecikme histogramı kovaları ve fonksiyon kodu / slave id başına
+// işlem sayaçları
+class TestTransactionStats : public QObject {
+    Q_OBJECT
+
+private slots:
+    void histogramBuckets();
+    void seriesCounters();
+};
+
+void TestTransactionStats::histogramBuckets()
+{
+    // Kovalar boşluksuz ve değeri kapsar; 128 altı birebir
+    for (int index = 1; index < LatencyHistogram::BUCKET_COUNT; ++index) {
+        QCOMPARE(LatencyHistogram::bucketLowerBound(index),
+                 LatencyHistogram::bucketUpperBound(index - 1) + 1);
+    }
+    for (quint64 micros = 0; micros < (Q_UINT64_C(1) << 26); micros += 1 + micros / 37) {
+        const int index = LatencyHistogram::bucketIndex(micros);
+        QVERIFY(LatencyHistogram::bucketLowerBound(index) <= micros);
+        QVERIFY(LatencyHistogram::bucketUpperBound(index) >= micros);
+        if (micros < 128) {
+            QCOMPARE(index, static_cast<int>(micros));
+        } else {
+            // Kova genişliği değerin 1/64'ünü aşmaz
+            const quint64 width = LatencyHistogram::bucketUpperBound(index) -
+                                  LatencyHistogram::bucketLowerBound(index) + 1;
+            QVERIFY(width * 64 <= micros);
+        }
+    }
+    QCOMPARE(LatencyHistogram::bucketIndex(Q_UINT64_C(1) << 40), LatencyHistogram::BUCKET_COUNT - 1);
+
+    LatencyHistogram histogram;
+    for (quint64 micros = 1; micros <= 1000; ++micros) {
+        histogram.record(micros);
+    }
+    const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    QCOMPARE(snapshot.count, quint64(1000));
+    QCOMPARE(snapshot.max, quint64(1000));
+    QCOMPARE(snapshot.mean(), 500.5);
+    QCOMPARE(snapshot.percentile(50), LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(500)));
+    QCOMPARE(snapshot.percentile(100), quint64(1000));
+
+    LatencyHistogram::Snapshot merged = snapshot;
+    merged.merge(snapshot);
+    QCOMPARE(merged.count, quint64(2000));
+    QCOMPARE(merged.percentile(50), snapshot.percentile(50));
+}
+
+void TestTransactionStats::seriesCounters()
+{
+    TransactionStats stats;
+    const quint8 read = TransactionStats::functionCodeFor(ModbusTypes::RegisterType::HOLDING_REGISTER, false, 10);
+    const quint8 write = TransactionStats::functionCodeFor(ModbusTypes::RegisterType::HOLDING_REGISTER, true, 1);
+    QCOMPARE(read, quint8(0x03));
+    QCOMPARE(write, quint8(0x06));
+
+    stats.recordResult(read, 1, true, 0);
+    stats.recordResult(read, 1, false, ETIMEDOUT);
+    stats.recordResult(read, 1, false, EMBXILADD);
+    stats.recordResult(read, 2, true, 0);
+    stats.recordResult(write, 1, false, ECONNRESET);
+    stats.record(read, 1, TransactionStats::WIRE, 1000);
+    stats.record(read, 2, TransactionStats::WIRE, 3000);
+    QCOMPARE(stats.seriesCount(), 3);
+
+    // Seriler ilk görüldükleri sırayla
+    const TransactionStats::Series* first = stats.series(0);
+    QCOMPARE(first->functionCode, read);
+    QCOMPARE(first->slaveId, quint8(1));
+    QCOMPARE(first->requests.load(), quint64(3));
+    QCOMPARE(first->failures.load(), quint64(2));
+    QCOMPARE(first->timeouts.load(), quint64(1));
+    QCOMPARE(first->exceptions[EMBXILADD - MODBUS_ENOBASE].load(), quint64(1));
+
+    // Ne istisna ne zaman aşımı: yalnızca hata sayılır
+    const TransactionStats::Series* third = stats.series(2);
+    QCOMPARE(third->failures.load(), quint64(1));
+    QCOMPARE(third->timeouts.load(), quint64(0));
+
+    const LatencyHistogram::Snapshot wire = stats.aggregate(TransactionStats::WIRE);
+    QCOMPARE(wire.count, quint64(2));
+    QCOMPARE(wire.max, quint64(3000));
+    QCOMPARE(stats.averageMillis(TransactionStats::WIRE), 2.0);
+    QCOMPARE(stats.averageMillis(TransactionStats::DECODE), 0.0);
+
+    // Sıfırlama serileri korur, sayaçları temizler
+    stats.reset();
+    QCOMPARE(stats.seriesCount(), 3);
+    QCOMPARE(stats.series(0)->requests.load(), quint64(0));
+    QCOMPARE(stats.aggregate(TransactionStats::WIRE).count, quint64(0));
+}
+
+QTEST_GUILESS_MAIN(TestTransactionStats)
+#include "tst_transactionstats.moc"